@@ -0,0 +1,98 @@
+#ifndef AGGREGATE_QUEUE_H
+#define AGGREGATE_QUEUE_H
+
+#include "stack.h"
+#include "queue.h"
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+//операции для aggregate_queue: ассоциативные, порядок аргументов - порядок в очереди
+template <typename T>
+struct agg_sum {
+    T operator()(const T& a, const T& b) const { return a + b; }
+};
+
+template <typename T>
+struct agg_min {
+    T operator()(const T& a, const T& b) const { return b < a ? b : a; }
+};
+
+template <typename T>
+struct agg_max {
+    T operator()(const T& a, const T& b) const { return a < b ? b : a; }
+};
+
+//очередь (FIFO) со свёрткой всех элементов за амортизированное O(1) для любой ассоциативной Op
+//два стека: в back_ новые элементы и свёртка их всех, во front_ старые элементы, каждый со свёрткой
+//себя и всех, кто новее него во front_; когда front_ пуст, pop переносит в него весь back_
+//коммутативность Op не нужна: aggregate() = Op(свёртка front_, свёртка back_)
+template <typename T, typename Op = agg_sum<T>>
+class aggregate_queue {
+    //элемент front_: значение и свёртка от него до дна front_
+    struct entry {
+        T value;
+        T agg;
+    };
+
+    //get_front() const может перенести back_ во front_, поэтому стеки mutable
+    mutable stack<entry> front_;    //вершина - самый старый элемент
+    mutable stack<T> back_;         //вершина - самый новый
+    T back_agg_;            //свёртка back_, если он не пуст
+    Op op_;
+
+public:
+    explicit aggregate_queue(const Op& op = Op());
+
+    void push(const T& v);
+    void push(T&& v);
+    T pop();                            //самый старый; std::runtime_error на пустой
+
+    const T& get_front() const;         //самый старый
+    T aggregate() const;                //Op по всем элементам от старого к новому; std::runtime_error на пустой
+
+    bool is_empty() const;
+    bool empty() const;
+    std::size_t size() const;
+
+private:
+    void refill() const;                //back_ целиком во front_ со свёртками
+};
+
+//окно для min и max: монотонная очередь кандидатов, aggregate() - честное O(1) без переносов
+//Better(a, b) - a лучше b; кандидаты от лучшего к худшему, равные сохраняются, чтобы pop их узнавал
+template <typename T, typename Better>
+class monotonic_queue {
+    queue<T> values_;       //все элементы по порядку
+    std::deque<T> best_;    //кандидаты: каждый лучше всех, кто пришёл после него
+    Better better_;
+
+public:
+    void push(const T& v);
+    T pop();
+    const T& get_front() const;
+    const T& aggregate() const;         //лучший в окне
+
+    bool is_empty() const;
+    bool empty() const;
+    std::size_t size() const;
+};
+
+//min и max идут через монотонную очередь
+template <typename T>
+class aggregate_queue<T, agg_min<T>> : public monotonic_queue<T, std::less<T>> {
+public:
+    explicit aggregate_queue(const agg_min<T>& = agg_min<T>()) {}
+};
+
+template <typename T>
+class aggregate_queue<T, agg_max<T>> : public monotonic_queue<T, std::greater<T>> {
+public:
+    explicit aggregate_queue(const agg_max<T>& = agg_max<T>()) {}
+};
+
+#include "aggregate_queue_impl.h"
+
+#endif
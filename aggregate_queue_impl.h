@@ -0,0 +1,107 @@
+#ifndef AGGREGATE_QUEUE_IMPL_H
+#define AGGREGATE_QUEUE_IMPL_H
+
+//реализация aggregate_queue
+
+//пустая очередь
+template <typename T, typename Op>
+aggregate_queue<T, Op>::aggregate_queue(const Op& op): back_agg_(), op_(op) {}
+
+//новый элемент в back_, свёртка back_ продлевается справа
+template <typename T, typename Op>
+void aggregate_queue<T, Op>::push(const T& v) {
+    back_agg_ = back_.is_empty() ? v : op_(back_agg_, v);
+    back_.push(v);
+}
+
+template <typename T, typename Op>
+void aggregate_queue<T, Op>::push(T&& v) {
+    back_agg_ = back_.is_empty() ? v : op_(back_agg_, v);
+    back_.push(std::move(v));
+}
+
+//снятие самого старого; перенос раз на size() снятий, амортизированно O(1)
+template <typename T, typename Op>
+T aggregate_queue<T, Op>::pop() {
+    if(is_empty()) throw std::runtime_error("aggregate_queue empty");
+    if(front_.is_empty()) refill();
+    return front_.pop().value;
+}
+
+//самый старый элемент; если front_ пуст, перенос делается здесь, содержимое очереди не меняется
+template <typename T, typename Op>
+const T& aggregate_queue<T, Op>::get_front() const {
+    if(is_empty()) throw std::runtime_error("aggregate_queue empty");
+    if(front_.is_empty()) refill();
+    return front_.get_front().value;
+}
+
+//свёртка: старые элементы из front_, новые из back_
+template <typename T, typename Op>
+T aggregate_queue<T, Op>::aggregate() const {
+    if(is_empty()) throw std::runtime_error("aggregate_queue empty");
+    if(front_.is_empty()) return back_agg_;
+    if(back_.is_empty()) return front_.get_front().agg;
+    return op_(front_.get_front().agg, back_agg_);
+}
+
+template <typename T, typename Op>
+bool aggregate_queue<T, Op>::is_empty() const { return front_.is_empty() && back_.is_empty(); }
+
+template <typename T, typename Op>
+bool aggregate_queue<T, Op>::empty() const { return is_empty(); }
+
+template <typename T, typename Op>
+std::size_t aggregate_queue<T, Op>::size() const { return front_.size() + back_.size(); }
+
+//перенос: back_ снимается с нового конца, поэтому свёртка каждого элемента - он сам и всё, что новее
+template <typename T, typename Op>
+void aggregate_queue<T, Op>::refill() const {
+    while(!back_.is_empty()) {
+        T v = back_.pop();
+        T agg = front_.is_empty() ? v : op_(v, front_.get_front().agg);
+        front_.push(entry{std::move(v), std::move(agg)});
+    }
+}
+
+//реализация monotonic_queue
+
+//худшие кандидаты с конца уходят: новый элемент переживёт их всех
+template <typename T, typename Better>
+void monotonic_queue<T, Better>::push(const T& v) {
+    values_.push(v);
+    while(!best_.empty() && better_(v, best_.back())) best_.pop_back();
+    best_.push_back(v);
+}
+
+//если уходит лучший, он же первый кандидат
+template <typename T, typename Better>
+T monotonic_queue<T, Better>::pop() {
+    if(is_empty()) throw std::runtime_error("aggregate_queue empty");
+    T v = values_.pop();
+    if(!better_(best_.front(), v)) best_.pop_front();
+    return v;
+}
+
+template <typename T, typename Better>
+const T& monotonic_queue<T, Better>::get_front() const {
+    if(is_empty()) throw std::runtime_error("aggregate_queue empty");
+    return values_.get_front();
+}
+
+template <typename T, typename Better>
+const T& monotonic_queue<T, Better>::aggregate() const {
+    if(is_empty()) throw std::runtime_error("aggregate_queue empty");
+    return best_.front();
+}
+
+template <typename T, typename Better>
+bool monotonic_queue<T, Better>::is_empty() const { return values_.is_empty(); }
+
+template <typename T, typename Better>
+bool monotonic_queue<T, Better>::empty() const { return values_.is_empty(); }
+
+template <typename T, typename Better>
+std::size_t monotonic_queue<T, Better>::size() const { return values_.size(); }
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef ASYNC_CHANNEL_H
+#define ASYNC_CHANNEL_H
+
+#include "event_loop.h"
+#include "intrusive_queue.h"
+#include "queue.h"
+#include <coroutine>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+//канал между корутинами одного event_loop: буфер - queue<T>, не больше capacity элементов
+//co_await ch.push(v) ждёт места в буфере (противодавление), co_await ch.pop() ждёт элемента;
+//поток при этом не блокируется, ждущая корутина продолжится из loop.run()
+//capacity = 0 - рандеву: push ждёт, пока значение не заберёт pop
+//ждущие хранятся прямо в кадрах корутин (intrusive_queue), ожидание не выделяет память
+//значение отдаётся ждущему pop напрямую, минуя буфер
+//корутину, ждущую на канале, нельзя уничтожать, пока её не продолжили; канал - только из потока цикла
+template <typename T, typename Policy = default_policy>
+class async_channel {
+public:
+    //co_await ch.pop() -> std::optional<T>; std::nullopt - канал закрыт и пуст
+    class pop_awaiter {
+        async_channel* ch_;
+        std::optional<T> value_;
+        std::coroutine_handle<> h_;
+        friend class async_channel;
+    public:
+        intrusive_hook<pop_awaiter> hook;
+
+        explicit pop_awaiter(async_channel& ch);
+        bool await_ready();
+        void await_suspend(std::coroutine_handle<> h);
+        std::optional<T> await_resume();
+    };
+
+    //co_await ch.push(v) -> bool; false - канал закрыт, значение не доставлено
+    class push_awaiter {
+        async_channel* ch_;
+        T value_;
+        bool ok_;
+        std::coroutine_handle<> h_;
+        friend class async_channel;
+    public:
+        intrusive_hook<push_awaiter> hook;
+
+        push_awaiter(async_channel& ch, T v);
+        bool await_ready();
+        void await_suspend(std::coroutine_handle<> h);
+        bool await_resume() const;
+    };
+
+private:
+    event_loop& loop_;
+    queue<T, Policy> buf_;
+    std::size_t cap_;
+    intrusive_queue<pop_awaiter> poppers_;      //ждут элемента, буфер при этом пуст
+    intrusive_queue<push_awaiter> pushers_;     //ждут места, буфер при этом полон
+    bool closed_;
+
+public:
+    explicit async_channel(event_loop& loop, std::size_t capacity = 1);
+    async_channel(const async_channel&) = delete;
+    async_channel& operator=(const async_channel&) = delete;
+
+    push_awaiter push(T v);
+    pop_awaiter pop();
+
+    //без ожидания; try_push не трогает v, если вернул false
+    bool try_push(T& v);
+    bool try_push(T&& v);
+    std::optional<T> try_pop();
+
+    //ждущие pop получают std::nullopt, ждущие push - false; буфер ещё можно дочитать
+    void close();
+
+    bool closed() const;
+    std::size_t size() const;           //элементов в буфере
+    std::size_t capacity() const;
+    bool is_empty() const;
+    bool empty() const;
+
+private:
+    bool offer(T& v);                   //отдать ждущему pop или в буфер
+    std::optional<T> take();            //из буфера или от ждущего push
+};
+
+#include "async_channel_impl.h"
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef ASYNC_CHANNEL_IMPL_H
+#define ASYNC_CHANNEL_IMPL_H
+
+//реализация pop_awaiter
+
+template <typename T, typename Policy>
+async_channel<T, Policy>::pop_awaiter::pop_awaiter(async_channel& ch): ch_(&ch) {}
+
+//элемент уже есть или канал закрыт - без приостановки
+template <typename T, typename Policy>
+bool async_channel<T, Policy>::pop_awaiter::await_ready() {
+    value_ = ch_->take();
+    return value_.has_value() || ch_->closed_;
+}
+
+template <typename T, typename Policy>
+void async_channel<T, Policy>::pop_awaiter::await_suspend(std::coroutine_handle<> h) {
+    h_ = h;
+    ch_->poppers_.push(*this);
+}
+
+template <typename T, typename Policy>
+std::optional<T> async_channel<T, Policy>::pop_awaiter::await_resume() { return std::move(value_); }
+
+//реализация push_awaiter
+
+template <typename T, typename Policy>
+async_channel<T, Policy>::push_awaiter::push_awaiter(async_channel& ch, T v): ch_(&ch), value_(std::move(v)), ok_(false) {}
+
+//есть ждущий pop или место в буфере - без приостановки
+template <typename T, typename Policy>
+bool async_channel<T, Policy>::push_awaiter::await_ready() {
+    if(ch_->closed_) return true;
+    ok_ = ch_->offer(value_);
+    return ok_;
+}
+
+template <typename T, typename Policy>
+void async_channel<T, Policy>::push_awaiter::await_suspend(std::coroutine_handle<> h) {
+    h_ = h;
+    ch_->pushers_.push(*this);
+}
+
+template <typename T, typename Policy>
+bool async_channel<T, Policy>::push_awaiter::await_resume() const { return ok_; }
+
+//реализация async_channel
+
+template <typename T, typename Policy>
+async_channel<T, Policy>::async_channel(event_loop& loop, std::size_t capacity)
+    : loop_(loop), cap_(capacity), closed_(false) {}
+
+template <typename T, typename Policy>
+typename async_channel<T, Policy>::push_awaiter async_channel<T, Policy>::push(T v) {
+    return push_awaiter(*this, std::move(v));
+}
+
+template <typename T, typename Policy>
+typename async_channel<T, Policy>::pop_awaiter async_channel<T, Policy>::pop() {
+    return pop_awaiter(*this);
+}
+
+template <typename T, typename Policy>
+bool async_channel<T, Policy>::try_push(T& v) {
+    return !closed_ && offer(v);
+}
+
+template <typename T, typename Policy>
+bool async_channel<T, Policy>::try_push(T&& v) {
+    return !closed_ && offer(v);
+}
+
+template <typename T, typename Policy>
+std::optional<T> async_channel<T, Policy>::try_pop() { return take(); }
+
+template <typename T, typename Policy>
+void async_channel<T, Policy>::close() {
+    if(closed_) return;
+    closed_ = true;
+    while(!poppers_.is_empty()) loop_.post(poppers_.pop().h_);
+    while(!pushers_.is_empty()) loop_.post(pushers_.pop().h_);
+}
+
+template <typename T, typename Policy>
+bool async_channel<T, Policy>::closed() const { return closed_; }
+
+template <typename T, typename Policy>
+std::size_t async_channel<T, Policy>::size() const { return buf_.size(); }
+
+template <typename T, typename Policy>
+std::size_t async_channel<T, Policy>::capacity() const { return cap_; }
+
+template <typename T, typename Policy>
+bool async_channel<T, Policy>::is_empty() const { return buf_.is_empty(); }
+
+template <typename T, typename Policy>
+bool async_channel<T, Policy>::empty() const { return buf_.is_empty(); }
+
+//вспомогательные методы
+
+//ждущий pop есть только при пустом буфере, поэтому порядок FIFO не нарушается
+template <typename T, typename Policy>
+bool async_channel<T, Policy>::offer(T& v) {
+    if(!poppers_.is_empty()) {
+        pop_awaiter& p = poppers_.pop();
+        p.value_.emplace(std::move(v));
+        loop_.post(p.h_);
+        return true;
+    }
+    if(buf_.size() < cap_) {
+        buf_.push(std::move(v));
+        return true;
+    }
+    return false;
+}
+
+//освободившееся место сразу занимает первый ждущий push
+template <typename T, typename Policy>
+std::optional<T> async_channel<T, Policy>::take() {
+    std::optional<T> v;
+    if(!buf_.is_empty()) {
+        v.emplace(buf_.pop());
+        if(pushers_.is_empty()) return v;
+        push_awaiter& w = pushers_.pop();
+        buf_.push(std::move(w.value_));
+        w.ok_ = true;
+        loop_.post(w.h_);
+    } else if(!pushers_.is_empty()) {
+        push_awaiter& w = pushers_.pop();      //рандеву: значение прямо от push
+        v.emplace(std::move(w.value_));
+        w.ok_ = true;
+        loop_.post(w.h_);
+    }
+    return v;
+}
+
+#endif
@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include "../queue.h"
+#include "../aggregate_queue.h"
+#include "../simd_algorithms.h"
+
+//скользящее окно метрик: такт - push нового значения, pop самого старого, запрос свёртки
+//queue<double> с пересчётом по всему окну против aggregate_queue; аргумент - размер окна
+
+namespace {
+
+std::vector<double> ticks()
+{
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> d(0, 100);
+    std::vector<double> v(1 << 16);
+    for (auto& x : v) x = d(rng);
+    return v;
+}
+
+//пересчёт: O(окна) на такт
+template <typename Recompute>
+void run_recompute(benchmark::State& state, Recompute f)
+{
+    const auto v = ticks();
+    queue<double> q;
+    for (std::int64_t i = 0; i < state.range(0); ++i) q.push(v[i % v.size()]);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        q.push(v[i++ % v.size()]);
+        q.pop();
+        benchmark::DoNotOptimize(f(q));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename AQ>
+void run_aggregate(benchmark::State& state)
+{
+    const auto v = ticks();
+    AQ q;
+    for (std::int64_t i = 0; i < state.range(0); ++i) q.push(v[i % v.size()]);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        q.push(v[i++ % v.size()]);
+        q.pop();
+        benchmark::DoNotOptimize(q.aggregate());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_WindowMaxRecompute(benchmark::State& state) { run_recompute(state, [](const queue<double>& q) { return fwd_max(q); }); }
+void BM_WindowSumRecompute(benchmark::State& state) { run_recompute(state, [](const queue<double>& q) { return fwd_sum(q); }); }
+void BM_WindowMaxAggregate(benchmark::State& state) { run_aggregate<aggregate_queue<double, agg_max<double>>>(state); }
+void BM_WindowSumAggregate(benchmark::State& state) { run_aggregate<aggregate_queue<double>>(state); }
+
+}
+
+BENCHMARK(BM_WindowMaxRecompute)->RangeMultiplier(32)->Range(1024, 1 << 20);
+BENCHMARK(BM_WindowMaxAggregate)->RangeMultiplier(32)->Range(1024, 1 << 20);
+BENCHMARK(BM_WindowSumRecompute)->RangeMultiplier(32)->Range(1024, 1 << 20);
+BENCHMARK(BM_WindowSumAggregate)->RangeMultiplier(32)->Range(1024, 1 << 20);
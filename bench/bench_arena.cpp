@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include "../stack.h"
+#include "../queue.h"
+
+//узлы из арены против отдельного new на узел
+//главное - время разрушения: обход с delete каждого узла против освобождения блоков
+
+//разрушение заполненного контейнера, заполнение не входит в замер
+template <typename C>
+static void BM_Teardown(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto c = std::make_unique<C>();
+        for (int i = 0; i < n; ++i) c->push(i);
+        state.ResumeTiming();
+        c.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//заполнение: арена выделяет память блоками, а не на каждый push
+template <typename C>
+static void BM_Fill(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        C c;
+        for (int i = 0; i < n; ++i) c.push(i);
+        benchmark::DoNotOptimize(c);
+        state.PauseTiming();
+        { C drop(std::move(c)); }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//pop половины и push обратно: узлы берутся из списка свободных
+template <typename C>
+static void BM_Churn(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    C c;
+    for (int i = 0; i < n; ++i) c.push(i);
+    for (auto _ : state) {
+        for (int i = 0; i < n / 2; ++i) benchmark::DoNotOptimize(c.pop());
+        for (int i = 0; i < n / 2; ++i) c.push(i);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+#define FWD_ARENA(BM) \
+    BENCHMARK_TEMPLATE(BM, stack<int>)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond); \
+    BENCHMARK_TEMPLATE(BM, stack<int, arena_policy>)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond); \
+    BENCHMARK_TEMPLATE(BM, queue<int>)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond); \
+    BENCHMARK_TEMPLATE(BM, queue<int, arena_policy>)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMicrosecond)
+
+FWD_ARENA(BM_Teardown);
+FWD_ARENA(BM_Fill);
+FWD_ARENA(BM_Churn);
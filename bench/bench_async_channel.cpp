@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "../async_channel.h"
+#include "../queue.h"
+
+//передача сообщения между корутинами через async_channel на одном event_loop
+//против двух потоков с queue<int> под mutex и condition_variable
+//PingPong - время полного круга туда и обратно; Stream - поток сообщений через буфер, аргумент - capacity;
+//с arena_policy узлы буфера переиспользуются, без malloc на сообщение
+
+namespace {
+
+task echo(async_channel<int>& in, async_channel<int>& out)
+{
+    while (auto v = co_await in.pop())
+        if (!co_await out.push(*v)) co_return;
+}
+
+void BM_ChannelPingPong(benchmark::State& state)
+{
+    event_loop loop;
+    async_channel<int> ping(loop), pong(loop);
+    loop.spawn(echo(ping, pong));
+    loop.run();
+    int i = 0;
+    for (auto _ : state) {
+        ping.try_push(i++);
+        loop.run();
+        benchmark::DoNotOptimize(pong.try_pop());
+    }
+    ping.close();
+    loop.run();
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Policy>
+task send_n(async_channel<int, Policy>& ch, std::int64_t n)
+{
+    for (std::int64_t i = 0; i < n; ++i) co_await ch.push(static_cast<int>(i));
+    ch.close();
+}
+
+template <typename Policy>
+task sum_all(async_channel<int, Policy>& ch, long long& sum)
+{
+    while (auto v = co_await ch.pop()) sum += *v;
+}
+
+template <typename Policy>
+void BM_ChannelStream(benchmark::State& state)
+{
+    const std::int64_t n = 1 << 16;
+    for (auto _ : state) {
+        event_loop loop;
+        async_channel<int, Policy> ch(loop, state.range(0));
+        long long sum = 0;
+        loop.spawn(send_n(ch, n));
+        loop.spawn(sum_all(ch, sum));
+        loop.run();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+//блокирующий канал: один поток ждёт на condition_variable
+struct blocking_channel {
+    std::mutex m;
+    std::condition_variable cv;
+    queue<int> q;
+
+    void push(int v) {
+        { std::lock_guard<std::mutex> g(m); q.push(v); }
+        cv.notify_one();
+    }
+    int pop() {
+        std::unique_lock<std::mutex> g(m);
+        cv.wait(g, [&] { return !q.is_empty(); });
+        return q.pop();
+    }
+};
+
+void BM_ThreadPingPong(benchmark::State& state)
+{
+    blocking_channel ping, pong;
+    std::thread t([&] {
+        for (int v; (v = ping.pop()) >= 0;) pong.push(v);
+    });
+    int i = 0;
+    for (auto _ : state) {
+        ping.push(i++);
+        benchmark::DoNotOptimize(pong.pop());
+    }
+    ping.push(-1);
+    t.join();
+    state.SetItemsProcessed(state.iterations());
+}
+
+}
+
+BENCHMARK(BM_ChannelPingPong);
+BENCHMARK_TEMPLATE(BM_ChannelStream, default_policy)->Arg(0)->Arg(1)->Arg(64);
+BENCHMARK_TEMPLATE(BM_ChannelStream, arena_policy)->Arg(1)->Arg(64);
+BENCHMARK(BM_ThreadPingPong)->UseRealTime();
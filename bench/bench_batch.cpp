@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <numeric>
+#include <vector>
+#include "../stack.h"
+#include "../queue.h"
+
+//код, у которого есть только fwd_container<int>&: поэлементные виртуальные вызовы
+//против push_many/pop_many/for_each_chunk с одним вызовом на пакет
+
+namespace {
+
+std::unique_ptr<fwd_container<int>> make(int kind)
+{
+    if (kind == 0) return std::make_unique<stack<int>>();
+    return std::make_unique<queue<int>>();
+}
+
+const char* kind_name(int kind) { return kind == 0 ? "stack" : "queue"; }
+
+//push n и pop n через базовый класс по одному
+void BM_BasePushPopEach(benchmark::State& state)
+{
+    auto c = make(static_cast<int>(state.range(0)));
+    fwd_container<int>& b = *c;
+    const int n = static_cast<int>(state.range(1));
+    long long sum = 0;
+    for (auto _ : state) {
+        for (int i = 0; i < n; ++i) b.push(i);
+        for (int i = 0; i < n; ++i) sum += b.pop();
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetLabel(kind_name(static_cast<int>(state.range(0))));
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+//то же пакетами
+void BM_BasePushPopMany(benchmark::State& state)
+{
+    auto c = make(static_cast<int>(state.range(0)));
+    fwd_container<int>& b = *c;
+    const int n = static_cast<int>(state.range(1));
+    std::vector<int> in(n), out(n);
+    std::iota(in.begin(), in.end(), 0);
+    long long sum = 0;
+    for (auto _ : state) {
+        b.push_many(in.data(), in.size());
+        b.pop_many(out.data(), out.size());
+        sum += out[0];
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetLabel(kind_name(static_cast<int>(state.range(0))));
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+//сумма через итераторы базового класса: виртуальные ++, * и != на каждый элемент
+void BM_BaseSumIter(benchmark::State& state)
+{
+    auto c = make(static_cast<int>(state.range(0)));
+    const int n = static_cast<int>(state.range(1));
+    for (int i = 0; i < n; ++i) c->push(i);
+    const fwd_container<int>& b = *c;
+    for (auto _ : state) {
+        long long sum = 0;
+        for (int v : b) sum += v;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetLabel(kind_name(static_cast<int>(state.range(0))));
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+//сумма порциями
+void BM_BaseSumChunks(benchmark::State& state)
+{
+    auto c = make(static_cast<int>(state.range(0)));
+    const int n = static_cast<int>(state.range(1));
+    for (int i = 0; i < n; ++i) c->push(i);
+    const fwd_container<int>& b = *c;
+    for (auto _ : state) {
+        long long sum = 0;
+        b.for_each_chunk([&](const int* p, std::size_t k) { for (std::size_t i = 0; i < k; ++i) sum += p[i]; });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetLabel(kind_name(static_cast<int>(state.range(0))));
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+}
+
+BENCHMARK(BM_BasePushPopEach)->ArgsProduct({{0, 1}, {64, 4096, 262144}});
+BENCHMARK(BM_BasePushPopMany)->ArgsProduct({{0, 1}, {64, 4096, 262144}});
+BENCHMARK(BM_BaseSumIter)->ArgsProduct({{0, 1}, {64, 4096, 262144}});
+BENCHMARK(BM_BaseSumChunks)->ArgsProduct({{0, 1}, {64, 4096, 262144}});
@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "../queue.h"
+#include "../compressed_queue.h"
+
+//байт на элемент и скорость compressed_queue<int64_t> против queue<int64_t>
+//на отсортированных данных (метки времени, id) и на случайных
+
+//метки времени: растут с джиттером, иногда приходят чуть не по порядку
+static std::vector<std::int64_t> sorted_data(std::size_t n)
+{
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int> step(0, 2000);
+    std::vector<std::int64_t> v(n);
+    std::int64_t t = 1700000000000000;
+    for (auto& x : v) {
+        t += step(rng);
+        x = (rng() % 16 == 0) ? t - 500 : t;
+    }
+    return v;
+}
+
+static std::vector<std::int64_t> random_data(std::size_t n)
+{
+    std::mt19937_64 rng(42);
+    std::vector<std::int64_t> v(n);
+    for (auto& x : v) x = static_cast<std::int64_t>(rng());
+    return v;
+}
+
+template <std::vector<std::int64_t> (*Gen)(std::size_t)>
+static void BM_CompressedPush(benchmark::State& state)
+{
+    auto data = Gen(static_cast<std::size_t>(state.range(0)));
+    std::size_t mem = 0;
+    for (auto _ : state) {
+        compressed_queue<std::int64_t> q;
+        for (auto x : data) q.push(x);
+        mem = q.memory_usage();
+        benchmark::DoNotOptimize(q);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes_per_elem"] = double(mem) / double(data.size());
+}
+
+template <std::vector<std::int64_t> (*Gen)(std::size_t)>
+static void BM_QueuePush(benchmark::State& state)
+{
+    auto data = Gen(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        queue<std::int64_t> q;
+        for (auto x : data) q.push(x);
+        benchmark::DoNotOptimize(q);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    queue<std::int64_t> q;
+    for (auto x : data) q.push(x);
+    state.counters["bytes_per_elem"] = double(q.memory_usage()) / double(data.size());
+}
+
+template <std::vector<std::int64_t> (*Gen)(std::size_t)>
+static void BM_CompressedPop(benchmark::State& state)
+{
+    auto data = Gen(static_cast<std::size_t>(state.range(0)));
+    compressed_queue<std::int64_t> src;
+    for (auto x : data) src.push(x);
+    for (auto _ : state) {
+        state.PauseTiming();
+        compressed_queue<std::int64_t> q(src);
+        state.ResumeTiming();
+        std::int64_t sum = 0;
+        while (!q.is_empty()) sum += q.pop();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <std::vector<std::int64_t> (*Gen)(std::size_t)>
+static void BM_CompressedIterate(benchmark::State& state)
+{
+    auto data = Gen(static_cast<std::size_t>(state.range(0)));
+    compressed_queue<std::int64_t> q;
+    for (auto x : data) q.push(x);
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        for (auto x : q) sum += x;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <std::vector<std::int64_t> (*Gen)(std::size_t)>
+static void BM_QueueIterate(benchmark::State& state)
+{
+    auto data = Gen(static_cast<std::size_t>(state.range(0)));
+    queue<std::int64_t> q;
+    for (auto x : data) q.push(x);
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        for (auto x : q) sum += x;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_CompressedPush, sorted_data)->Name("BM_CompressedPush/sorted")->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_CompressedPush, random_data)->Name("BM_CompressedPush/random")->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_QueuePush, sorted_data)->Name("BM_QueuePush/sorted")->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_QueuePush, random_data)->Name("BM_QueuePush/random")->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_CompressedPop, sorted_data)->Name("BM_CompressedPop/sorted")->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_CompressedIterate, sorted_data)->Name("BM_CompressedIterate/sorted")->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_CompressedIterate, random_data)->Name("BM_CompressedIterate/random")->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_QueueIterate, sorted_data)->Name("BM_QueueIterate/sorted")->Arg(1 << 20);
@@ -0,0 +1,257 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <deque>
+#include <queue>
+#include <sstream>
+#include <stack>
+#include <string>
+#include "../stack.h"
+#include "../queue.h"
+
+//базовые операции stack<T> и queue<T> против std::stack, std::queue и std::deque
+//типы: int, std::string (в куче, длиннее SSO) и 64-байтная POD-структура
+//размеры от 10 до 10M; для строк до 1M - 10M строк вместе с копией не влезают в память сборочной машины
+
+//64-байтная POD-запись
+struct pod64 {
+    std::uint64_t words[8];
+};
+
+//значение номер i для каждого типа
+template <typename T> T make_value(std::size_t i);
+
+template <> int make_value<int>(std::size_t i) { return static_cast<int>(i); }
+
+template <> std::string make_value<std::string>(std::size_t i) {
+    return "benchmark-payload-" + std::to_string(i) + "-xxxxxxxxxxxx";
+}
+
+template <> pod64 make_value<pod64>(std::size_t i) {
+    pod64 p;
+    for (int k = 0; k < 8; ++k) p.words[k] = i + k;
+    return p;
+}
+
+//что-нибудь из значения, чтобы обход нельзя было выбросить
+inline std::uint64_t touch(int v) { return static_cast<std::uint64_t>(v); }
+inline std::uint64_t touch(const std::string& v) { return v.size(); }
+inline std::uint64_t touch(const pod64& v) { return v.words[0]; }
+
+//единый интерфейс push/pop для наших и стандартных контейнеров
+template <typename T> void put(fwd_container<T>& c, T v) { c.push(std::move(v)); }
+template <typename T> void put(std::stack<T>& c, T v) { c.push(std::move(v)); }
+template <typename T> void put(std::queue<T>& c, T v) { c.push(std::move(v)); }
+template <typename T> void put(std::deque<T>& c, T v) { c.push_back(std::move(v)); }
+
+template <typename T> T take(fwd_container<T>& c) { return c.pop(); }
+template <typename T> T take(std::stack<T>& c) { T v = std::move(c.top()); c.pop(); return v; }
+template <typename T> T take(std::queue<T>& c) { T v = std::move(c.front()); c.pop(); return v; }
+template <typename T> T take(std::deque<T>& c) { T v = std::move(c.front()); c.pop_front(); return v; }
+
+template <typename C, typename T>
+static void fill(C& c, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) put<T>(c, make_value<T>(i));
+}
+
+//заполнение с нуля
+template <typename C, typename T>
+static void BM_Push(benchmark::State& state)
+{
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        C c;
+        fill<C, T>(c, n);
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//опустошение; заполнение не входит в замер
+template <typename C, typename T>
+static void BM_Pop(benchmark::State& state)
+{
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::uint64_t sum = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        C c;
+        fill<C, T>(c, n);
+        state.ResumeTiming();
+        for (std::size_t i = 0; i < n; ++i) sum += touch(take<T>(c));
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//обход итераторами; у std::stack и std::queue итераторов нет, база - std::deque
+template <typename C, typename T>
+static void BM_Iterate(benchmark::State& state)
+{
+    C c;
+    fill<C, T>(c, static_cast<std::size_t>(state.range(0)));
+    const C& r = c;
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (const auto& v : r) sum += touch(v);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//копирующий конструктор
+template <typename C, typename T>
+static void BM_Copy(benchmark::State& state)
+{
+    C c;
+    fill<C, T>(c, static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        C copy(c);
+        benchmark::DoNotOptimize(copy);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//копирующее присваивание в уже заполненный контейнер того же размера
+template <typename C, typename T>
+static void BM_Assign(benchmark::State& state)
+{
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    C c, dst;
+    fill<C, T>(c, n);
+    fill<C, T>(dst, n);
+    for (auto _ : state) {
+        dst = c;
+        benchmark::DoNotOptimize(dst);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//присваивание через fwd_container& между разными контейнерами (stack = queue)
+template <typename T>
+static void BM_AssignBase(benchmark::State& state)
+{
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    queue<T> src;
+    stack<T> dst;
+    fill<queue<T>, T>(src, n);
+    fwd_container<T>& base = dst;
+    for (auto _ : state) {
+        base = src;
+        benchmark::DoNotOptimize(dst);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//вывод в поток: operator<< против цикла по std::deque
+template <typename C, typename T>
+static void BM_StreamOut(benchmark::State& state)
+{
+    C c;
+    fill<C, T>(c, static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::ostringstream os;
+        os << c;
+        benchmark::DoNotOptimize(os);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void BM_StreamOutDeque(benchmark::State& state)
+{
+    std::deque<T> c;
+    fill<std::deque<T>, T>(c, static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::ostringstream os;
+        bool first = true;
+        for (const auto& v : c) {
+            if (!first) os << ' ';
+            os << v;
+            first = false;
+        }
+        benchmark::DoNotOptimize(os);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//текст из n значений через пробел
+template <typename T>
+static std::string stream_text(std::size_t n)
+{
+    std::ostringstream os;
+    for (std::size_t i = 0; i < n; ++i) os << make_value<T>(i) << ' ';
+    return os.str();
+}
+
+//ввод из потока: operator>> против цикла в std::deque
+template <typename C, typename T>
+static void BM_StreamIn(benchmark::State& state)
+{
+    const std::string text = stream_text<T>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::istringstream is(text);
+        C c;
+        is >> c;
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+static void BM_StreamInDeque(benchmark::State& state)
+{
+    const std::string text = stream_text<T>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::istringstream is(text);
+        std::deque<T> c;
+        T v;
+        while (is >> v) c.push_back(v);
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//регистрация: наши контейнеры и базовые линии по каждому типу
+#define FWD_SIZES(max_n) RangeMultiplier(10)->Range(10, max_n)
+
+#define FWD_BENCH_TYPE(T, max_n) \
+    BENCHMARK_TEMPLATE(BM_Push, stack<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Push, queue<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Push, std::stack<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Push, std::queue<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Push, std::deque<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Pop, stack<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Pop, queue<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Pop, std::stack<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Pop, std::queue<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Pop, std::deque<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Iterate, stack<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Iterate, queue<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Iterate, std::deque<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Copy, stack<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Copy, queue<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Copy, std::stack<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Copy, std::queue<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Copy, std::deque<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Assign, stack<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Assign, queue<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Assign, std::stack<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Assign, std::queue<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_Assign, std::deque<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_AssignBase, T)->FWD_SIZES(max_n)
+
+//потоковый ввод-вывод только для типов с operator<< и operator>>
+#define FWD_BENCH_STREAM(T, max_n) \
+    BENCHMARK_TEMPLATE(BM_StreamOut, stack<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_StreamOut, queue<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_StreamOutDeque, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_StreamIn, stack<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_StreamIn, queue<T>, T)->FWD_SIZES(max_n); \
+    BENCHMARK_TEMPLATE(BM_StreamInDeque, T)->FWD_SIZES(max_n)
+
+FWD_BENCH_TYPE(int, 10000000);
+FWD_BENCH_TYPE(std::string, 1000000);
+FWD_BENCH_TYPE(pod64, 10000000);
+FWD_BENCH_STREAM(int, 10000000);
+FWD_BENCH_STREAM(std::string, 1000000);
@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+#include "../stack.h"
+#include "../queue.h"
+
+//раскладка узлов и предвыборка: обход, копирование и очистка списков больше кэша последнего уровня
+//"до" - default_policy, "после" - prefetch_policy, line_only и cache_line_policy (и то, и другое)
+//узлы строятся вперемешку со случайными по размеру блоками, как в куче после долгой работы:
+//адреса растут неравномерно, и аппаратная предвыборка по шагу не угадывает следующий узел
+
+namespace {
+
+//только выравнивание по строке
+struct line_only : default_policy {
+    static constexpr std::size_t node_align = node_align_line;
+};
+
+//узел из 8 + 24 байт: без выравнивания часть узлов лежит на двух строках
+struct payload24 {
+    std::int64_t a, b, c;
+};
+
+inline std::int64_t key(std::int64_t v) { return v; }
+inline std::int64_t key(const payload24& v) { return v.a; }
+
+template <typename T> T make(std::int64_t i);
+template <> std::int64_t make<std::int64_t>(std::int64_t i) { return i; }
+template <> payload24 make<payload24>(std::int64_t i) { return payload24{i, i, i}; }
+
+//заполнение с промежуточными блоками, блоки освобождаются после
+template <typename C, typename T>
+void build_scattered(C& c, std::size_t n)
+{
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> gap(16, 112);
+    std::vector<std::unique_ptr<char[]>> garbage;
+    garbage.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        c.push(make<T>(static_cast<std::int64_t>(i)));
+        garbage.emplace_back(new char[static_cast<std::size_t>(gap(rng))]);
+    }
+}
+
+}
+
+//обход константными итераторами
+template <typename C, typename T>
+static void BM_Traverse(benchmark::State& state)
+{
+    C c;
+    build_scattered<C, T>(c, static_cast<std::size_t>(state.range(0)));
+    const C& r = c;
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        for (const auto& v : r) sum += key(v);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//копирующий конструктор
+template <typename C, typename T>
+static void BM_CopyLarge(benchmark::State& state)
+{
+    C c;
+    build_scattered<C, T>(c, static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        C copy(c);
+        benchmark::DoNotOptimize(copy);
+        state.PauseTiming();
+        { C drop(std::move(copy)); }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//очистка: деструктор вызывает clear()
+template <typename C, typename T>
+static void BM_ClearLarge(benchmark::State& state)
+{
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto c = std::make_unique<C>();
+        build_scattered<C, T>(*c, static_cast<std::size_t>(state.range(0)));
+        state.ResumeTiming();
+        c.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//2M узлов с промежутками - около 200 МБ, больше LLC; 16K - для сравнения внутри кэша
+#define FWD_LAYOUT(BM, C, T) \
+    BENCHMARK_TEMPLATE(BM, C<T, default_policy>, T)->Arg(1 << 14)->Arg(1 << 21)->Unit(benchmark::kMillisecond); \
+    BENCHMARK_TEMPLATE(BM, C<T, prefetch_policy>, T)->Arg(1 << 14)->Arg(1 << 21)->Unit(benchmark::kMillisecond); \
+    BENCHMARK_TEMPLATE(BM, C<T, line_only>, T)->Arg(1 << 14)->Arg(1 << 21)->Unit(benchmark::kMillisecond); \
+    BENCHMARK_TEMPLATE(BM, C<T, cache_line_policy>, T)->Arg(1 << 14)->Arg(1 << 21)->Unit(benchmark::kMillisecond)
+
+FWD_LAYOUT(BM_Traverse, queue, std::int64_t);
+FWD_LAYOUT(BM_Traverse, queue, payload24);
+FWD_LAYOUT(BM_Traverse, stack, payload24);
+FWD_LAYOUT(BM_CopyLarge, queue, payload24);
+FWD_LAYOUT(BM_CopyLarge, stack, payload24);
+FWD_LAYOUT(BM_ClearLarge, queue, payload24);
+FWD_LAYOUT(BM_ClearLarge, stack, payload24);
@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <list>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "../lru_cache.h"
+#include "../queue.h"
+
+//поток запросов с распределением Ципфа (s = 0.99) по 1M ключам: get, при промахе put
+//lru_cache против std::list + std::unordered_map и против прежней схемы queue<K> + карта,
+//где тронутый ключ ищется в очереди линейно; аргумент - вместимость кэша
+//в счётчиках - доля попаданий
+
+namespace {
+
+constexpr std::size_t universe = 1 << 20;
+
+const std::vector<std::uint64_t>& zipf_keys()
+{
+    static const std::vector<std::uint64_t> keys = [] {
+        std::vector<double> cdf(universe);
+        double sum = 0;
+        for (std::size_t i = 0; i < universe; ++i) cdf[i] = sum += 1.0 / std::pow(double(i + 1), 0.99);
+        std::mt19937_64 rng(13);
+        std::uniform_real_distribution<double> u(0, sum);
+        std::vector<std::uint64_t> v(1 << 22);
+        for (auto& k : v) {
+            std::uint64_t rank = std::lower_bound(cdf.begin(), cdf.end(), u(rng)) - cdf.begin();
+            k = rank * 0x9E3779B97F4A7C15ull >> 20;            //популярные ключи не подряд
+        }
+        return v;
+    }();
+    return keys;
+}
+
+//эталонный LRU на двусвязном списке
+class list_lru {
+    std::size_t cap_;
+    std::list<std::pair<std::uint64_t, std::uint64_t>> order_;
+    std::unordered_map<std::uint64_t, decltype(order_)::iterator> index_;
+public:
+    explicit list_lru(std::size_t cap): cap_(cap) { index_.reserve(cap); }
+    std::uint64_t* get(std::uint64_t k) {
+        auto it = index_.find(k);
+        if (it == index_.end()) return nullptr;
+        order_.splice(order_.end(), order_, it->second);
+        return &it->second->second;
+    }
+    void put(std::uint64_t k, std::uint64_t v) {
+        if (order_.size() == cap_) { index_.erase(order_.front().first); order_.pop_front(); }
+        index_[k] = order_.insert(order_.end(), {k, v});
+    }
+};
+
+//прежняя схема: порядок в queue<K>, значения в карте, перенос в конец - поиск по очереди
+class scan_lru {
+    std::size_t cap_;
+    queue<std::uint64_t> order_;
+    std::unordered_map<std::uint64_t, std::uint64_t> values_;
+public:
+    explicit scan_lru(std::size_t cap): cap_(cap) { values_.reserve(cap); }
+    std::uint64_t* get(std::uint64_t k) {
+        auto it = values_.find(k);
+        if (it == values_.end()) return nullptr;
+        queue<std::uint64_t> rest;
+        while (!order_.is_empty()) {
+            std::uint64_t x = order_.pop();
+            if (x != k) rest.push(x);
+        }
+        rest.push(k);
+        order_ = std::move(rest);
+        return &it->second;
+    }
+    void put(std::uint64_t k, std::uint64_t v) {
+        if (values_.size() == cap_) values_.erase(order_.pop());
+        order_.push(k);
+        values_[k] = v;
+    }
+};
+
+template <typename Cache>
+void BM_LruZipf(benchmark::State& state)
+{
+    const auto& keys = zipf_keys();
+    Cache c(state.range(0));
+    std::size_t i = 0, hits = 0, total = 0;
+    for (auto _ : state) {
+        std::uint64_t k = keys[i++ & (keys.size() - 1)];
+        if (auto* v = c.get(k)) {
+            benchmark::DoNotOptimize(*v);
+            hits++;
+        } else {
+            c.put(k, k);
+        }
+        total++;
+    }
+    state.counters["hit_rate"] = double(hits) / total;
+    state.SetItemsProcessed(state.iterations());
+}
+
+}
+
+BENCHMARK_TEMPLATE(BM_LruZipf, lru_cache<std::uint64_t, std::uint64_t>)->RangeMultiplier(16)->Range(1024, 1 << 18);
+BENCHMARK_TEMPLATE(BM_LruZipf, list_lru)->RangeMultiplier(16)->Range(1024, 1 << 18);
+BENCHMARK_TEMPLATE(BM_LruZipf, scan_lru)->Arg(1024);
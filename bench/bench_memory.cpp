@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+#include <malloc.h>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include "../stack.h"
+#include "../queue.h"
+#include "../small_stack.h"
+
+//отчёт о памяти: байт на элемент по типу T, сколько стоит узел на каждый элемент
+//bytes_per_elem - по memory_usage(), heap_per_elem - прирост кучи glibc (mallinfo2), для сверки
+//у std::deque memory_usage() нет, для неё только heap_per_elem
+//время здесь не интересно, каждый вариант строится один раз
+
+//вспомогательное - в безымянном пространстве: bench_containers.cpp собирается в тот же исполняемый файл
+namespace {
+
+struct pod64 {
+    std::uint64_t words[8];
+};
+
+//значение номер i
+template <typename T> T make_value(std::size_t i);
+template <> int make_value<int>(std::size_t i) { return static_cast<int>(i); }
+template <> double make_value<double>(std::size_t i) { return static_cast<double>(i); }
+template <> pod64 make_value<pod64>(std::size_t i) { pod64 p{}; p.words[0] = i; return p; }
+
+//строки короче и длиннее встроенного буфера (SSO)
+struct short_string { std::string s; };
+struct long_string { std::string s; };
+
+template <typename T> struct value_of { using type = T; static T make(std::size_t i) { return make_value<T>(i); } };
+template <> struct value_of<short_string> {
+    using type = std::string;
+    static std::string make(std::size_t i) { return std::to_string(i % 1000).insert(0, 1, 's'); }
+};
+template <> struct value_of<long_string> {
+    using type = std::string;
+    static std::string make(std::size_t i) { return "a-string-longer-than-sso-" + std::to_string(i); }
+};
+
+}
+
+//занятая куча: обычные блоки и крупные, выделенные через mmap
+static std::size_t heap_in_use()
+{
+    struct mallinfo2 mi = mallinfo2();
+    return mi.uordblks + mi.hblkhd;
+}
+
+//наши контейнеры: memory_usage() и фактический прирост кучи
+template <typename C, typename V>
+static void BM_Memory(benchmark::State& state)
+{
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    double reported = 0, measured = 0;
+    for (auto _ : state) {
+        std::size_t before = heap_in_use();
+        C c;
+        for (std::size_t i = 0; i < n; ++i) c.push(value_of<V>::make(i));
+        measured = double(heap_in_use() - before + sizeof(C));
+        reported = double(c.memory_usage());
+        benchmark::DoNotOptimize(c);
+    }
+    state.counters["bytes_per_elem"] = reported / double(n);
+    state.counters["heap_per_elem"] = measured / double(n);
+    state.counters["payload"] = double(sizeof(typename value_of<V>::type));
+}
+
+//база: std::deque, только прирост кучи
+template <typename V>
+static void BM_MemoryDeque(benchmark::State& state)
+{
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    double measured = 0;
+    for (auto _ : state) {
+        std::size_t before = heap_in_use();
+        std::deque<typename value_of<V>::type> c;
+        for (std::size_t i = 0; i < n; ++i) c.push_back(value_of<V>::make(i));
+        measured = double(heap_in_use() - before + sizeof(c));
+        benchmark::DoNotOptimize(c);
+    }
+    state.counters["heap_per_elem"] = measured / double(n);
+    state.counters["payload"] = double(sizeof(typename value_of<V>::type));
+}
+
+#define FWD_MEMORY(V) \
+    BENCHMARK_TEMPLATE(BM_Memory, stack<value_of<V>::type>, V)->Arg(10)->Arg(100000)->Iterations(1); \
+    BENCHMARK_TEMPLATE(BM_Memory, queue<value_of<V>::type>, V)->Arg(10)->Arg(100000)->Iterations(1); \
+    BENCHMARK_TEMPLATE(BM_Memory, small_stack<value_of<V>::type>, V)->Arg(10)->Arg(100000)->Iterations(1); \
+    BENCHMARK_TEMPLATE(BM_MemoryDeque, V)->Arg(10)->Arg(100000)->Iterations(1)
+
+FWD_MEMORY(int);
+FWD_MEMORY(double);
+FWD_MEMORY(pod64);
+FWD_MEMORY(short_string);
+FWD_MEMORY(long_string);
@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "../queue.h"
+#include "../merge_sorted.h"
+
+//слияние k отсортированных очередей, всего 1M элементов
+//дерево проигравших с перецепкой узлов против выбора минимума по get_front всех входов с pop/push
+
+namespace {
+
+constexpr int total = 1 << 20;
+
+void fill(std::vector<queue<int>>& qs, int k)
+{
+    qs.assign(k, queue<int>());
+    for (int i = 0; i < total; ++i) qs[i % k].push(i);      //по возрастанию в каждом входе
+}
+
+void BM_MergeLoserTree(benchmark::State& state)
+{
+    const int k = static_cast<int>(state.range(0));
+    std::vector<queue<int>> qs;
+    std::vector<queue<int>*> in;
+    queue<int> out;
+    for (auto _ : state) {
+        state.PauseTiming();
+        fill(qs, k);
+        in.clear();
+        for (auto& q : qs) in.push_back(&q);
+        out = queue<int>();
+        state.ResumeTiming();
+        merge_sorted(in, out);
+        benchmark::DoNotOptimize(out.get_front());
+    }
+    state.SetItemsProcessed(state.iterations() * total);
+}
+
+//линейный выбор: O(k) сравнений и копия элемента на каждый выход
+void BM_MergeLinearScan(benchmark::State& state)
+{
+    const int k = static_cast<int>(state.range(0));
+    std::vector<queue<int>> qs;
+    queue<int> out;
+    for (auto _ : state) {
+        state.PauseTiming();
+        fill(qs, k);
+        out = queue<int>();
+        state.ResumeTiming();
+        for (;;) {
+            queue<int>* best = nullptr;
+            for (auto& q : qs)
+                if (!q.is_empty() && (!best || q.get_front() < best->get_front())) best = &q;
+            if (!best) break;
+            out.push(best->pop());
+        }
+        benchmark::DoNotOptimize(out.get_front());
+    }
+    state.SetItemsProcessed(state.iterations() * total);
+}
+
+}
+
+BENCHMARK(BM_MergeLoserTree)->Arg(2)->Arg(16)->Arg(256)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MergeLinearScan)->Arg(2)->Arg(16)->Arg(256)->Unit(benchmark::kMillisecond);
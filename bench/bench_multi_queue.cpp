@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+#include <mutex>
+#include "../multi_queue.h"
+#include "../queue.h"
+
+//пропускная способность при 1..64 потоках: каждый поток делает push и затем try_pop
+//multi_queue (шард на поток) против одной queue<int> за std::mutex
+//на машине с малым числом ядер потоки сверх ядер только делят время, масштабирование видно на многоядерной
+
+namespace {
+
+struct locked_int_queue {
+    std::mutex m;
+    queue<int> q;
+
+    void push(int v) {
+        std::lock_guard<std::mutex> g(m);
+        q.push(v);
+    }
+    bool try_pop(int& out) {
+        std::lock_guard<std::mutex> g(m);
+        if (q.is_empty()) return false;
+        out = q.pop();
+        return true;
+    }
+};
+
+template <typename Q>
+Q& shared_queue()
+{
+    static Q q;
+    return q;
+}
+
+template <typename Q>
+void BM_SharedQueue(benchmark::State& state)
+{
+    Q& q = shared_queue<Q>();
+    int v = state.thread_index();
+    for (auto _ : state) {
+        q.push(v);
+        benchmark::DoNotOptimize(q.try_pop(v));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+}
+
+BENCHMARK_TEMPLATE(BM_SharedQueue, locked_int_queue)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SharedQueue, multi_queue<int>)->ThreadRange(1, 64)->UseRealTime();
@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+#include <malloc.h>
+#include <vector>
+#include "../queue.h"
+#include "../persistent_queue.h"
+
+//снимки для повтора и аудита: копия очереди перед каждым шагом, шаг - push + pop
+//сравниваем скорость и память, удерживаемую снимками, с копированием queue<T>
+
+//занятая куча по данным glibc
+static std::size_t heap_in_use()
+{
+    return mallinfo2().uordblks;
+}
+
+template <typename Q>
+static void BM_SnapshotStep(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    const int snapshots = 64;
+    double bytes = 0;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::size_t before = heap_in_use();
+        {
+            Q q;
+            for (int i = 0; i < n; ++i) q.push(i);
+            std::vector<Q> history;
+            history.reserve(snapshots);
+            state.ResumeTiming();
+
+            for (int step = 0; step < snapshots; ++step) {
+                history.push_back(q);
+                q.push(n + step);
+                benchmark::DoNotOptimize(q.pop());
+            }
+
+            state.PauseTiming();
+            bytes = double(heap_in_use() - before);
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * snapshots);
+    state.counters["heap_bytes_per_elem"] = bytes / double(n);
+}
+
+//чистая пропускная способность push/pop без снимков
+template <typename Q>
+static void BM_PushPop(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        Q q;
+        for (int i = 0; i < n; ++i) q.push(i);
+        long long sum = 0;
+        while (!q.is_empty()) sum += q.pop();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n * 2);
+}
+
+BENCHMARK_TEMPLATE(BM_SnapshotStep, queue<int>)->Arg(100)->Arg(10000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_SnapshotStep, persistent_queue<int>)->Arg(100)->Arg(10000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_PushPop, queue<int>)->Arg(1000)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_PushPop, persistent_queue<int>)->Arg(1000)->Arg(1000000);
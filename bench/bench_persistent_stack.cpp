@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "../stack.h"
+#include "../persistent_stack.h"
+
+//история отмены: перед каждой правкой снимок стека, сама правка - пара push/pop
+//аргумент - глубина стека, которую копирует каждый снимок
+
+template <typename S>
+static void BM_SnapshotEdit(benchmark::State& state)
+{
+    const int depth = static_cast<int>(state.range(0));
+    S base;
+    for (int i = 0; i < depth; ++i) base.push(i);
+
+    for (auto _ : state) {
+        S s(base);
+        std::vector<S> history;
+        history.reserve(64);
+        for (int step = 0; step < 64; ++step) {
+            history.push_back(s);       //снимок
+            s.push(step);
+            s.push(step + 1);
+            s.pop();
+        }
+        benchmark::DoNotOptimize(history.data());
+    }
+    state.SetItemsProcessed(state.iterations() * 64);
+}
+
+//спекулятивное выполнение: ветка от общей версии, несколько операций, откат
+template <typename S>
+static void BM_SpeculativeBranch(benchmark::State& state)
+{
+    const int depth = static_cast<int>(state.range(0));
+    S base;
+    for (int i = 0; i < depth; ++i) base.push(i);
+
+    long long sum = 0;
+    for (auto _ : state) {
+        S branch(base);
+        branch.pop();
+        branch.push(-1);
+        sum += branch.pop();
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_SnapshotEdit, stack<int>)->Arg(16)->Arg(1024)->Arg(65536);
+BENCHMARK_TEMPLATE(BM_SnapshotEdit, persistent_stack<int>)->Arg(16)->Arg(1024)->Arg(65536);
+BENCHMARK_TEMPLATE(BM_SpeculativeBranch, stack<int>)->Arg(16)->Arg(1024)->Arg(65536);
+BENCHMARK_TEMPLATE(BM_SpeculativeBranch, persistent_stack<int>)->Arg(16)->Arg(1024)->Arg(65536);
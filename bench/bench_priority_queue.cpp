@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+#include <queue>
+#include <random>
+#include <vector>
+#include "../priority_queue.h"
+
+//priority_queue<int, std::less<int>, D> против std::priority_queue<int>
+//аргумент - число элементов
+
+namespace {
+
+std::vector<int> random_ints(std::size_t n)
+{
+    std::mt19937 rng(7);
+    std::vector<int> v(n);
+    for (auto& x : v) x = static_cast<int>(rng());
+    return v;
+}
+
+//push всех, потом pop всех
+template <typename PQ>
+void BM_PQPushPop(benchmark::State& state)
+{
+    const auto v = random_ints(state.range(0));
+    for (auto _ : state) {
+        PQ pq;
+        for (int x : v) pq.push(x);
+        long long sum = 0;
+        while (!pq.empty()) {
+            sum += pq.top();
+            pq.pop();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//построение из диапазона
+template <typename PQ>
+void BM_PQHeapify(benchmark::State& state)
+{
+    const auto v = random_ints(state.range(0));
+    for (auto _ : state) {
+        PQ pq(v.begin(), v.end());
+        benchmark::DoNotOptimize(pq.top());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//первые 1000 наименьших из потока: вершина - наибольший из лучших, замена за один спуск
+template <typename PQ>
+void BM_PQTopK(benchmark::State& state)
+{
+    const auto v = random_ints(state.range(0));
+    for (auto _ : state) {
+        PQ pq(v.begin(), v.begin() + 1000);
+        for (std::size_t i = 1000; i < v.size(); ++i) {
+            if (v[i] < pq.top()) {
+                pq.pop();
+                pq.push(v[i]);
+            }
+        }
+        benchmark::DoNotOptimize(pq.top());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//адаптер: у fwd-контейнера вершина - get_front, pop возвращает значение
+template <std::size_t D>
+struct fwd_pq : priority_queue<int, std::less<int>, D> {
+    using base = priority_queue<int, std::less<int>, D>;
+    using base::base;
+    int top() const { return this->get_front(); }
+};
+
+//то же через replace_top вместо pop + push
+template <std::size_t D>
+void BM_PQTopKReplace(benchmark::State& state)
+{
+    const auto v = random_ints(state.range(0));
+    for (auto _ : state) {
+        priority_queue<int, std::less<int>, D> pq(v.begin(), v.begin() + 1000);
+        for (std::size_t i = 1000; i < v.size(); ++i)
+            if (v[i] < pq.get_front()) pq.replace_top(v[i]);
+        benchmark::DoNotOptimize(pq.get_front());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}
+
+#define FWD_PQ(BM) \
+    BENCHMARK_TEMPLATE(BM, std::priority_queue<int>)->RangeMultiplier(16)->Range(4096, 1 << 20); \
+    BENCHMARK_TEMPLATE(BM, fwd_pq<2>)->RangeMultiplier(16)->Range(4096, 1 << 20); \
+    BENCHMARK_TEMPLATE(BM, fwd_pq<4>)->RangeMultiplier(16)->Range(4096, 1 << 20); \
+    BENCHMARK_TEMPLATE(BM, fwd_pq<8>)->RangeMultiplier(16)->Range(4096, 1 << 20)
+
+FWD_PQ(BM_PQPushPop);
+FWD_PQ(BM_PQHeapify);
+FWD_PQ(BM_PQTopK);
+BENCHMARK_TEMPLATE(BM_PQTopKReplace, 4)->RangeMultiplier(16)->Range(4096, 1 << 20);
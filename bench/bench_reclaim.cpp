@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../queue.h"
+#include "../node_reclaimer.h"
+
+//задержка разрушения большого контейнера в вызывающем потоке:
+//обычный queue обходит и удаляет все узлы, deferred_policy отдаёт цепочку уборщику
+//в счётчиках p50/p99/max - время одного разрушения, мкс; на одном ядре уборщик вытесняет
+//вызывающий поток, и настенное время включает его работу - смотреть CPU
+
+namespace {
+
+template <typename C>
+void BM_Destroy(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    std::vector<double> us;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto c = std::make_unique<C>();
+        for (int i = 0; i < n; ++i) c->push(std::string(32, 'a' + i % 26));
+        node_reclaimer::instance().flush();         //уборщик не мешает заполнению
+        state.ResumeTiming();
+
+        auto t0 = std::chrono::steady_clock::now();
+        c.reset();
+        auto t1 = std::chrono::steady_clock::now();
+        us.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+
+        state.PauseTiming();
+        node_reclaimer::instance().flush();
+        state.ResumeTiming();
+    }
+    std::sort(us.begin(), us.end());
+    state.counters["p50_us"] = us[us.size() / 2];
+    state.counters["p99_us"] = us[us.size() * 99 / 100];
+    state.counters["max_us"] = us.back();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}
+
+BENCHMARK_TEMPLATE(BM_Destroy, queue<std::string>)->RangeMultiplier(10)->Range(1000, 1000000)->Iterations(100)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Destroy, queue<std::string, deferred_policy>)->RangeMultiplier(10)->Range(1000, 1000000)->Iterations(100)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <numeric>
+#include "../stack.h"
+#include "../queue.h"
+#include "../simd_algorithms.h"
+
+//std::find/count/accumulate/min_element через итераторы fwd_container
+//против fwd_* над порциями с векторными ядрами
+
+namespace {
+
+template <typename C>
+C filled(int n)
+{
+    C c;
+    for (int i = 0; i < n; ++i) c.push(static_cast<typename C::const_iterator::value_type>(i % 1000));
+    return c;
+}
+
+template <typename C>
+void BM_IterSum(benchmark::State& state)
+{
+    const C c = filled<C>(static_cast<int>(state.range(0)));
+    using T = typename C::const_iterator::value_type;
+    for (auto _ : state) benchmark::DoNotOptimize(std::accumulate(c.cbegin(), c.cend(), sum_type_t<T>(0)));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename C>
+void BM_SimdSum(benchmark::State& state)
+{
+    const C c = filled<C>(static_cast<int>(state.range(0)));
+    for (auto _ : state) benchmark::DoNotOptimize(fwd_sum(c));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//искомого нет: проход до конца
+template <typename C>
+void BM_IterFind(benchmark::State& state)
+{
+    const C c = filled<C>(static_cast<int>(state.range(0)));
+    using T = typename C::const_iterator::value_type;
+    for (auto _ : state) benchmark::DoNotOptimize(std::find(c.cbegin(), c.cend(), T(-1)) == c.cend());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename C>
+void BM_SimdFind(benchmark::State& state)
+{
+    const C c = filled<C>(static_cast<int>(state.range(0)));
+    using T = typename C::const_iterator::value_type;
+    for (auto _ : state) benchmark::DoNotOptimize(fwd_find(c, T(-1)));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename C>
+void BM_IterCount(benchmark::State& state)
+{
+    const C c = filled<C>(static_cast<int>(state.range(0)));
+    using T = typename C::const_iterator::value_type;
+    for (auto _ : state) benchmark::DoNotOptimize(std::count(c.cbegin(), c.cend(), T(7)));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename C>
+void BM_SimdCount(benchmark::State& state)
+{
+    const C c = filled<C>(static_cast<int>(state.range(0)));
+    using T = typename C::const_iterator::value_type;
+    for (auto _ : state) benchmark::DoNotOptimize(fwd_count(c, T(7)));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename C>
+void BM_IterMin(benchmark::State& state)
+{
+    const C c = filled<C>(static_cast<int>(state.range(0)));
+    for (auto _ : state) benchmark::DoNotOptimize(*std::min_element(c.cbegin(), c.cend()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename C>
+void BM_SimdMin(benchmark::State& state)
+{
+    const C c = filled<C>(static_cast<int>(state.range(0)));
+    for (auto _ : state) benchmark::DoNotOptimize(fwd_min(c));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}
+
+#define FWD_SIMD(BM) \
+    BENCHMARK_TEMPLATE(BM, queue<int>)->RangeMultiplier(32)->Range(1024, 1 << 20); \
+    BENCHMARK_TEMPLATE(BM, stack<double>)->RangeMultiplier(32)->Range(1024, 1 << 20)
+
+FWD_SIMD(BM_IterSum);
+FWD_SIMD(BM_SimdSum);
+FWD_SIMD(BM_IterFind);
+FWD_SIMD(BM_SimdFind);
+FWD_SIMD(BM_IterCount);
+FWD_SIMD(BM_SimdCount);
+FWD_SIMD(BM_IterMin);
+FWD_SIMD(BM_SimdMin);
@@ -0,0 +1,46 @@
+#include <benchmark/benchmark.h>
+#include "../stack.h"
+#include "../small_stack.h"
+
+//короткоживущие стеки разборщика и обхода в глубину: создать, набрать depth элементов, разобрать
+//аргумент - глубина; small_stack<int, 16> на глубине больше 16 уходит в кучу
+
+template <typename S>
+static void BM_ScratchStack(benchmark::State& state)
+{
+    const int depth = static_cast<int>(state.range(0));
+    long long sum = 0;
+    for (auto _ : state) {
+        S s;
+        for (int i = 0; i < depth; ++i) s.push(i);
+        while (!s.is_empty()) sum += s.pop();
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * depth);
+}
+
+//обход в глубину: стек то растёт, то опускается, не опустошаясь полностью
+template <typename S>
+static void BM_DfsPattern(benchmark::State& state)
+{
+    const int depth = static_cast<int>(state.range(0));
+    long long sum = 0;
+    for (auto _ : state) {
+        S s;
+        s.push(0);
+        for (int i = 1; i < depth * 4; ++i) {
+            if (s.size() < static_cast<std::size_t>(depth) && (i % 3 != 0)) s.push(i);
+            else sum += s.pop();
+            if (s.is_empty()) s.push(i);
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * depth * 4);
+}
+
+BENCHMARK_TEMPLATE(BM_ScratchStack, stack<int>)->RangeMultiplier(2)->Range(4, 64);
+BENCHMARK_TEMPLATE(BM_ScratchStack, small_stack<int, 16>)->RangeMultiplier(2)->Range(4, 64);
+BENCHMARK_TEMPLATE(BM_ScratchStack, small_stack<int, 64>)->RangeMultiplier(2)->Range(4, 64);
+BENCHMARK_TEMPLATE(BM_DfsPattern, stack<int>)->RangeMultiplier(4)->Range(4, 64);
+BENCHMARK_TEMPLATE(BM_DfsPattern, small_stack<int, 16>)->RangeMultiplier(4)->Range(4, 64);
+BENCHMARK_TEMPLATE(BM_DfsPattern, small_stack<int, 64>)->RangeMultiplier(4)->Range(4, 64);
@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "../queue.h"
+
+//queue::sort перестановкой узлов против копирования в vector, std::sort и обратно
+//аргумент - число элементов; 100M int в узлах - около 3 ГБ, на маленькой машине запускать с --benchmark_filter
+
+namespace {
+
+void fill(queue<int>& q, std::size_t n)
+{
+    std::mt19937 rng(42);
+    for (std::size_t i = 0; i < n; ++i) q.push(static_cast<int>(rng()));
+}
+
+//поразрядная: целые и std::less
+void BM_QueueRadixSort(benchmark::State& state)
+{
+    queue<int> q;
+    for (auto _ : state) {
+        state.PauseTiming();
+        q = queue<int>();
+        fill(q, state.range(0));
+        state.ResumeTiming();
+        q.sort();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//слияние: компаратор не std::less, поэтому без поразрядной
+void BM_QueueMergeSort(benchmark::State& state)
+{
+    queue<int> q;
+    for (auto _ : state) {
+        state.PauseTiming();
+        q = queue<int>();
+        fill(q, state.range(0));
+        state.ResumeTiming();
+        q.sort([](int a, int b) { return a < b; });
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//как раньше: всё в vector, std::sort, очередь заново; память вдвое
+void BM_QueueVectorSort(benchmark::State& state)
+{
+    queue<int> q;
+    for (auto _ : state) {
+        state.PauseTiming();
+        q = queue<int>();
+        fill(q, state.range(0));
+        state.ResumeTiming();
+        std::vector<int> v(q.cbegin(), q.cend());
+        std::sort(v.begin(), v.end());
+        q = queue<int>();
+        for (int x : v) q.push(x);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}
+
+BENCHMARK(BM_QueueRadixSort)->Arg(1 << 20)->Arg(10000000)->Arg(100000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_QueueMergeSort)->Arg(1 << 20)->Arg(10000000)->Arg(100000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_QueueVectorSort)->Arg(1 << 20)->Arg(10000000)->Arg(100000000)->Unit(benchmark::kMillisecond);
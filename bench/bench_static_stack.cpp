@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+#include "../stack.h"
+#include "../static_stack.h"
+
+//static_stack<T, N> против stack<T>: те же операции без кучи и виртуальных вызовов
+//аргумент - глубина стека
+
+//создать, набрать depth элементов, разобрать
+template <typename S>
+static void BM_StaticPushPop(benchmark::State& state)
+{
+    const int depth = static_cast<int>(state.range(0));
+    long long sum = 0;
+    for (auto _ : state) {
+        S s;
+        for (int i = 0; i < depth; ++i) s.push(i);
+        while (!s.is_empty()) sum += s.pop();
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * depth);
+}
+
+//обход заполненного стека
+template <typename S>
+static void BM_StaticIterate(benchmark::State& state)
+{
+    const int depth = static_cast<int>(state.range(0));
+    S s;
+    for (int i = 0; i < depth; ++i) s.push(i);
+    for (auto _ : state) {
+        long long sum = 0;
+        for (int v : s) sum += v;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * depth);
+}
+
+//обратная польская запись: стек во время выполнения, а не компиляции
+template <typename S>
+static void BM_StaticRpn(benchmark::State& state)
+{
+    const char* expr = "1 2 + 3 4 + * 5 6 + 7 8 + * - 9 *";
+    long long sum = 0;
+    for (auto _ : state) {
+        S s;
+        for (const char* e = expr; *e; ++e) {
+            if (*e >= '0' && *e <= '9') { s.push(*e - '0'); continue; }
+            if (*e == ' ') continue;
+            int b = s.pop(), a = s.pop();
+            s.push(*e == '+' ? a + b : *e == '-' ? a - b : a * b);
+        }
+        sum += s.pop();
+        benchmark::DoNotOptimize(expr);
+    }
+    benchmark::DoNotOptimize(sum);
+}
+
+BENCHMARK_TEMPLATE(BM_StaticPushPop, stack<int>)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK_TEMPLATE(BM_StaticPushPop, static_stack<int, 1024>)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK_TEMPLATE(BM_StaticIterate, stack<int>)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK_TEMPLATE(BM_StaticIterate, static_stack<int, 1024>)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK_TEMPLATE(BM_StaticRpn, stack<int>);
+BENCHMARK_TEMPLATE(BM_StaticRpn, static_stack<int, 16>);
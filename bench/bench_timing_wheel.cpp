@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+#include "../timing_wheel.h"
+#include "../priority_queue.h"
+
+//жизненный цикл N таймеров: постановка со случайной задержкой до 2^20 тактов, отмена каждого
+//второго, прокрутка до срабатывания остальных
+//timing_wheel против кучи priority_queue<(срок, ячейка)> с отменой через таблицу поколений
+//в счётчиках - нс на таймер для каждой фазы
+
+namespace {
+
+constexpr std::uint64_t horizon = 1 << 20;
+
+std::vector<std::uint64_t> delays(std::size_t n)
+{
+    std::mt19937_64 rng(11);
+    std::vector<std::uint64_t> v(n);
+    for (auto& x : v) x = 1 + rng() % horizon;
+    return v;
+}
+
+double ns_since(std::chrono::steady_clock::time_point t0, std::size_t n)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / n;
+}
+
+template <typename Policy>
+void BM_TimersWheel(benchmark::State& state)
+{
+    const auto d = delays(state.range(0));
+    double sched = 0, canc = 0, exp = 0;
+    for (auto _ : state) {
+        timing_wheel<int, Policy> w;
+        std::vector<timer_handle> h(d.size());
+        auto t0 = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < d.size(); ++i) h[i] = w.schedule(d[i], static_cast<int>(i));
+        sched += ns_since(t0, d.size());
+
+        t0 = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < d.size(); i += 2) w.cancel(h[i]);
+        canc += ns_since(t0, d.size() / 2);
+
+        t0 = std::chrono::steady_clock::now();
+        long long sum = 0;
+        w.advance(horizon, [&](int v) { sum += v; });
+        benchmark::DoNotOptimize(sum);
+        exp += ns_since(t0, d.size() - d.size() / 2);
+    }
+    state.counters["schedule_ns"] = sched / state.iterations();
+    state.counters["cancel_ns"] = canc / state.iterations();
+    state.counters["expire_ns"] = exp / state.iterations();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_TimersHeap(benchmark::State& state)
+{
+    using item = std::pair<std::uint64_t, std::uint32_t>;      //срок, ячейка
+    const auto d = delays(state.range(0));
+    double sched = 0, canc = 0, exp = 0;
+    for (auto _ : state) {
+        priority_queue<item, std::greater<item>> pq;
+        std::vector<bool> dead(d.size());
+        auto t0 = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < d.size(); ++i) pq.push(item{d[i], static_cast<std::uint32_t>(i)});
+        sched += ns_since(t0, d.size());
+
+        t0 = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < d.size(); i += 2) dead[i] = true;
+        canc += ns_since(t0, d.size() / 2);
+
+        t0 = std::chrono::steady_clock::now();
+        long long sum = 0;
+        for (std::uint64_t now = 1; now <= horizon; ++now)
+            while (!pq.is_empty() && pq.get_front().first <= now) {
+                item e = pq.pop();
+                if (!dead[e.second]) sum += e.second;
+            }
+        benchmark::DoNotOptimize(sum);
+        exp += ns_since(t0, d.size() - d.size() / 2);
+    }
+    state.counters["schedule_ns"] = sched / state.iterations();
+    state.counters["cancel_ns"] = canc / state.iterations();
+    state.counters["expire_ns"] = exp / state.iterations();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}
+
+BENCHMARK_TEMPLATE(BM_TimersWheel, default_policy)->Arg(1000000)->Arg(10000000)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_TimersWheel, prefetch_policy)->Arg(1000000)->Arg(10000000)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TimersHeap)->Arg(1000000)->Arg(10000000)->Iterations(1)->Unit(benchmark::kMillisecond);
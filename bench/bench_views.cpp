@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <ranges>
+#include <vector>
+#include "../queue.h"
+#include "../list_view.h"
+
+//конвейер filter | transform по queue<int> из 1M элементов, аргумент - сколько результатов взять (take)
+//копия в vector и обработка копии против ленивых std::views по q.view() и по полиморфным итераторам
+
+namespace {
+
+constexpr int n_items = 1 << 20;
+
+const queue<int>& source()
+{
+    static const queue<int> q = [] {
+        queue<int> r;
+        for (int i = 0; i < n_items; ++i) r.push(i * 7 % 1000);
+        return r;
+    }();
+    return q;
+}
+
+bool keep(int x) { return x % 3 != 0; }
+long long square(int x) { return 1LL * x * x; }
+
+void BM_ViewsCopyThenTransform(benchmark::State& state)
+{
+    const auto& q = source();
+    const auto take = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        std::vector<int> v(q.cbegin(), q.cend());
+        std::vector<long long> out;
+        for (int x : v) {
+            if (out.size() == take) break;
+            if (keep(x)) out.push_back(square(x));
+        }
+        long long sum = 0;
+        for (long long y : out) sum += y;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <bool Light>
+void BM_ViewsLazy(benchmark::State& state)
+{
+    const auto& q = source();
+    const auto take = state.range(0);
+    for (auto _ : state) {
+        long long sum = 0;
+        if constexpr (Light) {
+            for (long long y : q.view() | std::views::filter(keep) | std::views::transform(square) | std::views::take(take)) sum += y;
+        } else {
+            for (long long y : q | std::views::filter(keep) | std::views::transform(square) | std::views::take(take)) sum += y;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}
+
+BENCHMARK(BM_ViewsCopyThenTransform)->RangeMultiplier(32)->Range(1024, 1 << 19);
+BENCHMARK_TEMPLATE(BM_ViewsLazy, true)->RangeMultiplier(32)->Range(1024, 1 << 19);
+BENCHMARK_TEMPLATE(BM_ViewsLazy, false)->RangeMultiplier(32)->Range(1024, 1 << 19);
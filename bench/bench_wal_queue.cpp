@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include "../wal_queue.h"
+
+//пропускная способность push при разных окнах группового коммита
+//аргумент - окно в микросекундах, потоки - одновременные писатели
+
+static std::unique_ptr<wal_queue<long long>> g_wal;
+
+static void BM_WalPush(benchmark::State& state)
+{
+    auto dir = std::filesystem::temp_directory_path() / "fwd_wal_bench";
+    if (state.thread_index() == 0) {
+        std::filesystem::remove_all(dir);
+        wal_options opt;
+        opt.group_commit_window = std::chrono::microseconds(state.range(0));
+        g_wal.reset(new wal_queue<long long>(dir.string(), opt));
+    }
+
+    long long v = 0;
+    for (auto _ : state) g_wal->push(v++);
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        g_wal.reset();
+        std::filesystem::remove_all(dir);
+    }
+}
+BENCHMARK(BM_WalPush)
+    ->ArgName("window_us")->Arg(0)->Arg(50)->Arg(200)->Arg(1000)
+    ->Threads(1)->Threads(4)->Threads(16)
+    ->UseRealTime();
+
+//один писатель: каждый push платит за собственный fsync, разные размеры записи
+static void BM_WalPushSingleWriter(benchmark::State& state)
+{
+    auto dir = std::filesystem::temp_directory_path() / "fwd_wal_bench_single";
+    std::filesystem::remove_all(dir);
+    {
+        wal_queue<std::string> q(dir.string());
+        std::string payload(static_cast<std::size_t>(state.range(0)), 'x');
+        for (auto _ : state) q.push(payload);
+        state.SetItemsProcessed(state.iterations());
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+    std::filesystem::remove_all(dir);
+}
+BENCHMARK(BM_WalPushSingleWriter)->ArgName("payload")->Arg(16)->Arg(1024);
@@ -0,0 +1,112 @@
+#ifndef COMPRESSED_QUEUE_H
+#define COMPRESSED_QUEUE_H
+
+#include "memory_usage.h"
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+//очередь целых чисел, сжатая блоками: первое значение блока хранится как есть,
+//остальные - разностью с предыдущим в zigzag + varint
+//элементы нельзя менять на месте, поэтому наследника fwd_container здесь нет:
+//только чтение через const_iterator и get_front() по константной ссылке
+template <typename T>
+class compressed_queue {
+    static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value,
+                  "compressed_queue только для целых типов");
+
+    using U = typename std::make_unsigned<T>::type;
+    using S = typename std::make_signed<T>::type;
+
+    //максимальная длина varint для U
+    static constexpr std::size_t max_varint = (sizeof(U) * 8 + 6) / 7;
+
+    //блок данных: около килобайта вместе с заголовком
+    struct Block {
+        static constexpr std::size_t capacity = 1000;   //байт под разности
+        Block* next;
+        std::uint32_t count;        //сколько значений в блоке (включая base)
+        std::uint32_t used;         //сколько байт data занято
+        T base;                     //первое значение блока
+        unsigned char data[capacity];
+        explicit Block(T v): next(nullptr), count(1), used(0), base(v) {}
+    };
+
+    Block* front_;              //блок, из которого читаем
+    Block* back_;               //блок, в который пишем
+    std::size_t sz_;            //количество элементов
+    T last_;                    //последнее добавленное значение (от него считаем разность)
+    T head_;                    //раскодированный первый элемент
+    std::uint32_t rd_off_;      //смещение чтения в front_->data
+    std::uint32_t rd_idx_;      //номер первого элемента внутри front_
+    std::size_t blocks_;        //количество блоков
+
+public:
+    // константный итератор: раскодирует значения по одному
+    class const_iterator {
+        const Block* blk;
+        std::uint32_t off;
+        std::uint32_t idx;
+        T val;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator();                                                   //итератор end()
+        const_iterator(const Block* b, std::uint32_t o, std::uint32_t i, T v);
+
+        reference operator*() const;
+        pointer operator->() const;
+        const_iterator& operator++();
+        const_iterator operator++(int);
+
+        bool operator==(const const_iterator& o) const;
+        bool operator!=(const const_iterator& o) const;
+    };
+    using iterator = const_iterator;
+
+    // конструкторы
+    compressed_queue();                                         //пустая очередь
+    ~compressed_queue();
+    compressed_queue(const compressed_queue& o);                //копия блоков целиком, без перекодирования
+    compressed_queue(compressed_queue&& o) noexcept;
+    compressed_queue& operator=(const compressed_queue& o);
+    compressed_queue& operator=(compressed_queue&& o) noexcept;
+
+    void push(T v);                     //добавление в конец
+    T pop();                            //извлечение из начала
+    const T& get_front() const;         //первый элемент
+
+    bool is_empty() const;
+    bool empty() const { return is_empty(); }
+    std::size_t size() const;
+    std::size_t memory_usage() const;   //байт, занятых блоками и самим объектом
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+
+    void clear();                       //удаление всех блоков
+
+private:
+    void copy_from(const compressed_queue& o);
+    static U zigzag(U d);
+    static U unzigzag(U z);
+    static std::uint32_t put_varint(unsigned char* p, U v);
+    static std::uint32_t get_varint(const unsigned char* p, U& v);
+};
+
+//вывод
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const compressed_queue<T>& c);
+
+#include "compressed_queue_impl.h"
+
+#endif
@@ -0,0 +1,295 @@
+#ifndef COMPRESSED_QUEUE_IMPL_H
+#define COMPRESSED_QUEUE_IMPL_H
+
+//кодирование
+
+//zigzag: маленькие по модулю разности любого знака дают маленькие числа
+template <typename T>
+typename compressed_queue<T>::U compressed_queue<T>::zigzag(U d) {
+    return static_cast<U>(static_cast<U>(d << 1) ^ static_cast<U>(U(0) - static_cast<U>(d >> (sizeof(U) * 8 - 1))));
+}
+
+//обратное преобразование
+template <typename T>
+typename compressed_queue<T>::U compressed_queue<T>::unzigzag(U z) {
+    return static_cast<U>(static_cast<U>(z >> 1) ^ static_cast<U>(U(0) - static_cast<U>(z & 1)));
+}
+
+//varint: по 7 бит в байте, старший бит - "дальше есть ещё"
+template <typename T>
+std::uint32_t compressed_queue<T>::put_varint(unsigned char* p, U v) {
+    std::uint32_t n = 0;
+    while (v >= 0x80) {
+        p[n++] = static_cast<unsigned char>((v & 0x7F) | 0x80);
+        v = static_cast<U>(v >> 7);
+    }
+    p[n++] = static_cast<unsigned char>(v);
+    return n;
+}
+
+//чтение varint, возвращает количество байт
+template <typename T>
+std::uint32_t compressed_queue<T>::get_varint(const unsigned char* p, U& v) {
+    v = 0;
+    std::uint32_t n = 0;
+    unsigned shift = 0;
+    while (p[n] & 0x80) {
+        v = static_cast<U>(v | (static_cast<U>(p[n++] & 0x7F) << shift));
+        shift += 7;
+    }
+    v = static_cast<U>(v | (static_cast<U>(p[n++]) << shift));
+    return n;
+}
+
+//реализация const_iterator
+
+//итератор end()
+template <typename T>
+compressed_queue<T>::const_iterator::const_iterator(): blk(nullptr), off(0), idx(0), val() {}
+
+//итератор на элемент idx блока b, val - уже раскодированное значение
+template <typename T>
+compressed_queue<T>::const_iterator::const_iterator(const Block* b, std::uint32_t o, std::uint32_t i, T v)
+    : blk(b), off(o), idx(i), val(v) {}
+
+//разыменование
+template <typename T>
+typename compressed_queue<T>::const_iterator::reference
+compressed_queue<T>::const_iterator::operator*() const { return val; }
+
+//доступ к значению
+template <typename T>
+typename compressed_queue<T>::const_iterator::pointer
+compressed_queue<T>::const_iterator::operator->() const { return &val; }
+
+//шаг вперёд: следующая разность или переход в следующий блок
+template <typename T>
+typename compressed_queue<T>::const_iterator&
+compressed_queue<T>::const_iterator::operator++() {
+    if (!blk) return *this;
+    if (idx + 1 < blk->count) {
+        U z;
+        off += get_varint(blk->data + off, z);
+        val = static_cast<T>(static_cast<U>(static_cast<U>(val) + unzigzag(z)));
+        ++idx;
+    } else {
+        blk = blk->next;
+        off = 0;
+        idx = 0;
+        if (blk) val = blk->base;
+    }
+    return *this;
+}
+
+//постфиксный шаг
+template <typename T>
+typename compressed_queue<T>::const_iterator
+compressed_queue<T>::const_iterator::operator++(int) {
+    const_iterator t(*this);
+    ++(*this);
+    return t;
+}
+
+//сравнение по позиции
+template <typename T>
+bool compressed_queue<T>::const_iterator::operator==(const const_iterator& o) const {
+    return blk == o.blk && idx == o.idx;
+}
+
+template <typename T>
+bool compressed_queue<T>::const_iterator::operator!=(const const_iterator& o) const {
+    return !(*this == o);
+}
+
+//реализация конструкторов и присваиваний
+
+//пустая очередь
+template <typename T>
+compressed_queue<T>::compressed_queue()
+    : front_(nullptr), back_(nullptr), sz_(0), last_(), head_(), rd_off_(0), rd_idx_(0), blocks_(0) {}
+
+//деструктор
+template <typename T>
+compressed_queue<T>::~compressed_queue() { clear(); }
+
+//копирующий конструктор
+template <typename T>
+compressed_queue<T>::compressed_queue(const compressed_queue& o)
+    : front_(nullptr), back_(nullptr), sz_(0), last_(), head_(), rd_off_(0), rd_idx_(0), blocks_(0) {
+    copy_from(o);
+}
+
+//перемещающий конструктор
+template <typename T>
+compressed_queue<T>::compressed_queue(compressed_queue&& o) noexcept
+    : front_(o.front_), back_(o.back_), sz_(o.sz_), last_(o.last_), head_(o.head_),
+      rd_off_(o.rd_off_), rd_idx_(o.rd_idx_), blocks_(o.blocks_) {
+    o.front_ = o.back_ = nullptr;
+    o.sz_ = 0;
+    o.blocks_ = 0;
+}
+
+//копирующее присваивание
+template <typename T>
+compressed_queue<T>& compressed_queue<T>::operator=(const compressed_queue& o) {
+    if (this != &o) {
+        clear();
+        copy_from(o);
+    }
+    return *this;
+}
+
+//перемещающее присваивание
+template <typename T>
+compressed_queue<T>& compressed_queue<T>::operator=(compressed_queue&& o) noexcept {
+    if (this != &o) {
+        clear();
+        front_ = o.front_;
+        back_ = o.back_;
+        sz_ = o.sz_;
+        last_ = o.last_;
+        head_ = o.head_;
+        rd_off_ = o.rd_off_;
+        rd_idx_ = o.rd_idx_;
+        blocks_ = o.blocks_;
+        o.front_ = o.back_ = nullptr;
+        o.sz_ = 0;
+        o.blocks_ = 0;
+    }
+    return *this;
+}
+
+//реализация операций
+
+//добавление: разность с последним значением в текущий блок или новый блок
+template <typename T>
+void compressed_queue<T>::push(T v) {
+    if (!back_) {
+        front_ = back_ = new Block(v);
+        head_ = v;
+        rd_off_ = rd_idx_ = 0;
+        blocks_ = 1;
+    } else if (back_->used + max_varint > Block::capacity) {
+        Block* b = new Block(v);
+        back_->next = b;
+        back_ = b;
+        ++blocks_;
+    } else {
+        U d = static_cast<U>(static_cast<U>(v) - static_cast<U>(last_));
+        back_->used += put_varint(back_->data + back_->used, zigzag(d));
+        ++back_->count;
+    }
+    last_ = v;
+    ++sz_;
+}
+
+//извлечение: отдаём head_ и раскодируем следующий
+template <typename T>
+T compressed_queue<T>::pop() {
+    if (is_empty()) throw std::runtime_error("compressed_queue empty");
+    T v = head_;
+    if (rd_idx_ + 1 < front_->count) {
+        U z;
+        rd_off_ += get_varint(front_->data + rd_off_, z);
+        head_ = static_cast<T>(static_cast<U>(static_cast<U>(head_) + unzigzag(z)));
+        ++rd_idx_;
+    } else {
+        Block* t = front_;
+        front_ = front_->next;
+        delete t;
+        --blocks_;
+        rd_off_ = rd_idx_ = 0;
+        if (front_) head_ = front_->base;
+        else back_ = nullptr;
+    }
+    --sz_;
+    return v;
+}
+
+//первый элемент
+template <typename T>
+const T& compressed_queue<T>::get_front() const {
+    if (is_empty()) throw std::runtime_error("compressed_queue empty");
+    return head_;
+}
+
+//пустота
+template <typename T>
+bool compressed_queue<T>::is_empty() const { return front_ == nullptr; }
+
+//размер
+template <typename T>
+std::size_t compressed_queue<T>::size() const { return sz_; }
+
+//память: блоки целиком с заголовками malloc плюс сам объект
+template <typename T>
+std::size_t compressed_queue<T>::memory_usage() const {
+    return sizeof(*this) + blocks_ * heap_block_bytes(sizeof(Block));
+}
+
+//итераторы
+
+template <typename T>
+typename compressed_queue<T>::const_iterator compressed_queue<T>::begin() const {
+    if (!front_) return const_iterator();
+    return const_iterator(front_, rd_off_, rd_idx_, head_);
+}
+
+template <typename T>
+typename compressed_queue<T>::const_iterator compressed_queue<T>::end() const {
+    return const_iterator();
+}
+
+template <typename T>
+typename compressed_queue<T>::const_iterator compressed_queue<T>::cbegin() const { return begin(); }
+
+template <typename T>
+typename compressed_queue<T>::const_iterator compressed_queue<T>::cend() const { return end(); }
+
+//вспомогательные методы
+
+//удаление всех блоков
+template <typename T>
+void compressed_queue<T>::clear() {
+    while (front_) {
+        Block* t = front_;
+        front_ = front_->next;
+        delete t;
+    }
+    back_ = nullptr;
+    sz_ = 0;
+    blocks_ = 0;
+    rd_off_ = rd_idx_ = 0;
+}
+
+//копирование блоков побайтно, перекодировать ничего не нужно
+template <typename T>
+void compressed_queue<T>::copy_from(const compressed_queue& o) {
+    for (const Block* b = o.front_; b; b = b->next) {
+        Block* n = new Block(*b);
+        n->next = nullptr;
+        if (back_) back_->next = n;
+        else front_ = n;
+        back_ = n;
+    }
+    sz_ = o.sz_;
+    last_ = o.last_;
+    head_ = o.head_;
+    rd_off_ = o.rd_off_;
+    rd_idx_ = o.rd_idx_;
+    blocks_ = o.blocks_;
+}
+
+//вывод
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const compressed_queue<T>& c) {
+    bool first = true;
+    for (auto it = c.cbegin(); it != c.cend(); ++it) {
+        if (!first) os << ' ';
+        os << +*it;                 //+ чтобы char-типы печатались числом
+        first = false;
+    }
+    return os;
+}
+
+#endif
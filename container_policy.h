@@ -0,0 +1,76 @@
+#ifndef CONTAINER_POLICY_H
+#define CONTAINER_POLICY_H
+
+#include "container_stats.h"
+#include "node_storage.h"
+#include <cstddef>
+
+//политика stack<T, Policy> и queue<T, Policy>: набор настроек времени компиляции
+//свою политику удобно наследовать от default_policy и переопределять только нужное:
+//  struct my_policy : default_policy { using stats = counted_stats<my_tag>; };
+struct default_policy {
+    using stats = no_stats;                         //статистика выключена
+    static constexpr bool prefetch = false;         //при обходе заранее подгружать следующий узел
+    static constexpr std::size_t node_align = 0;    //выравнивание узла, 0 - обычное для T
+    template <typename Node>
+    using node_storage = heap_node_storage<Node>;   //откуда берутся узлы
+};
+
+//размер строки кэша, под который подбирается узел
+constexpr std::size_t cache_line_size = 64;
+
+//node_align = node_align_line: узел выравнивается на степень двойки не меньше своего размера
+//(но не больше строки кэша), тогда узел до 64 байт никогда не лежит в двух строках
+constexpr std::size_t node_align_line = std::size_t(-1);
+
+//выравнивание узла {next, T} для заданного node_align
+template <typename T>
+constexpr std::size_t node_alignment(std::size_t requested) {
+    std::size_t natural = alignof(T) > alignof(void*) ? alignof(T) : alignof(void*);
+    if(requested == 0) return natural;
+    if(requested != node_align_line) return requested > natural ? requested : natural;
+    std::size_t size = (sizeof(void*) + sizeof(T) + natural - 1) / natural * natural;
+    std::size_t a = natural;
+    while(a < size && a < cache_line_size) a *= 2;
+    return a;
+}
+
+//узел и хранилище узлов контейнера с политикой Policy
+template <typename T, typename Policy>
+using list_node_t = list_node<T, node_alignment<T>(Policy::node_align)>;
+
+template <typename T, typename Policy>
+using node_storage_t = typename Policy::template node_storage<list_node_t<T, Policy>>;
+
+//подсказка процессору: скоро будем читать p
+inline void prefetch_read(const void* p) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p, 0, 3);
+#else
+    (void)p;
+#endif
+}
+
+//счётчики в общей записи реестра "fwd"
+struct counted_policy : default_policy {
+    using stats = counted_stats<>;
+};
+
+//для длинных списков, которые не помещаются в кэш: предвыборка при обходе
+struct prefetch_policy : default_policy {
+    static constexpr bool prefetch = true;
+};
+
+//предвыборка и узлы по строкам кэша
+//выровненный new в glibc идёт через memalign: узлы дороже и толще, см. bench/bench_layout.cpp
+struct cache_line_policy : prefetch_policy {
+    static constexpr std::size_t node_align = node_align_line;
+};
+
+//узлы из блоков: clear() и деструктор за O(блоков), только для T с тривиальным деструктором
+struct arena_policy : default_policy {
+    template <typename Node>
+    using node_storage = arena_node_storage<Node>;
+};
+
+#endif
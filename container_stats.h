@@ -0,0 +1,90 @@
+#ifndef CONTAINER_STATS_H
+#define CONTAINER_STATS_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+//счётчики одного вида контейнеров; обновляются relaxed-атомиками, читать можно из любого потока
+struct container_stats {
+    std::atomic<std::uint64_t> pushes{0};          //push
+    std::atomic<std::uint64_t> pops{0};            //pop
+    std::atomic<std::uint64_t> node_allocs{0};     //выделено узлов
+    std::atomic<std::uint64_t> node_frees{0};      //освобождено узлов
+    std::atomic<std::uint64_t> iter_allocs{0};     //итераторы в куче: begin/end и clone/make_const
+    std::atomic<std::uint64_t> copies{0};          //копирующие конструкторы
+    std::atomic<std::uint64_t> assigns{0};         //копирующие присваивания, в том числе через базу
+    std::atomic<std::uint64_t> max_size{0};        //наибольший размер одного контейнера
+
+    void reset();
+    void note_size(std::size_t n);                 //обновить max_size
+};
+
+//вывод одной записи в одну строку
+std::ostream& operator<<(std::ostream& os, const container_stats& s);
+
+//глобальный реестр: имя -> счётчики; записи живут до конца программы
+class stats_registry {
+    mutable std::mutex m_;
+    std::map<std::string, std::unique_ptr<container_stats>> entries_;
+
+    stats_registry() = default;
+
+public:
+    stats_registry(const stats_registry&) = delete;
+    stats_registry& operator=(const stats_registry&) = delete;
+
+    static stats_registry& instance();
+
+    container_stats& get(const std::string& name);          //создаёт запись при первом обращении
+    const container_stats* find(const std::string& name) const;
+    void dump(std::ostream& os) const;                      //все записи, по строке на имя
+    void reset();                                           //обнулить все счётчики
+};
+
+//политики статистики: контейнер вызывает статические хуки, у no_stats они пустые и исчезают при inline
+
+//без статистики (по умолчанию)
+struct no_stats {
+    static constexpr bool enabled = false;
+
+    static void on_push(std::size_t = 1) {}
+    static void on_pop(std::size_t = 1) {}
+    static void on_node_alloc(std::size_t = 1) {}
+    static void on_node_free(std::size_t = 1) {}
+    static void on_iter_alloc() {}
+    static void on_copy() {}
+    static void on_assign() {}
+    static void on_size(std::size_t) {}
+};
+
+//тег по умолчанию: все контейнеры со счётчиками пишут в запись "fwd"
+struct default_stats_tag {
+    static constexpr const char* name = "fwd";
+};
+
+//счётчики в записи реестра с именем Tag::name
+template <typename Tag = default_stats_tag>
+struct counted_stats {
+    static constexpr bool enabled = true;
+
+    static container_stats& stats();
+
+    static void on_push(std::size_t n = 1) { stats().pushes.fetch_add(n, std::memory_order_relaxed); }
+    static void on_pop(std::size_t n = 1) { stats().pops.fetch_add(n, std::memory_order_relaxed); }
+    static void on_node_alloc(std::size_t n = 1) { stats().node_allocs.fetch_add(n, std::memory_order_relaxed); }
+    static void on_node_free(std::size_t n = 1) { stats().node_frees.fetch_add(n, std::memory_order_relaxed); }
+    static void on_iter_alloc() { stats().iter_allocs.fetch_add(1, std::memory_order_relaxed); }
+    static void on_copy() { stats().copies.fetch_add(1, std::memory_order_relaxed); }
+    static void on_assign() { stats().assigns.fetch_add(1, std::memory_order_relaxed); }
+    static void on_size(std::size_t n) { stats().note_size(n); }
+};
+
+#include "container_stats_impl.h"
+
+#endif
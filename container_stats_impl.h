@@ -0,0 +1,81 @@
+#ifndef CONTAINER_STATS_IMPL_H
+#define CONTAINER_STATS_IMPL_H
+
+//реализация container_stats
+
+//обнуление
+inline void container_stats::reset() {
+    pushes.store(0, std::memory_order_relaxed);
+    pops.store(0, std::memory_order_relaxed);
+    node_allocs.store(0, std::memory_order_relaxed);
+    node_frees.store(0, std::memory_order_relaxed);
+    iter_allocs.store(0, std::memory_order_relaxed);
+    copies.store(0, std::memory_order_relaxed);
+    assigns.store(0, std::memory_order_relaxed);
+    max_size.store(0, std::memory_order_relaxed);
+}
+
+//максимум без блокировки: CAS, пока n больше сохранённого
+inline void container_stats::note_size(std::size_t n) {
+    std::uint64_t cur = max_size.load(std::memory_order_relaxed);
+    while(n > cur && !max_size.compare_exchange_weak(cur, n, std::memory_order_relaxed)) {}
+}
+
+//вывод
+inline std::ostream& operator<<(std::ostream& os, const container_stats& s) {
+    os << "push=" << s.pushes.load(std::memory_order_relaxed)
+       << " pop=" << s.pops.load(std::memory_order_relaxed)
+       << " node_alloc=" << s.node_allocs.load(std::memory_order_relaxed)
+       << " node_free=" << s.node_frees.load(std::memory_order_relaxed)
+       << " iter_alloc=" << s.iter_allocs.load(std::memory_order_relaxed)
+       << " copy=" << s.copies.load(std::memory_order_relaxed)
+       << " assign=" << s.assigns.load(std::memory_order_relaxed)
+       << " max_size=" << s.max_size.load(std::memory_order_relaxed);
+    return os;
+}
+
+//реализация stats_registry
+
+//единственный экземпляр
+inline stats_registry& stats_registry::instance() {
+    static stats_registry r;
+    return r;
+}
+
+//запись по имени, создаётся при первом обращении
+inline container_stats& stats_registry::get(const std::string& name) {
+    std::lock_guard<std::mutex> lk(m_);
+    auto& p = entries_[name];
+    if(!p) p.reset(new container_stats);
+    return *p;
+}
+
+//поиск без создания
+inline const container_stats* stats_registry::find(const std::string& name) const {
+    std::lock_guard<std::mutex> lk(m_);
+    auto it = entries_.find(name);
+    return it == entries_.end() ? nullptr : it->second.get();
+}
+
+//все записи в порядке имён
+inline void stats_registry::dump(std::ostream& os) const {
+    std::lock_guard<std::mutex> lk(m_);
+    for(const auto& e : entries_) os << e.first << ": " << *e.second << '\n';
+}
+
+//обнулить все записи
+inline void stats_registry::reset() {
+    std::lock_guard<std::mutex> lk(m_);
+    for(auto& e : entries_) e.second->reset();
+}
+
+//реализация counted_stats
+
+//запись ищется в реестре один раз, дальше - ссылка из статической переменной
+template <typename Tag>
+container_stats& counted_stats<Tag>::stats() {
+    static container_stats& s = stats_registry::instance().get(Tag::name);
+    return s;
+}
+
+#endif
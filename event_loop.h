@@ -0,0 +1,79 @@
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+
+#include "queue.h"
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+
+#ifndef __cpp_impl_coroutine
+#error "event_loop.h: нужен C++20 с корутинами"
+#endif
+
+class event_loop;
+
+//корутина без результата для event_loop: создаётся остановленной, запускается через spawn,
+//после завершения кадр удаляется сам
+//исключение из корутины выходит из event_loop::run
+class task {
+public:
+    struct promise_type {
+        event_loop* loop = nullptr;     //задаёт spawn
+
+        task get_return_object() noexcept;
+        std::suspend_always initial_suspend() noexcept;
+        std::suspend_never final_suspend() noexcept;
+        void return_void() noexcept;
+        void unhandled_exception() noexcept;
+    };
+
+    task(task&& o) noexcept;
+    task(const task&) = delete;
+    task& operator=(const task&) = delete;
+    task& operator=(task&&) = delete;
+    ~task();                            //не запущенная корутина уничтожается
+
+private:
+    explicit task(std::coroutine_handle<promise_type> h) noexcept;
+
+    std::coroutine_handle<promise_type> h_;
+    friend class event_loop;
+};
+
+//однопоточный цикл: очередь готовых к продолжению корутин, без потоков и блокировок ОС
+//ожидающие объекты (async_channel и др.) не продолжают корутину сами, а ставят её сюда через post,
+//поэтому стек не растёт от цепочек пробуждений, а готовые идут по очереди
+//узлы очереди из арены: после разгона post не выделяет память
+class event_loop {
+    queue<std::coroutine_handle<>, arena_policy> ready_;
+    std::exception_ptr error_;          //первое исключение из task
+
+    friend struct task::promise_type;
+
+public:
+    //ожидание для co_await loop.yield(): корутина уступает очередь остальным готовым
+    struct yield_awaiter {
+        event_loop& loop;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h) const { loop.post(h); }
+        void await_resume() const noexcept {}
+    };
+
+    event_loop() = default;
+    ~event_loop();                      //готовые, но не продолженные корутины уничтожаются
+    event_loop(const event_loop&) = delete;
+    event_loop& operator=(const event_loop&) = delete;
+
+    void post(std::coroutine_handle<> h);   //продолжить h в порядке очереди
+    void spawn(task t);                     //запустить корутину на этом цикле
+    yield_awaiter yield();
+
+    bool run_one();                     //продолжить одну готовую; false, если готовых нет
+    std::size_t run();                  //пока есть готовые; возвращает число продолжений
+    bool idle() const;
+    std::size_t ready() const;
+};
+
+#include "event_loop_impl.h"
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef EVENT_LOOP_IMPL_H
+#define EVENT_LOOP_IMPL_H
+
+//реализация task
+
+inline task task::promise_type::get_return_object() noexcept {
+    return task(std::coroutine_handle<promise_type>::from_promise(*this));
+}
+
+inline std::suspend_always task::promise_type::initial_suspend() noexcept { return {}; }
+
+inline std::suspend_never task::promise_type::final_suspend() noexcept { return {}; }
+
+inline void task::promise_type::return_void() noexcept {}
+
+//исключение уходит в цикл, кадр после этого удаляется как обычно
+inline void task::promise_type::unhandled_exception() noexcept {
+    if(loop && !loop->error_) loop->error_ = std::current_exception();
+}
+
+inline task::task(std::coroutine_handle<promise_type> h) noexcept: h_(h) {}
+
+inline task::task(task&& o) noexcept: h_(o.h_) { o.h_ = nullptr; }
+
+inline task::~task() {
+    if(h_) h_.destroy();
+}
+
+//реализация event_loop
+
+inline event_loop::~event_loop() {
+    while(!ready_.is_empty()) ready_.pop().destroy();
+}
+
+inline void event_loop::post(std::coroutine_handle<> h) { ready_.push(h); }
+
+//корутина встаёт в очередь и начнёт выполняться из run
+inline void event_loop::spawn(task t) {
+    t.h_.promise().loop = this;
+    post(t.h_);
+    t.h_ = nullptr;
+}
+
+inline event_loop::yield_awaiter event_loop::yield() { return yield_awaiter{*this}; }
+
+//исключение из корутины пробрасывается вызвавшему run, остальные готовые остаются в очереди
+inline bool event_loop::run_one() {
+    if(ready_.is_empty()) return false;
+    ready_.pop().resume();
+    if(error_) std::rethrow_exception(std::exchange(error_, nullptr));
+    return true;
+}
+
+inline std::size_t event_loop::run() {
+    std::size_t n = 0;
+    while(run_one()) ++n;
+    return n;
+}
+
+inline bool event_loop::idle() const { return ready_.is_empty(); }
+
+inline std::size_t event_loop::ready() const { return ready_.size(); }
+
+#endif
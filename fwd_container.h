@@ -4,6 +4,9 @@
 #include <cstddef>
 #include <iterator>
 #include <iostream>
+#include <memory>
+#include <type_traits>
+#include "memory_usage.h"
 
 template <typename T>
 class fwd_container {
@@ -13,34 +16,34 @@ public:
     class iterator;
     class const_iterator;
 
-    // 
+    //базовый итератор
     class iterator_base {
     public:
-        using iterator_category = std::forward_iterator_tag;    //  
-        using value_type = T;                                   //       T
-        using difference_type = std::ptrdiff_t;                 //   
-        using pointer = T*;                                     //
-        using reference = T&;                                   //
-
-        virtual ~iterator_base() = default;                     //   
-        virtual reference operator*() = 0;                      //   
-        virtual pointer operator->() = 0;                       //         
+        using iterator_category = std::forward_iterator_tag;    //идти только вперед
+        using value_type = T;                                   //элементы с которыми работает итр имеют тип T
+        using difference_type = std::ptrdiff_t;                 //расстояение между двумя итераторами
+        using pointer = T*;                                     //указатель
+        using reference = T&;                                   //ссылка
+
+        virtual ~iterator_base() = default;                     //удаляем обьект через родител
+        virtual reference operator*() = 0;                      //берем текущий элемент итератора
+        virtual pointer operator->() = 0;                       //берем текущий элемент итератора и обр к полю и методу
         virtual iterator_base& operator++() = 0;
 
-        // 4  
-        virtual bool operator==(const iterator_base& o) const = 0;          //true   
-        virtual bool operator!=(const iterator_base& o) const = 0;          //true    
+        // 4 оператора сравнения
+        virtual bool operator==(const iterator_base& o) const = 0;          //true если они равны
+        virtual bool operator!=(const iterator_base& o) const = 0;          //true если они не равны
         virtual bool operator==(const const_iterator_base& o) const = 0;
         virtual bool operator!=(const const_iterator_base& o) const = 0;
 
     protected:
-        virtual iterator_base* clone() const = 0;                           //   
-        virtual const_iterator_base* make_const() const = 0;                //   
+        virtual iterator_base* clone() const = 0;                           //Делает копию самого итератора
+        virtual const_iterator_base* make_const() const = 0;                //делает конст версию иетратора
         friend class iterator;
         friend class const_iterator;
     };
 
-    //   
+    // базовый константный итератор
     class const_iterator_base {
     public:
         using iterator_category = std::forward_iterator_tag;
@@ -65,9 +68,9 @@ public:
         friend class const_iterator;
     };
 
-    //  iterator
+    // обертка iterator
     class iterator {
-        iterator_base* ptr;     //  
+        iterator_base* ptr;     //указатель на иетратор
     public:
         using iterator_category = std::forward_iterator_tag;
         using value_type = T;
@@ -75,16 +78,16 @@ public:
         using pointer = T*;
         using reference = T&;
 
-        iterator();                                     //  ,   
-        explicit iterator(iterator_base* p);            // p  ptr
-        ~iterator();                                    //
-        iterator(const iterator& o);                    // 
-        iterator(iterator&& o) noexcept;                // 
-        iterator& operator=(const iterator& o);         // 
-        iterator& operator=(iterator&& o) noexcept;     // 
+        iterator();                                     //создает пустой итератор, который не указывает
+        explicit iterator(iterator_base* p);            //присваивание p в ptr
+        ~iterator();                                    //деструктор
+        iterator(const iterator& o);                    //копирующий конструктор
+        iterator(iterator&& o) noexcept;                //перемещающий конструктор
+        iterator& operator=(const iterator& o);         //копирующее присваивание
+        iterator& operator=(iterator&& o) noexcept;     //Перемещающее присваивание
 
-        reference operator*();
-        pointer operator->();
+        reference operator*() const;                    //const: итератор не меняется, элемент - да
+        pointer operator->() const;
         iterator& operator++();
         iterator operator++(int);
 
@@ -96,7 +99,7 @@ public:
         iterator_base* get() const;
     };
 
-    //  const_iterator
+    // обертка const_iterator
     class const_iterator {
         const_iterator_base* ptr;
     public:
@@ -121,7 +124,7 @@ public:
         const_iterator& operator++();
         const_iterator operator++(int);
 
-        //  
+        //операторы сравнения итераторов
         bool operator==(const const_iterator& o) const;
         bool operator!=(const const_iterator& o) const;
         bool operator==(const iterator& o) const;
@@ -130,32 +133,42 @@ public:
         const_iterator_base* get() const;
     };
 
-    //  
-    virtual ~fwd_container() = default;         //
-    virtual void push(const T& val) = 0;        //     
-    virtual void push(T&& val) = 0;             // 
-    virtual T pop() = 0;                        //     
-    virtual T& get_front() = 0;                 //  1  
-    virtual const T& get_front() const = 0;     //   1  
-    virtual bool is_empty() const = 0;          // 
+    // методы контейнера
+    virtual ~fwd_container() = default;         //десткрутор
+    virtual void push(const T& val) = 0;        //добавляет элемент по значению в контейнер
+    virtual void push(T&& val) = 0;             //перемещает элемент
+    virtual T pop() = 0;                        //удаляет и возвращает элемент из контейнера
+    virtual T& get_front() = 0;                 //ссылка на 1 элемент контейнера
+    virtual const T& get_front() const = 0;     //конст ссылка на 1 элемент контейнера
+    virtual bool is_empty() const = 0;          //пустой контейнер
     bool empty() const { return is_empty(); }
-    virtual std::size_t size() const = 0;       //-   
-    virtual iterator begin() = 0;               //    
+    virtual std::size_t size() const = 0;       //кол-во элементов в контейнере
+    virtual std::size_t memory_usage() const;   //байт всего: объект, узлы с запасом malloc, память элементов
+    virtual iterator begin() = 0;               //итератор на первый элемент контейнера
     virtual iterator end() = 0;
-    virtual const_iterator begin() const = 0;    //    
-    virtual const_iterator end() const = 0;      //    
-    virtual const_iterator cbegin() const = 0;   //     ( cbegin)
-    virtual const_iterator cend() const = 0;     //     ( cend)
-
-    //      o
+    virtual const_iterator begin() const = 0;    //конст итератор на первый элемент
+    virtual const_iterator end() const = 0;      //конст итератор за последним элементом
+    virtual const_iterator cbegin() const = 0;   //конст итератор на первый элемент (стандарт cbegin)
+    virtual const_iterator cend() const = 0;     //конст итератор за последним элементом (стандарт cend)
+
+    //пакетные операции: один виртуальный вызов на пакет вместо вызова на элемент
+    //порция обхода - n элементов подряд в порядке итераторов; колбэк возвращает false, чтобы остановить обход
+    using chunk_fn = bool (*)(void* ctx, const T* p, std::size_t n);
+    virtual void push_many(const T* p, std::size_t n);          //как push(p[0]), ..., push(p[n-1])
+    virtual std::size_t pop_many(T* out, std::size_t n);        //до n элементов в out, возвращает сколько снято
+    virtual void visit_chunks(chunk_fn f, void* ctx) const;     //обход порциями
+    template <typename F>
+    void for_each_chunk(F&& f) const;                           //f(const T*, std::size_t) -> bool или void
+
+    //очищает контейнер и копирует элементы из o
     virtual fwd_container& operator=(const fwd_container& o);
 };
 
-//
+//ввод
 template <typename T>
 std::istream& operator>>(std::istream& is, fwd_container<T>& c);
 
-//
+//вывод
 template <typename T>
 std::ostream& operator<<(std::ostream& os, const fwd_container<T>& c);
 
@@ -1,31 +1,31 @@
 #ifndef FWD_CONTAINER_IMPL_H
 #define FWD_CONTAINER_IMPL_H
 
-// iterator
+//реализация iterator
 
-//  
+//создает пустой итератор
 template <typename T>
 fwd_container<T>::iterator::iterator() : ptr(nullptr) {}
 
-//    p
+//создает инетратор обертку вокург p
 template <typename T>
 fwd_container<T>::iterator::iterator(iterator_base* p) : ptr(p) {}
 
-//
+//диструктор
 template <typename T>
 fwd_container<T>::iterator::~iterator() { delete ptr; }
 
-// 
+//копирующий конструкто
 template <typename T>
 fwd_container<T>::iterator::iterator(const iterator& o)
     : ptr(o.ptr ? o.ptr->clone() : nullptr) {}
 
-// 
+//перемещающий конструктор
 template <typename T>
 fwd_container<T>::iterator::iterator(iterator&& o) noexcept
     : ptr(o.ptr) { o.ptr = nullptr; }
 
-// 
+//копирующее присваивание
 template <typename T>
 typename fwd_container<T>::iterator&
 fwd_container<T>::iterator::operator=(const iterator& o) {
@@ -36,7 +36,7 @@ fwd_container<T>::iterator::operator=(const iterator& o) {
     return *this;
 }
 
-// 
+//перемещающее присваивание
 template <typename T>
 typename fwd_container<T>::iterator&
 fwd_container<T>::iterator::operator=(iterator&& o) noexcept {
@@ -48,36 +48,36 @@ fwd_container<T>::iterator::operator=(iterator&& o) noexcept {
     return *this;
 }
 
-// 
+//возвращает элемент
 template <typename T>
 typename fwd_container<T>::iterator::reference
-fwd_container<T>::iterator::operator*() { return **ptr; }
+fwd_container<T>::iterator::operator*() const { return **ptr; }
 
-//   
+//доступ к полю элемента
 template <typename T>
 typename fwd_container<T>::iterator::pointer
-fwd_container<T>::iterator::operator->() { return ptr->operator->(); }
+fwd_container<T>::iterator::operator->() const { return ptr->operator->(); }
 
-// 
+//шаг вперед
 template <typename T>
 typename fwd_container<T>::iterator&
 fwd_container<T>::iterator::operator++() { ++(*ptr); return *this; }
 
-//  
+//возвращает старое значение
 template <typename T>
 typename fwd_container<T>::iterator
 fwd_container<T>::iterator::operator++(int) {
-    iterator t(*this);      // 
-    ++(*this);              // 
-    return t;               // 
+    iterator t(*this);      //копия текущего
+    ++(*this);              //сдвигаем себя
+    return t;               //возвращаем копию
 }
 
-//  
+//сравнение двух итераторов
 template <typename T>
 bool fwd_container<T>::iterator::operator==(const iterator& o) const {
-    if (!ptr && !o.ptr) return true;    //  true
-    if (!ptr || !o.ptr) return false;   //  false
-    return *ptr == *o.ptr;              //  
+    if (!ptr && !o.ptr) return true;    //оба пустые true
+    if (!ptr || !o.ptr) return false;   //один пустой false
+    return *ptr == *o.ptr;              //сравниваем внутренние итераторы
 }
 
 template <typename T>
@@ -85,7 +85,7 @@ bool fwd_container<T>::iterator::operator!=(const iterator& o) const {
     return !(*this == o);
 }
 
-//   
+//сравнение с константным итератором
 template <typename T>
 bool fwd_container<T>::iterator::operator==(const const_iterator& o) const {
     if (!ptr && !o.get()) return true;
@@ -98,41 +98,41 @@ bool fwd_container<T>::iterator::operator!=(const const_iterator& o) const {
     return !(*this == o);
 }
 
-//  
+//получить внутренний указатель
 template <typename T>
 typename fwd_container<T>::iterator_base*
 fwd_container<T>::iterator::get() const { return ptr; }
 
-// const_iterator
+//реализация const_iterator
 
-//   
+//создает пустой константный итератор
 template <typename T>
 fwd_container<T>::const_iterator::const_iterator() : ptr(nullptr) {}
 
-//   p
+//создает обертку для p
 template <typename T>
 fwd_container<T>::const_iterator::const_iterator(const_iterator_base* p) : ptr(p) {}
 
-//
+//дистркуктор
 template <typename T>
 fwd_container<T>::const_iterator::~const_iterator() { delete ptr; }
 
-// 
+//копирующий конструктор
 template <typename T>
 fwd_container<T>::const_iterator::const_iterator(const const_iterator& o)
     : ptr(o.ptr ? o.ptr->clone() : nullptr) {}
 
-// 
+//перемещающий конструктор
 template <typename T>
 fwd_container<T>::const_iterator::const_iterator(const_iterator&& o) noexcept
     : ptr(o.ptr) { o.ptr = nullptr; }
 
-//  
+//делает константную версию
 template <typename T>
 fwd_container<T>::const_iterator::const_iterator(const iterator& o)
     : ptr(o.get() ? o.get()->make_const() : nullptr) {}
 
-// 
+//копирующее присваивание
 template <typename T>
 typename fwd_container<T>::const_iterator&
 fwd_container<T>::const_iterator::operator=(const const_iterator& o) {
@@ -143,7 +143,7 @@ fwd_container<T>::const_iterator::operator=(const const_iterator& o) {
     return *this;
 }
 
-// 
+//перемещающее присваивание
 template <typename T>
 typename fwd_container<T>::const_iterator&
 fwd_container<T>::const_iterator::operator=(const_iterator&& o) noexcept {
@@ -155,7 +155,7 @@ fwd_container<T>::const_iterator::operator=(const_iterator&& o) noexcept {
     return *this;
 }
 
-//   
+//присваивание из обычного итератора
 template <typename T>
 typename fwd_container<T>::const_iterator&
 fwd_container<T>::const_iterator::operator=(const iterator& o) {
@@ -164,22 +164,22 @@ fwd_container<T>::const_iterator::operator=(const iterator& o) {
     return *this;
 }
 
-//  
+//возвращает константную ссылку
 template <typename T>
 typename fwd_container<T>::const_iterator::reference
 fwd_container<T>::const_iterator::operator*() const { return **ptr; }
 
-//   
+//доступ к полю элемента
 template <typename T>
 typename fwd_container<T>::const_iterator::pointer
 fwd_container<T>::const_iterator::operator->() const { return ptr->operator->(); }
 
-//  
+// шаг вперед
 template <typename T>
 typename fwd_container<T>::const_iterator&
 fwd_container<T>::const_iterator::operator++() { ++(*ptr); return *this; }
 
-//  
+//возвращает старое значение
 template <typename T>
 typename fwd_container<T>::const_iterator
 fwd_container<T>::const_iterator::operator++(int) {
@@ -188,7 +188,7 @@ fwd_container<T>::const_iterator::operator++(int) {
     return t;
 }
 
-//  
+//сравнение константных итераторов
 template <typename T>
 bool fwd_container<T>::const_iterator::operator==(const const_iterator& o) const {
     if (!ptr && !o.ptr) return true;
@@ -201,7 +201,7 @@ bool fwd_container<T>::const_iterator::operator!=(const const_iterator& o) const
     return !(*this == o);
 }
 
-//   
+//сравнение с обычным итератором
 template <typename T>
 bool fwd_container<T>::const_iterator::operator==(const iterator& o) const {
     if (!ptr && !o.get()) return true;
@@ -214,13 +214,13 @@ bool fwd_container<T>::const_iterator::operator!=(const iterator& o) const {
     return !(*this == o);
 }
 
-//  
+//получить внутренний указатель
 template <typename T>
 typename fwd_container<T>::const_iterator_base*
 fwd_container<T>::const_iterator::get() const { return ptr; }
 
-// operator= 
-//     (stack = queue)
+//реализация operator= контейнера
+//позволяет присваивать любой контейнер любому (stack = queue)
 template <typename T>
 fwd_container<T>& fwd_container<T>::operator=(const fwd_container& o) {
     if (this != &o) {
@@ -237,7 +237,54 @@ fwd_container<T>& fwd_container<T>::operator=(const fwd_container& o) {
     return *this;
 }
 
-//
+//память по умолчанию: только сами элементы и то, чем они владеют
+//наследники знают своё устройство и добавляют объект, узлы и запас аллокатора
+template <typename T>
+std::size_t fwd_container<T>::memory_usage() const {
+    std::size_t n = size() * sizeof(T);
+    if(!heap_usage<T>::none)
+        for(auto it = cbegin(); it != cend(); ++it) n += heap_usage<T>::bytes(*it);
+    return n;
+}
+
+//пакетная вставка по умолчанию: обычные push, но без вызова на каждый элемент снаружи
+template <typename T>
+void fwd_container<T>::push_many(const T* p, std::size_t n) {
+    for(std::size_t i = 0; i < n; ++i) push(p[i]);
+}
+
+//пакетное снятие по умолчанию
+template <typename T>
+std::size_t fwd_container<T>::pop_many(T* out, std::size_t n) {
+    std::size_t k = 0;
+    for(; k < n && !is_empty(); ++k) out[k] = pop();
+    return k;
+}
+
+//обход по умолчанию: по одному элементу через итераторы
+template <typename T>
+void fwd_container<T>::visit_chunks(chunk_fn f, void* ctx) const {
+    for(auto it = cbegin(); it != cend(); ++it)
+        if(!f(ctx, &*it, 1)) return;
+}
+
+//обёртка над visit_chunks для лямбд; колбэк без результата обходит всё
+template <typename T>
+template <typename F>
+void fwd_container<T>::for_each_chunk(F&& f) const {
+    using Fn = std::remove_reference_t<F>;
+    visit_chunks([](void* ctx, const T* p, std::size_t n) -> bool {
+        Fn& fn = *static_cast<Fn*>(ctx);
+        if constexpr(std::is_void<decltype(fn(p, n))>::value) {
+            fn(p, n);
+            return true;
+        } else {
+            return static_cast<bool>(fn(p, n));
+        }
+    }, const_cast<void*>(static_cast<const void*>(std::addressof(f))));
+}
+
+//ввод
 template <typename T>
 std::istream& operator>>(std::istream& is, fwd_container<T>& c) {
     T val;
@@ -245,7 +292,7 @@ std::istream& operator>>(std::istream& is, fwd_container<T>& c) {
     return is;
 }
 
-//
+//вывод
 template <typename T>
 std::ostream& operator<<(std::ostream& os, const fwd_container<T>& c) {
     bool first = true;
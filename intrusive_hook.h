@@ -0,0 +1,37 @@
+#ifndef INTRUSIVE_HOOK_H
+#define INTRUSIVE_HOOK_H
+
+#include <stdexcept>
+
+//звено для интрузивных контейнеров: элемент сам хранит ссылку на следующий
+//пример: struct job { int id; intrusive_hook<job> hook; };  intrusive_queue<job> q;
+//копия элемента получает чистое звено: она ещё не лежит ни в одном контейнере,
+//присваивание звено не трогает - элемент остаётся там, где лежал
+template <typename T>
+struct intrusive_hook {
+    T* next = nullptr;
+    bool linked = false;        //элемент уже лежит в каком-то контейнере
+
+    intrusive_hook() = default;
+    intrusive_hook(const intrusive_hook&) noexcept {}
+    intrusive_hook& operator=(const intrusive_hook&) noexcept { return *this; }
+};
+
+//проверки звена; одинаковы в отладке и с NDEBUG, чтобы раскладка не зависела от сборки
+namespace intrusive_detail {
+
+template <typename T>
+void on_link(intrusive_hook<T>& h) {
+    if (h.linked) throw std::logic_error("intrusive: элемент уже лежит в контейнере");
+    h.linked = true;
+}
+
+template <typename T>
+void on_unlink(intrusive_hook<T>& h) {
+    h.linked = false;
+    h.next = nullptr;
+}
+
+}
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef INTRUSIVE_QUEUE_H
+#define INTRUSIVE_QUEUE_H
+
+#include "intrusive_hook.h"
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+
+//интрузивная очередь: элементы не копируются и не выделяются, push/pop только перевязывают hook
+//контейнер не владеет элементами - они должны жить дольше, чем лежат в очереди
+template <typename T, intrusive_hook<T> T::*Hook = &T::hook>
+class intrusive_queue {
+    T* front_;          //первый элемент
+    T* back_;           //последний элемент
+    std::size_t sz_;    //количество элементов
+
+public:
+    class const_iterator;
+
+    // итератор очереди
+    class iterator {
+        T* cur;
+        friend class const_iterator;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator(T* n = nullptr);
+
+        reference operator*() const;
+        pointer operator->() const;
+        iterator& operator++();
+        iterator operator++(int);
+
+        bool operator==(const iterator& o) const;
+        bool operator!=(const iterator& o) const;
+        bool operator==(const const_iterator& o) const;
+        bool operator!=(const const_iterator& o) const;
+    };
+
+    // константный итератор очереди
+    class const_iterator {
+        const T* cur;
+        friend class iterator;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator(const T* n = nullptr);
+        const_iterator(const iterator& o);
+
+        reference operator*() const;
+        pointer operator->() const;
+        const_iterator& operator++();
+        const_iterator operator++(int);
+
+        bool operator==(const const_iterator& o) const;
+        bool operator!=(const const_iterator& o) const;
+        bool operator==(const iterator& o) const;
+        bool operator!=(const iterator& o) const;
+    };
+
+    intrusive_queue();                                  //пустая очередь
+    ~intrusive_queue();                                 //отвязывает элементы, не удаляя их
+    intrusive_queue(const intrusive_queue&) = delete;   //элемент не может лежать в двух очередях
+    intrusive_queue& operator=(const intrusive_queue&) = delete;
+    intrusive_queue(intrusive_queue&& o) noexcept;
+    intrusive_queue& operator=(intrusive_queue&& o) noexcept;
+
+    void push(T& v);            //ставит сам элемент в конец, повторная вставка - std::logic_error
+    T& pop();                   //снимает первый элемент и возвращает ссылку на него
+    T& get_front();
+    const T& get_front() const;
+
+    bool is_empty() const;
+    bool empty() const { return is_empty(); }
+    std::size_t size() const;
+    void clear();               //отвязать все элементы
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+};
+
+#include "intrusive_queue_impl.h"
+
+#endif
@@ -0,0 +1,209 @@
+#ifndef INTRUSIVE_QUEUE_IMPL_H
+#define INTRUSIVE_QUEUE_IMPL_H
+
+//реализация iterator
+
+//конструктор
+template <typename T, intrusive_hook<T> T::*Hook>
+intrusive_queue<T, Hook>::iterator::iterator(T* n): cur(n) {}
+
+//разыменование
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_queue<T, Hook>::iterator::reference
+intrusive_queue<T, Hook>::iterator::operator*() const { return *cur; }
+
+//доступ к полю
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_queue<T, Hook>::iterator::pointer
+intrusive_queue<T, Hook>::iterator::operator->() const { return cur; }
+
+//шаг по звену элемента
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_queue<T, Hook>::iterator&
+intrusive_queue<T, Hook>::iterator::operator++() {
+    if(cur) cur = (cur->*Hook).next;
+    return *this;
+}
+
+//постфиксный шаг
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_queue<T, Hook>::iterator
+intrusive_queue<T, Hook>::iterator::operator++(int) {
+    iterator t(*this);
+    ++(*this);
+    return t;
+}
+
+//сравнения
+template <typename T, intrusive_hook<T> T::*Hook>
+bool intrusive_queue<T, Hook>::iterator::operator==(const iterator& o) const { return cur == o.cur; }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+bool intrusive_queue<T, Hook>::iterator::operator!=(const iterator& o) const { return cur != o.cur; }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+bool intrusive_queue<T, Hook>::iterator::operator==(const const_iterator& o) const { return cur == o.cur; }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+bool intrusive_queue<T, Hook>::iterator::operator!=(const const_iterator& o) const { return cur != o.cur; }
+
+//реализация const_iterator
+
+//конструктор
+template <typename T, intrusive_hook<T> T::*Hook>
+intrusive_queue<T, Hook>::const_iterator::const_iterator(const T* n): cur(n) {}
+
+//из обычного итератора
+template <typename T, intrusive_hook<T> T::*Hook>
+intrusive_queue<T, Hook>::const_iterator::const_iterator(const iterator& o): cur(o.cur) {}
+
+//разыменование
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_queue<T, Hook>::const_iterator::reference
+intrusive_queue<T, Hook>::const_iterator::operator*() const { return *cur; }
+
+//доступ к полю
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_queue<T, Hook>::const_iterator::pointer
+intrusive_queue<T, Hook>::const_iterator::operator->() const { return cur; }
+
+//шаг по звену элемента
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_queue<T, Hook>::const_iterator&
+intrusive_queue<T, Hook>::const_iterator::operator++() {
+    if(cur) cur = (cur->*Hook).next;
+    return *this;
+}
+
+//постфиксный шаг
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_queue<T, Hook>::const_iterator
+intrusive_queue<T, Hook>::const_iterator::operator++(int) {
+    const_iterator t(*this);
+    ++(*this);
+    return t;
+}
+
+//сравнения
+template <typename T, intrusive_hook<T> T::*Hook>
+bool intrusive_queue<T, Hook>::const_iterator::operator==(const const_iterator& o) const { return cur == o.cur; }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+bool intrusive_queue<T, Hook>::const_iterator::operator!=(const const_iterator& o) const { return cur != o.cur; }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+bool intrusive_queue<T, Hook>::const_iterator::operator==(const iterator& o) const { return cur == o.cur; }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+bool intrusive_queue<T, Hook>::const_iterator::operator!=(const iterator& o) const { return cur != o.cur; }
+
+//реализация очереди
+
+//пустая очередь
+template <typename T, intrusive_hook<T> T::*Hook>
+intrusive_queue<T, Hook>::intrusive_queue(): front_(nullptr), back_(nullptr), sz_(0) {}
+
+//деструктор
+template <typename T, intrusive_hook<T> T::*Hook>
+intrusive_queue<T, Hook>::~intrusive_queue() { clear(); }
+
+//перемещающий конструктор
+template <typename T, intrusive_hook<T> T::*Hook>
+intrusive_queue<T, Hook>::intrusive_queue(intrusive_queue&& o) noexcept
+    : front_(o.front_), back_(o.back_), sz_(o.sz_) {
+    o.front_ = o.back_ = nullptr;
+    o.sz_ = 0;
+}
+
+//перемещающее присваивание
+template <typename T, intrusive_hook<T> T::*Hook>
+intrusive_queue<T, Hook>& intrusive_queue<T, Hook>::operator=(intrusive_queue&& o) noexcept {
+    if(this != &o) {
+        clear();
+        front_ = o.front_;
+        back_ = o.back_;
+        sz_ = o.sz_;
+        o.front_ = o.back_ = nullptr;
+        o.sz_ = 0;
+    }
+    return *this;
+}
+
+//добавление в конец: только перевязка указателей
+template <typename T, intrusive_hook<T> T::*Hook>
+void intrusive_queue<T, Hook>::push(T& v) {
+    intrusive_detail::on_link(v.*Hook);
+    (v.*Hook).next = nullptr;
+    if(is_empty()) front_ = &v;
+    else (back_->*Hook).next = &v;
+    back_ = &v;
+    sz_++;
+}
+
+//снятие первого элемента
+template <typename T, intrusive_hook<T> T::*Hook>
+T& intrusive_queue<T, Hook>::pop() {
+    if(is_empty()) throw std::runtime_error("intrusive_queue empty");
+    T* t = front_;
+    front_ = (t->*Hook).next;
+    if(front_ == nullptr) back_ = nullptr;
+    intrusive_detail::on_unlink(t->*Hook);
+    sz_--;
+    return *t;
+}
+
+//первый элемент
+template <typename T, intrusive_hook<T> T::*Hook>
+T& intrusive_queue<T, Hook>::get_front() {
+    if(is_empty()) throw std::runtime_error("intrusive_queue empty");
+    return *front_;
+}
+
+//константный первый элемент
+template <typename T, intrusive_hook<T> T::*Hook>
+const T& intrusive_queue<T, Hook>::get_front() const {
+    if(is_empty()) throw std::runtime_error("intrusive_queue empty");
+    return *front_;
+}
+
+//пустота
+template <typename T, intrusive_hook<T> T::*Hook>
+bool intrusive_queue<T, Hook>::is_empty() const { return front_ == nullptr; }
+
+//размер
+template <typename T, intrusive_hook<T> T::*Hook>
+std::size_t intrusive_queue<T, Hook>::size() const { return sz_; }
+
+//отвязываем элементы, сами элементы остаются у владельца
+template <typename T, intrusive_hook<T> T::*Hook>
+void intrusive_queue<T, Hook>::clear() {
+    while(front_) {
+        T* t = front_;
+        front_ = (t->*Hook).next;
+        intrusive_detail::on_unlink(t->*Hook);
+    }
+    back_ = nullptr;
+    sz_ = 0;
+}
+
+//итераторы
+
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_queue<T, Hook>::iterator intrusive_queue<T, Hook>::begin() { return iterator(front_); }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_queue<T, Hook>::iterator intrusive_queue<T, Hook>::end() { return iterator(nullptr); }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_queue<T, Hook>::const_iterator intrusive_queue<T, Hook>::begin() const { return const_iterator(front_); }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_queue<T, Hook>::const_iterator intrusive_queue<T, Hook>::end() const { return const_iterator(nullptr); }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_queue<T, Hook>::const_iterator intrusive_queue<T, Hook>::cbegin() const { return const_iterator(front_); }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_queue<T, Hook>::const_iterator intrusive_queue<T, Hook>::cend() const { return const_iterator(nullptr); }
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef INTRUSIVE_STACK_H
+#define INTRUSIVE_STACK_H
+
+#include "intrusive_hook.h"
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+
+//интрузивный стек: элементы не копируются и не выделяются, push/pop только перевязывают hook
+//контейнер не владеет элементами - они должны жить дольше, чем лежат в стеке
+template <typename T, intrusive_hook<T> T::*Hook = &T::hook>
+class intrusive_stack {
+    T* top_;            //вершина
+    std::size_t sz_;    //количество элементов
+
+public:
+    class const_iterator;
+
+    // итератор стека
+    class iterator {
+        T* cur;
+        friend class const_iterator;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator(T* n = nullptr);
+
+        reference operator*() const;
+        pointer operator->() const;
+        iterator& operator++();
+        iterator operator++(int);
+
+        bool operator==(const iterator& o) const;
+        bool operator!=(const iterator& o) const;
+        bool operator==(const const_iterator& o) const;
+        bool operator!=(const const_iterator& o) const;
+    };
+
+    // константный итератор стека
+    class const_iterator {
+        const T* cur;
+        friend class iterator;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator(const T* n = nullptr);
+        const_iterator(const iterator& o);
+
+        reference operator*() const;
+        pointer operator->() const;
+        const_iterator& operator++();
+        const_iterator operator++(int);
+
+        bool operator==(const const_iterator& o) const;
+        bool operator!=(const const_iterator& o) const;
+        bool operator==(const iterator& o) const;
+        bool operator!=(const iterator& o) const;
+    };
+
+    intrusive_stack();                                  //пустой стек
+    ~intrusive_stack();                                 //отвязывает элементы, не удаляя их
+    intrusive_stack(const intrusive_stack&) = delete;   //элемент не может лежать в двух стеках
+    intrusive_stack& operator=(const intrusive_stack&) = delete;
+    intrusive_stack(intrusive_stack&& o) noexcept;
+    intrusive_stack& operator=(intrusive_stack&& o) noexcept;
+
+    void push(T& v);            //кладёт сам элемент, повторная вставка - std::logic_error
+    T& pop();                   //снимает вершину и возвращает ссылку на неё
+    T& get_front();
+    const T& get_front() const;
+
+    bool is_empty() const;
+    bool empty() const { return is_empty(); }
+    std::size_t size() const;
+    void clear();               //отвязать все элементы
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+};
+
+#include "intrusive_stack_impl.h"
+
+#endif
@@ -0,0 +1,203 @@
+#ifndef INTRUSIVE_STACK_IMPL_H
+#define INTRUSIVE_STACK_IMPL_H
+
+//реализация iterator
+
+//конструктор
+template <typename T, intrusive_hook<T> T::*Hook>
+intrusive_stack<T, Hook>::iterator::iterator(T* n): cur(n) {}
+
+//разыменование
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_stack<T, Hook>::iterator::reference
+intrusive_stack<T, Hook>::iterator::operator*() const { return *cur; }
+
+//доступ к полю
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_stack<T, Hook>::iterator::pointer
+intrusive_stack<T, Hook>::iterator::operator->() const { return cur; }
+
+//шаг по звену элемента
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_stack<T, Hook>::iterator&
+intrusive_stack<T, Hook>::iterator::operator++() {
+    if(cur) cur = (cur->*Hook).next;
+    return *this;
+}
+
+//постфиксный шаг
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_stack<T, Hook>::iterator
+intrusive_stack<T, Hook>::iterator::operator++(int) {
+    iterator t(*this);
+    ++(*this);
+    return t;
+}
+
+//сравнения
+template <typename T, intrusive_hook<T> T::*Hook>
+bool intrusive_stack<T, Hook>::iterator::operator==(const iterator& o) const { return cur == o.cur; }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+bool intrusive_stack<T, Hook>::iterator::operator!=(const iterator& o) const { return cur != o.cur; }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+bool intrusive_stack<T, Hook>::iterator::operator==(const const_iterator& o) const { return cur == o.cur; }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+bool intrusive_stack<T, Hook>::iterator::operator!=(const const_iterator& o) const { return cur != o.cur; }
+
+//реализация const_iterator
+
+//конструктор
+template <typename T, intrusive_hook<T> T::*Hook>
+intrusive_stack<T, Hook>::const_iterator::const_iterator(const T* n): cur(n) {}
+
+//из обычного итератора
+template <typename T, intrusive_hook<T> T::*Hook>
+intrusive_stack<T, Hook>::const_iterator::const_iterator(const iterator& o): cur(o.cur) {}
+
+//разыменование
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_stack<T, Hook>::const_iterator::reference
+intrusive_stack<T, Hook>::const_iterator::operator*() const { return *cur; }
+
+//доступ к полю
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_stack<T, Hook>::const_iterator::pointer
+intrusive_stack<T, Hook>::const_iterator::operator->() const { return cur; }
+
+//шаг по звену элемента
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_stack<T, Hook>::const_iterator&
+intrusive_stack<T, Hook>::const_iterator::operator++() {
+    if(cur) cur = (cur->*Hook).next;
+    return *this;
+}
+
+//постфиксный шаг
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_stack<T, Hook>::const_iterator
+intrusive_stack<T, Hook>::const_iterator::operator++(int) {
+    const_iterator t(*this);
+    ++(*this);
+    return t;
+}
+
+//сравнения
+template <typename T, intrusive_hook<T> T::*Hook>
+bool intrusive_stack<T, Hook>::const_iterator::operator==(const const_iterator& o) const { return cur == o.cur; }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+bool intrusive_stack<T, Hook>::const_iterator::operator!=(const const_iterator& o) const { return cur != o.cur; }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+bool intrusive_stack<T, Hook>::const_iterator::operator==(const iterator& o) const { return cur == o.cur; }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+bool intrusive_stack<T, Hook>::const_iterator::operator!=(const iterator& o) const { return cur != o.cur; }
+
+//реализация стека
+
+//пустой стек
+template <typename T, intrusive_hook<T> T::*Hook>
+intrusive_stack<T, Hook>::intrusive_stack(): top_(nullptr), sz_(0) {}
+
+//деструктор
+template <typename T, intrusive_hook<T> T::*Hook>
+intrusive_stack<T, Hook>::~intrusive_stack() { clear(); }
+
+//перемещающий конструктор
+template <typename T, intrusive_hook<T> T::*Hook>
+intrusive_stack<T, Hook>::intrusive_stack(intrusive_stack&& o) noexcept: top_(o.top_), sz_(o.sz_) {
+    o.top_ = nullptr;
+    o.sz_ = 0;
+}
+
+//перемещающее присваивание
+template <typename T, intrusive_hook<T> T::*Hook>
+intrusive_stack<T, Hook>& intrusive_stack<T, Hook>::operator=(intrusive_stack&& o) noexcept {
+    if(this != &o) {
+        clear();
+        top_ = o.top_;
+        sz_ = o.sz_;
+        o.top_ = nullptr;
+        o.sz_ = 0;
+    }
+    return *this;
+}
+
+//добавление: только перевязка указателя
+template <typename T, intrusive_hook<T> T::*Hook>
+void intrusive_stack<T, Hook>::push(T& v) {
+    intrusive_detail::on_link(v.*Hook);
+    (v.*Hook).next = top_;
+    top_ = &v;
+    sz_++;
+}
+
+//снятие вершины
+template <typename T, intrusive_hook<T> T::*Hook>
+T& intrusive_stack<T, Hook>::pop() {
+    if(is_empty()) throw std::runtime_error("intrusive_stack empty");
+    T* t = top_;
+    top_ = (t->*Hook).next;
+    intrusive_detail::on_unlink(t->*Hook);
+    sz_--;
+    return *t;
+}
+
+//вершина
+template <typename T, intrusive_hook<T> T::*Hook>
+T& intrusive_stack<T, Hook>::get_front() {
+    if(is_empty()) throw std::runtime_error("intrusive_stack empty");
+    return *top_;
+}
+
+//константная вершина
+template <typename T, intrusive_hook<T> T::*Hook>
+const T& intrusive_stack<T, Hook>::get_front() const {
+    if(is_empty()) throw std::runtime_error("intrusive_stack empty");
+    return *top_;
+}
+
+//пустота
+template <typename T, intrusive_hook<T> T::*Hook>
+bool intrusive_stack<T, Hook>::is_empty() const { return top_ == nullptr; }
+
+//размер
+template <typename T, intrusive_hook<T> T::*Hook>
+std::size_t intrusive_stack<T, Hook>::size() const { return sz_; }
+
+//отвязываем элементы, сами элементы остаются у владельца
+template <typename T, intrusive_hook<T> T::*Hook>
+void intrusive_stack<T, Hook>::clear() {
+    while(top_) {
+        T* t = top_;
+        top_ = (t->*Hook).next;
+        intrusive_detail::on_unlink(t->*Hook);
+    }
+    sz_ = 0;
+}
+
+//итераторы
+
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_stack<T, Hook>::iterator intrusive_stack<T, Hook>::begin() { return iterator(top_); }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_stack<T, Hook>::iterator intrusive_stack<T, Hook>::end() { return iterator(nullptr); }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_stack<T, Hook>::const_iterator intrusive_stack<T, Hook>::begin() const { return const_iterator(top_); }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_stack<T, Hook>::const_iterator intrusive_stack<T, Hook>::end() const { return const_iterator(nullptr); }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_stack<T, Hook>::const_iterator intrusive_stack<T, Hook>::cbegin() const { return const_iterator(top_); }
+
+template <typename T, intrusive_hook<T> T::*Hook>
+typename intrusive_stack<T, Hook>::const_iterator intrusive_stack<T, Hook>::cend() const { return const_iterator(nullptr); }
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef LIST_VIEW_H
+#define LIST_VIEW_H
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#ifdef __cpp_lib_ranges
+#include <ranges>
+#endif
+
+//лёгкие итераторы по цепочке узлов stack и queue для алгоритмов std::ranges и std::views
+//итератор - один указатель на узел, без кучи и виртуальных вызовов; конец - nullptr
+//полиморфные итераторы fwd_container тоже годятся для std::views, но каждый шаг у них -
+//виртуальный вызов, а копия - new; list_view для горячих конвейеров
+//Node может быть const, тогда элементы только для чтения
+template <typename Node>
+class list_iterator {
+    Node* cur_;
+
+public:
+    using value_type = typename std::remove_const_t<Node>::value_type;
+    using element_type = std::conditional_t<std::is_const_v<Node>, const value_type, value_type>;
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using pointer = element_type*;
+    using reference = element_type&;
+
+    constexpr list_iterator(Node* n = nullptr) noexcept;
+    template <typename N, typename = std::enable_if_t<std::is_same_v<const N, Node> && !std::is_same_v<N, Node>>>
+    constexpr list_iterator(const list_iterator<N>& o) noexcept;    //обычный -> константный
+
+    constexpr reference operator*() const;
+    constexpr pointer operator->() const;
+    constexpr list_iterator& operator++();
+    constexpr list_iterator operator++(int);
+
+    constexpr bool operator==(const list_iterator& o) const;
+    constexpr bool operator!=(const list_iterator& o) const;
+
+    constexpr Node* node() const;
+};
+
+//диапазон из n узлов начиная с head; не владеет узлами и живёт не дольше контейнера
+//изменение контейнера (push/pop) делает вид недействительным, как и итераторы
+template <typename Node>
+class list_view
+#ifdef __cpp_lib_ranges
+    : public std::ranges::view_interface<list_view<Node>>
+#endif
+{
+    Node* head_;
+    std::size_t n_;
+
+public:
+    using iterator = list_iterator<Node>;
+
+    constexpr list_view() noexcept;
+    constexpr list_view(Node* head, std::size_t n) noexcept;
+
+    constexpr iterator begin() const;
+    constexpr iterator end() const;
+    constexpr std::size_t size() const;
+    constexpr bool empty() const;
+};
+
+#ifdef __cpp_lib_ranges
+//итераторы list_view не ссылаются на сам вид, поэтому его можно отдавать из функций
+template <typename Node>
+inline constexpr bool std::ranges::enable_borrowed_range<list_view<Node>> = true;
+
+//адаптер для конвейеров: c | as_view | std::views::filter(...)
+//у stack и queue берётся c.view() с лёгкими итераторами, у остальных - std::views::all(c)
+struct as_view_fn {
+    template <typename C>
+    constexpr auto operator()(C& c) const;
+
+    template <typename C>
+    friend constexpr auto operator|(C& c, const as_view_fn& f) { return f(c); }
+};
+
+inline constexpr as_view_fn as_view{};
+#endif
+
+#include "list_view_impl.h"
+
+#endif
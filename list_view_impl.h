@@ -0,0 +1,74 @@
+#ifndef LIST_VIEW_IMPL_H
+#define LIST_VIEW_IMPL_H
+
+//реализация list_iterator
+
+template <typename Node>
+constexpr list_iterator<Node>::list_iterator(Node* n) noexcept: cur_(n) {}
+
+template <typename Node>
+template <typename N, typename>
+constexpr list_iterator<Node>::list_iterator(const list_iterator<N>& o) noexcept: cur_(o.node()) {}
+
+//разыменование
+template <typename Node>
+constexpr typename list_iterator<Node>::reference list_iterator<Node>::operator*() const { return cur_->data; }
+
+template <typename Node>
+constexpr typename list_iterator<Node>::pointer list_iterator<Node>::operator->() const { return &cur_->data; }
+
+//шаг по next
+template <typename Node>
+constexpr list_iterator<Node>& list_iterator<Node>::operator++() {
+    cur_ = cur_->next;
+    return *this;
+}
+
+template <typename Node>
+constexpr list_iterator<Node> list_iterator<Node>::operator++(int) {
+    list_iterator t(*this);
+    cur_ = cur_->next;
+    return t;
+}
+
+//сравнение по узлу
+template <typename Node>
+constexpr bool list_iterator<Node>::operator==(const list_iterator& o) const { return cur_ == o.cur_; }
+
+template <typename Node>
+constexpr bool list_iterator<Node>::operator!=(const list_iterator& o) const { return cur_ != o.cur_; }
+
+template <typename Node>
+constexpr Node* list_iterator<Node>::node() const { return cur_; }
+
+//реализация list_view
+
+template <typename Node>
+constexpr list_view<Node>::list_view() noexcept: head_(nullptr), n_(0) {}
+
+template <typename Node>
+constexpr list_view<Node>::list_view(Node* head, std::size_t n) noexcept: head_(head), n_(n) {}
+
+template <typename Node>
+constexpr typename list_view<Node>::iterator list_view<Node>::begin() const { return iterator(head_); }
+
+template <typename Node>
+constexpr typename list_view<Node>::iterator list_view<Node>::end() const { return iterator(); }
+
+template <typename Node>
+constexpr std::size_t list_view<Node>::size() const { return n_; }
+
+template <typename Node>
+constexpr bool list_view<Node>::empty() const { return n_ == 0; }
+
+#ifdef __cpp_lib_ranges
+//реализация as_view
+
+template <typename C>
+constexpr auto as_view_fn::operator()(C& c) const {
+    if constexpr(requires { c.view(); }) return c.view();
+    else return std::views::all(c);
+}
+#endif
+
+#endif
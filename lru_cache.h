@@ -0,0 +1,76 @@
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include "queue.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+//кэш на capacity ключей с вытеснением давно не использованного
+//порядок использования - queue: в начале самый давний, в конце самый свежий
+//узлы очереди проиндексированы хеш-таблицей с открытой адресацией (линейное пробирование):
+//ячейка хранит узел ключа и узел перед ним, поэтому поиск, перенос в конец и вытеснение - O(1)
+//без обхода списка; при удалении хвост кластера сдвигается назад, надгробий нет
+//таблица вдвое больше capacity и не растёт, при вытеснении узел переиспользуется под новый ключ
+template <typename K, typename V, typename Hash = std::hash<K>, typename Eq = std::equal_to<K>, typename Policy = default_policy>
+class lru_cache {
+    struct entry {
+        K key;
+        V value;
+        std::size_t slot;       //ячейка таблицы с этим узлом
+    };
+    using order = queue<entry, Policy>;
+    using Node = typename order::Node;
+
+    //ячейка таблицы; пустая - node == nullptr
+    struct cell {
+        Node* node;
+        Node* prev;             //предыдущий в очереди, nullptr у первого
+        std::size_t hash;
+    };
+
+    order q_;
+    std::vector<cell> table_;
+    unsigned shift_;            //64 - log2(размера таблицы)
+    std::size_t cap_;
+    Hash hash_;
+    Eq eq_;
+
+public:
+    explicit lru_cache(std::size_t capacity, const Hash& hash = Hash(), const Eq& eq = Eq());
+    lru_cache(const lru_cache&) = delete;
+    lru_cache& operator=(const lru_cache&) = delete;
+    lru_cache(lru_cache&& o);               //o остаётся пустым кэшем той же вместимости
+    lru_cache& operator=(lru_cache&& o);
+
+    V* get(const K& k);                     //значение или nullptr; найденный ключ становится самым свежим
+    const V* peek(const K& k) const;        //без переноса
+    bool contains(const K& k) const;
+
+    //вставка или замена значения, ключ становится самым свежим; true - ключ новый
+    //при полном кэше вытесняется самый давний
+    bool put(const K& k, V v);
+    bool erase(const K& k);
+
+    const K& lru_key() const;               //следующий на вытеснение; std::runtime_error на пустом
+    std::size_t size() const;
+    std::size_t capacity() const;
+    bool is_empty() const;
+    bool empty() const;
+    std::size_t memory_usage() const;       //объект + таблица + узлы очереди
+
+private:
+    std::size_t home(std::size_t h) const;  //начальная ячейка для хеша
+    std::size_t find(const K& k, std::size_t h) const;     //ячейка ключа или table_.size()
+    void touch(std::size_t i);              //узел ячейки i - в конец очереди
+    void unlink(std::size_t i);             //узел ячейки i вынимается из очереди, next не трогается
+    void link_back(std::size_t i);          //узел ячейки i - в конец очереди
+    void remove_cell(std::size_t i);        //сдвиг кластера на место i
+};
+
+#include "lru_cache_impl.h"
+
+#endif
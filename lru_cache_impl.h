@@ -0,0 +1,195 @@
+#ifndef LRU_CACHE_IMPL_H
+#define LRU_CACHE_IMPL_H
+
+//реализация lru_cache
+
+//таблица - степень двойки не меньше 2 * capacity, то есть не меньше 2 ячеек
+template <typename K, typename V, typename Hash, typename Eq, typename Policy>
+lru_cache<K, V, Hash, Eq, Policy>::lru_cache(std::size_t capacity, const Hash& hash, const Eq& eq)
+    : shift_(64), cap_(capacity), hash_(hash), eq_(eq) {
+    if(capacity == 0) throw std::runtime_error("lru_cache: нулевая вместимость");
+    if(capacity > (std::size_t(1) << 60)) throw std::length_error("lru_cache: слишком большая вместимость");
+    std::size_t n = 1;
+    while(n < 2 * capacity) { n <<= 1; --shift_; }
+    table_.assign(n, cell{nullptr, nullptr, 0});
+}
+
+//перемещение: узлы и таблица забираются, o получает новую пустую таблицу того же размера
+//хеш и сравнение копируются, чтобы o остался рабочим
+template <typename K, typename V, typename Hash, typename Eq, typename Policy>
+lru_cache<K, V, Hash, Eq, Policy>::lru_cache(lru_cache&& o)
+    : q_(std::move(o.q_)), table_(std::move(o.table_)), shift_(o.shift_), cap_(o.cap_), hash_(o.hash_), eq_(o.eq_) {
+    o.table_.assign(table_.size(), cell{nullptr, nullptr, 0});
+}
+
+template <typename K, typename V, typename Hash, typename Eq, typename Policy>
+lru_cache<K, V, Hash, Eq, Policy>& lru_cache<K, V, Hash, Eq, Policy>::operator=(lru_cache&& o) {
+    if(this != &o) {
+        std::vector<cell> fresh(o.table_.size(), cell{nullptr, nullptr, 0});
+        hash_ = o.hash_;
+        eq_ = o.eq_;
+        q_ = std::move(o.q_);
+        table_ = std::move(o.table_);
+        o.table_ = std::move(fresh);
+        shift_ = o.shift_;
+        cap_ = o.cap_;
+    }
+    return *this;
+}
+
+//поиск с переносом в конец
+template <typename K, typename V, typename Hash, typename Eq, typename Policy>
+V* lru_cache<K, V, Hash, Eq, Policy>::get(const K& k) {
+    std::size_t i = find(k, hash_(k));
+    if(i == table_.size()) return nullptr;
+    touch(i);
+    return &table_[i].node->data.value;
+}
+
+template <typename K, typename V, typename Hash, typename Eq, typename Policy>
+const V* lru_cache<K, V, Hash, Eq, Policy>::peek(const K& k) const {
+    std::size_t i = find(k, hash_(k));
+    return i == table_.size() ? nullptr : &table_[i].node->data.value;
+}
+
+template <typename K, typename V, typename Hash, typename Eq, typename Policy>
+bool lru_cache<K, V, Hash, Eq, Policy>::contains(const K& k) const {
+    return find(k, hash_(k)) != table_.size();
+}
+
+//новый ключ при полном кэше занимает узел вытесненного, без new/delete
+template <typename K, typename V, typename Hash, typename Eq, typename Policy>
+bool lru_cache<K, V, Hash, Eq, Policy>::put(const K& k, V v) {
+    const std::size_t h = hash_(k);
+    std::size_t i = find(k, h);
+    if(i != table_.size()) {
+        table_[i].node->data.value = std::move(v);
+        touch(i);
+        return false;
+    }
+    Node* n;
+    if(q_.sz_ == cap_) {
+        std::size_t old = q_.front_->data.slot;
+        n = q_.front_;
+        unlink(old);
+        q_.sz_--;
+        remove_cell(old);
+        try {
+            n->data.key = k;
+            n->data.value = std::move(v);
+        } catch(...) {
+            q_.free_node(n);                //вытесненный уже вынут, кэш остаётся целым
+            throw;
+        }
+    } else {
+        n = q_.make_node(entry{k, std::move(v), 0});
+    }
+    i = home(h);
+    while(table_[i].node) i = (i + 1) & (table_.size() - 1);
+    table_[i] = cell{n, nullptr, h};
+    n->data.slot = i;
+    link_back(i);
+    q_.sz_++;
+    return true;
+}
+
+//удаление: узел вынимается и освобождается, ячейка закрывается сдвигом
+template <typename K, typename V, typename Hash, typename Eq, typename Policy>
+bool lru_cache<K, V, Hash, Eq, Policy>::erase(const K& k) {
+    std::size_t i = find(k, hash_(k));
+    if(i == table_.size()) return false;
+    Node* n = table_[i].node;
+    unlink(i);
+    q_.sz_--;
+    remove_cell(i);
+    q_.free_node(n);
+    return true;
+}
+
+template <typename K, typename V, typename Hash, typename Eq, typename Policy>
+const K& lru_cache<K, V, Hash, Eq, Policy>::lru_key() const {
+    if(q_.is_empty()) throw std::runtime_error("lru_cache empty");
+    return q_.get_front().key;
+}
+
+template <typename K, typename V, typename Hash, typename Eq, typename Policy>
+std::size_t lru_cache<K, V, Hash, Eq, Policy>::size() const { return q_.size(); }
+
+template <typename K, typename V, typename Hash, typename Eq, typename Policy>
+std::size_t lru_cache<K, V, Hash, Eq, Policy>::capacity() const { return cap_; }
+
+template <typename K, typename V, typename Hash, typename Eq, typename Policy>
+bool lru_cache<K, V, Hash, Eq, Policy>::is_empty() const { return q_.is_empty(); }
+
+template <typename K, typename V, typename Hash, typename Eq, typename Policy>
+bool lru_cache<K, V, Hash, Eq, Policy>::empty() const { return q_.is_empty(); }
+
+//очередь уже считает свой объект, поэтому он не удваивается
+template <typename K, typename V, typename Hash, typename Eq, typename Policy>
+std::size_t lru_cache<K, V, Hash, Eq, Policy>::memory_usage() const {
+    return sizeof(*this) - sizeof(q_) + q_.memory_usage() + heap_block_bytes(table_.capacity() * sizeof(cell));
+}
+
+//вспомогательные методы
+
+//фибоначчиево хеширование: старшие биты произведения, чтобы std::hash-тождество не давало кластеров
+template <typename K, typename V, typename Hash, typename Eq, typename Policy>
+std::size_t lru_cache<K, V, Hash, Eq, Policy>::home(std::size_t h) const {
+    return static_cast<std::size_t>((static_cast<std::uint64_t>(h) * 0x9E3779B97F4A7C15ull) >> shift_);
+}
+
+//пробирование до пустой ячейки; хеш сверяется раньше ключа, чтобы не читать чужие узлы
+template <typename K, typename V, typename Hash, typename Eq, typename Policy>
+std::size_t lru_cache<K, V, Hash, Eq, Policy>::find(const K& k, std::size_t h) const {
+    const std::size_t mask = table_.size() - 1;
+    for(std::size_t i = home(h); table_[i].node; i = (i + 1) & mask)
+        if(table_[i].hash == h && eq_(table_[i].node->data.key, k)) return i;
+    return table_.size();
+}
+
+//последний остаётся на месте
+template <typename K, typename V, typename Hash, typename Eq, typename Policy>
+void lru_cache<K, V, Hash, Eq, Policy>::touch(std::size_t i) {
+    if(table_[i].node == q_.back_) return;
+    unlink(i);
+    link_back(i);
+}
+
+//следующий узел получает нашего предыдущего
+template <typename K, typename V, typename Hash, typename Eq, typename Policy>
+void lru_cache<K, V, Hash, Eq, Policy>::unlink(std::size_t i) {
+    Node* n = table_[i].node;
+    Node* p = table_[i].prev;
+    Node* next = n->next;
+    if(p) p->next = next;
+    else q_.front_ = next;
+    if(next) table_[next->data.slot].prev = p;
+    else q_.back_ = p;
+}
+
+template <typename K, typename V, typename Hash, typename Eq, typename Policy>
+void lru_cache<K, V, Hash, Eq, Policy>::link_back(std::size_t i) {
+    Node* n = table_[i].node;
+    n->next = nullptr;
+    table_[i].prev = q_.back_;
+    if(q_.back_) q_.back_->next = n;
+    else q_.front_ = n;
+    q_.back_ = n;
+}
+
+//ячейки после i сдвигаются назад, если их начальная ячейка не лежит в (i, j]
+template <typename K, typename V, typename Hash, typename Eq, typename Policy>
+void lru_cache<K, V, Hash, Eq, Policy>::remove_cell(std::size_t i) {
+    const std::size_t mask = table_.size() - 1;
+    for(std::size_t j = (i + 1) & mask; table_[j].node; j = (j + 1) & mask) {
+        std::size_t h = home(table_[j].hash);
+        if(((j - h) & mask) >= ((j - i) & mask)) {
+            table_[i] = table_[j];
+            table_[i].node->data.slot = i;
+            i = j;
+        }
+    }
+    table_[i].node = nullptr;
+}
+
+#endif
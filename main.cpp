@@ -1,23 +1,58 @@
 #include <gtest/gtest.h>
 #include <sstream>
 #include <algorithm>
+#include <numeric>
 #include <string>
+#include <cstdint>
+#include <filesystem>
+#ifndef _WIN32
+#include <csignal>
+#include <sys/resource.h>
+#endif
+#include <limits>
+#include <list>
+#ifdef __cpp_lib_ranges
+#include <ranges>
+#endif
+#include <unordered_map>
+#include <fstream>
+#include <thread>
+#include <vector>
 #include "fwd_container.h"
 #include "stack.h"
 #include "queue.h"
-
-// 
-// 
+#include "wal_queue.h"
+#include "compressed_queue.h"
+#include "persistent_stack.h"
+#include "persistent_queue.h"
+#include "small_stack.h"
+#include "intrusive_stack.h"
+#include "intrusive_queue.h"
+#include "container_stats.h"
+#include "node_reclaimer.h"
+#include "static_stack.h"
+#include "simd_algorithms.h"
+#include "merge_sorted.h"
+#include "priority_queue.h"
+#include "aggregate_queue.h"
+#include "timing_wheel.h"
+#include "lru_cache.h"
+#include "list_view.h"
+#include "async_channel.h"
+#include "multi_queue.h"
+
+//тесты стека
+//проверка итераторов
 TEST(StackTest, Stack_Iterator)
 {
     stack<int> s;
     s.push(10);
     s.push(20);
-    s.push(30);                     // 30 -> 20 -> 10
+    s.push(30);                     //стек 30 -> 20 -> 10
 
-    stack<int>::const_iterator cit = s.cbegin(), ocit;      //  
-    EXPECT_EQ(*cit, 30);            // -  
-    ocit = ++cit;                   // 
+    stack<int>::const_iterator cit = s.cbegin(), ocit;      // конст итератор
+    EXPECT_EQ(*cit, 30);            //разыменование - верх стека
+    ocit = ++cit;                   //префиксный инкремент
     EXPECT_EQ(*cit, 20);
     EXPECT_EQ(*ocit, 20);
     ocit = cit++;
@@ -26,8 +61,8 @@ TEST(StackTest, Stack_Iterator)
     ++cit;
     EXPECT_EQ(cit, s.cend());
 
-    const stack<int>& r = s;        // 
-    cit = r.begin();                //begin()    const_iterator
+    const stack<int>& r = s;        //конст ссылка
+    cit = r.begin();                //begin() от конст возвращает const_iterator
     EXPECT_EQ(*cit, 30);
     ++cit;
     EXPECT_EQ(*cit, 20);
@@ -36,7 +71,7 @@ TEST(StackTest, Stack_Iterator)
     ++cit;
     EXPECT_EQ(cit, r.end());
 
-    stack<int>::iterator it = s.begin(), oit;       // 
+    stack<int>::iterator it = s.begin(), oit;       //неконст итератор
     EXPECT_EQ(*it, 30);
     oit = ++it;
     EXPECT_EQ(*it, 20);
@@ -55,7 +90,7 @@ TEST(StackTest, Stack_Iterator)
     EXPECT_EQ(sout.str(), "30 5 10");
 }
 
-//  range-based for
+// проверка range-based for
 TEST(StackTest, Stack_For)
 {
     stack<int> s;
@@ -70,7 +105,7 @@ TEST(StackTest, Stack_For)
 
     int expected2[] = {6, 4, 2};
     idx = 0;
-    for (auto& v : s) v *= 2;       //   for
+    for (auto& v : s) v *= 2;       // изменение через for
 
     idx = 0;
     for (const auto& v : s) EXPECT_EQ(v, expected2[idx++]);
@@ -91,7 +126,7 @@ TEST(StackTest, Stack_For)
         EXPECT_EQ(*it, expected3[idx++]);
 }
 
-//  push, pop, , 
+// проверка push, pop, копирования, перемещения
 TEST(StackTest, Stack_PushPopCopy)
 {
     stack<int> s;
@@ -103,7 +138,7 @@ TEST(StackTest, Stack_PushPopCopy)
     s.push(10);
     s.push(20);
 
-    stack<int> copy_s(s);           // 
+    stack<int> copy_s(s);           //конструктор копирования
 
     int expected_orig[] = {20, 10, 2, 1};
     int idx = 0;
@@ -122,13 +157,13 @@ TEST(StackTest, Stack_PushPopCopy)
     idx = 0;
     for (auto v : copy_s) EXPECT_EQ(v, expected_copy[idx++]);
 
-    stack<int> moved_s(std::move(copy_s));      //  
+    stack<int> moved_s(std::move(copy_s));      // конструктор перемещения
 
     int expected_moved[] = {97, 98, 99, 2, 1};
     idx = 0;
     for (auto v : moved_s) EXPECT_EQ(v, expected_moved[idx++]);
 
-    EXPECT_TRUE(copy_s.empty());    // move 
+    EXPECT_TRUE(copy_s.empty());    //после move пустой
 
     stack<int> s2;
     s2 = s;
@@ -140,14 +175,14 @@ TEST(StackTest, Stack_PushPopCopy)
     s2.push(99);
 
     idx = 0;
-    for (auto v : s) EXPECT_EQ(v, expected_orig[idx++]);    // 
+    for (auto v : s) EXPECT_EQ(v, expected_orig[idx++]);    //не изменился
 
     int expected_copy_asgn[] = {99, 42, 10, 2, 1};
     idx = 0;
     for (auto v : s2) EXPECT_EQ(v, expected_copy_asgn[idx++]);
 
     stack<int> s3;
-    s3 = std::move(s2);             // 
+    s3 = std::move(s2);             //присваивание перемещением
     idx = 0;
     for (auto v : s3) EXPECT_EQ(v, expected_copy_asgn[idx++]);
 
@@ -160,14 +195,14 @@ TEST(StackTest, Stack_PushPopCopy)
     for (auto v : s3) EXPECT_EQ(v, expected_final[idx++]);
 }
 
-//  /
+//проверка потокового ввода/вывода
 TEST(StackTest, Stack_IO)
 {
     stack<int> s;
     s.push(0);
 
     std::stringstream sin("1 2 3 4 5");
-    sin >> s;                       //  push
+    sin >> s;                       //читаем через push
 
     EXPECT_EQ(s.size(), 6);
 
@@ -176,7 +211,7 @@ TEST(StackTest, Stack_IO)
     for (auto v : s) EXPECT_EQ(v, expected[idx++]);
 
     std::stringstream sout;
-    sout << s;                      //   
+    sout << s;                      // выводим в поток
 
     std::string expected_str = "5 4 3 2 1 0";
     EXPECT_EQ(sout.str(), expected_str);
@@ -189,7 +224,7 @@ TEST(StackTest, Stack_IO)
     EXPECT_EQ(sout2.str(), expected_str2);
 }
 
-//    
+//проверка работы со стандартными алгоритмами
 TEST(StackTest, Stack_Algs)
 {
     stack<int> s;
@@ -197,31 +232,31 @@ TEST(StackTest, Stack_Algs)
     for (int i = 1; i <= 5; ++i) s.push(i);
 
     auto it = std::find_if(s.begin(), s.end(), [](int v){ return v % 2 == 0; });
-    EXPECT_EQ(*it, 4);              //  
-    *it = 3;                        //
+    EXPECT_EQ(*it, 4);              //нашли первое четное
+    *it = 3;                        //изменили
 
     const stack<int>& r = s;
     auto cit = std::find_if(r.begin(), r.end(), [](int v){ return v % 2 == 0; });
-    EXPECT_EQ(*cit, 2);             //   - 2
+    EXPECT_EQ(*cit, 2);             //теперь первое четное - 2
 
     it = std::find_if(s.begin(), s.end(), [](int v){ return v == 0; });
-    EXPECT_EQ(it, s.end());         //  -  end
+    EXPECT_EQ(it, s.end());         //не нашли - вернул end
 
     auto count_even = std::count_if(s.begin(), s.end(), [](int v){ return v % 2 == 0; });
-    EXPECT_EQ(count_even, 1);       // 
+    EXPECT_EQ(count_even, 1);       //посчитали четные
 
-    std::replace_if(s.begin(), s.end(), [](int v){ return v % 2 != 0; }, 99);   //  
+    std::replace_if(s.begin(), s.end(), [](int v){ return v % 2 != 0; }, 99);   // заменили нечетные
     int expected_replace[] = {99, 99, 99, 2, 99};
     int idx = 0;
     for (auto v : s) EXPECT_EQ(v, expected_replace[idx++]);
 
-    std::for_each(s.begin(), s.end(), [](int& v){ v += 1; });   // 1  
+    std::for_each(s.begin(), s.end(), [](int& v){ v += 1; });   //прибавили 1 к каждому
     int expected_for_each[] = {100, 100, 100, 3, 100};
     idx = 0;
     for (auto v : s) EXPECT_EQ(v, expected_for_each[idx++]);
 }
 
-//     
+// проверка полиморфизма через базовый класс
 TEST(ContainerTest, BaseContainer)
 {
     stack<int> s;
@@ -229,18 +264,18 @@ TEST(ContainerTest, BaseContainer)
 
     s.push(1);
     s.push(2);
-    s.push(3);                      // : 3 -> 2 -> 1
+    s.push(3);                      // стек: 3 -> 2 -> 1
     q.push(10);
     q.push(20);
-    q.push(30);                     // : 10 -> 20 -> 30
+    q.push(30);                     // очередь: 10 -> 20 -> 30
 
-    fwd_container<int>& bs = s;     //   
+    fwd_container<int>& bs = s;     //ссылка на базовый класс
     fwd_container<int>& bq = q;
     const fwd_container<int>& cs = s;
     const fwd_container<int>& cq = q;
     (void)cq;
 
-    bs = q;                         //   
+    bs = q;                         //присваивание через базовый класс
 
     int expected_s_after[] = {10, 20, 30};
     int idx = 0;
@@ -252,7 +287,7 @@ TEST(ContainerTest, BaseContainer)
     for (auto v : q) EXPECT_EQ(v, expected_q_after[idx++]);
 
     idx = 0;
-    for (auto& it : bs) EXPECT_EQ(it, expected_s_after[idx++]);     //  
+    for (auto& it : bs) EXPECT_EQ(it, expected_s_after[idx++]);     //итерация через базовый
 
     idx = 0;
     for (const auto& it : bs) EXPECT_EQ(it, expected_s_after[idx++]);
@@ -270,7 +305,95 @@ TEST(ContainerTest, BaseContainer)
     for (auto& it : bq) EXPECT_EQ(it, expected_q_after[idx++]);
 }
 
-// 
+//присваивание бросает, когда кончается запас
+struct Flaky {
+    static int left;
+    int v;
+    explicit Flaky(int x = 0): v(x) {}
+    Flaky(const Flaky&) = default;
+    Flaky& operator=(const Flaky& o) {
+        if (left-- == 0) throw std::runtime_error("flaky");
+        v = o.v;
+        return *this;
+    }
+};
+int Flaky::left = 0;
+
+// пакетные операции через базовый класс
+TEST(ContainerTest, BaseContainer_Batch)
+{
+    stack<int> s;
+    queue<int> q;
+    small_stack<int, 4> ss;             //реализация по умолчанию из fwd_container
+    fwd_container<int>* all[] = {&s, &q, &ss};
+
+    std::vector<int> src(10000);
+    for (int i = 0; i < 10000; ++i) src[i] = i;
+    for (fwd_container<int>* c : all) {
+        c->push(-1);
+        c->push_many(src.data(), src.size());
+        EXPECT_EQ(c->size(), 10001u);
+
+        //порции идут в порядке итераторов, можно остановиться раньше
+        std::vector<int> seen;
+        std::size_t chunks = 0;
+        c->for_each_chunk([&](const int* p, std::size_t n) {
+            seen.insert(seen.end(), p, p + n);
+            return ++chunks < 2;
+        });
+        EXPECT_TRUE(std::equal(seen.begin(), seen.end(), c->cbegin()));
+        long long sum = 0;
+        c->for_each_chunk([&](const int* p, std::size_t n) { for (std::size_t i = 0; i < n; ++i) sum += p[i]; });
+        EXPECT_EQ(sum, 9999LL * 10000 / 2 - 1);
+    }
+    EXPECT_EQ(s.get_front(), 9999);
+    EXPECT_EQ(q.get_front(), -1);
+
+    int out[3];
+    fwd_container<int>& bs = s;
+    fwd_container<int>& bq = q;
+    EXPECT_EQ(bs.pop_many(out, 3), 3u);
+    EXPECT_EQ(out[0], 9999); EXPECT_EQ(out[2], 9997);
+    EXPECT_EQ(bq.pop_many(out, 3), 3u);
+    EXPECT_EQ(out[0], -1); EXPECT_EQ(out[2], 1);
+    std::vector<int> rest(20000);
+    EXPECT_EQ(bq.pop_many(rest.data(), rest.size()), 9998u);
+    EXPECT_TRUE(q.empty());
+    q.push(7);                          //после полного снятия конец очереди сброшен
+    EXPECT_EQ(q.pop(), 7);
+
+    //нетривиальные элементы идут без копирования, по одному
+    queue<std::string> qs;
+    std::string words[] = {"a", "bb", "ccc"};
+    static_cast<fwd_container<std::string>&>(qs).push_many(words, 3);
+    std::string joined;
+    qs.for_each_chunk([&](const std::string* p, std::size_t n) { EXPECT_EQ(n, 1u); joined += *p; });
+    EXPECT_EQ(joined, "abbccc");
+
+    //присваивание бросило на третьем элементе: два сняты, размер сходится с цепочкой
+    Flaky::left = 100;
+    stack<Flaky> fs;
+    queue<Flaky> fq;
+    for (int i = 0; i < 5; ++i) { fs.push(Flaky(i)); fq.push(Flaky(i)); }
+    Flaky fo[5];
+    Flaky::left = 2;
+    EXPECT_THROW(fs.pop_many(fo, 5), std::runtime_error);
+    EXPECT_EQ(fs.size(), 3u);
+    EXPECT_EQ(std::distance(fs.begin(), fs.end()), 3);
+    EXPECT_EQ(fs.get_front().v, 2);
+    Flaky::left = 2;
+    EXPECT_THROW(fq.pop_many(fo, 5), std::runtime_error);
+    EXPECT_EQ(fq.size(), 3u);
+    EXPECT_EQ(std::distance(fq.begin(), fq.end()), 3);
+    Flaky::left = 100;
+    EXPECT_EQ(fq.pop_many(fo, 5), 3u);
+    EXPECT_EQ(fo[2].v, 4);
+    EXPECT_TRUE(fq.empty());
+    fq.push(Flaky(9));
+    EXPECT_EQ(fq.get_front().v, 9);
+}
+
+//тесты очереди
 
 TEST(QueueTest, Queue_Iterator)
 {
@@ -278,14 +401,14 @@ TEST(QueueTest, Queue_Iterator)
     q.push(10); q.push(20); q.push(30);
 
     queue<int>::const_iterator cit = q.cbegin();
-    EXPECT_EQ(*cit, 10);            //  
+    EXPECT_EQ(*cit, 10);            // первый элемент
     ++cit; EXPECT_EQ(*cit, 20);
     cit++; EXPECT_EQ(*cit, 30);
     ++cit; EXPECT_EQ(cit, q.cend());
 
     queue<int>::iterator it = q.begin();
     EXPECT_EQ(*it, 10);
-    ++it; *it = 5;                  // 20  5
+    ++it; *it = 5;                  //меняем 20 на 5
     std::stringstream sout;
     sout << q;
     EXPECT_EQ(sout.str(), "10 5 30");
@@ -315,24 +438,24 @@ TEST(QueueTest, Queue_PushPopCopy)
 {
     queue<int> q;
     q.push(1); q.push(2); q.push(3);
-    q.pop();                        // 1
-    q.push(10);                     //: 2 -> 3 -> 10
+    q.pop();                        //убрали 1
+    q.push(10);                     //очередь: 2 -> 3 -> 10
 
-    queue<int> copy(q);             //
+    queue<int> copy(q);             //копирование
     EXPECT_EQ(copy.size(), 3);
 
     int expected[] = {2, 3, 10};
     int idx = 0;
     for (auto v : copy) EXPECT_EQ(v, expected[idx++]);
 
-    queue<int> moved(std::move(copy));      //
+    queue<int> moved(std::move(copy));      //перемещение
     EXPECT_TRUE(copy.empty());
     EXPECT_EQ(moved.size(), 3);
 
     queue<int> q2;
     q2 = q;
     q2.push(99);
-    EXPECT_EQ(q.size(), 3);         //  
+    EXPECT_EQ(q.size(), 3);         //оригинал не изменился
     EXPECT_EQ(q2.size(), 4);
 }
 
@@ -355,10 +478,10 @@ TEST(QueueTest, Queue_Algs)
     for (int i = 1; i <= 5; ++i) q.push(i);
 
     auto it = std::find_if(q.begin(), q.end(), [](int v){ return v % 2 == 0; });
-    EXPECT_EQ(*it, 2);              //  
+    EXPECT_EQ(*it, 2);              // первое четное
 
     auto count = std::count_if(q.begin(), q.end(), [](int v){ return v > 3; });
-    EXPECT_EQ(count, 2);            // 4  5
+    EXPECT_EQ(count, 2);            // 4 и 5
 
     std::for_each(q.begin(), q.end(), [](int& v){ v *= 2; });
     int expected[] = {2, 4, 6, 8, 10};
@@ -366,7 +489,7 @@ TEST(QueueTest, Queue_Algs)
     for (auto v : q) EXPECT_EQ(v, expected[idx++]);
 }
 
-//   string ( )
+// тесты для string (проверка шаблона)
 
 TEST(StackStringTest, Stack_Iterator)
 {
@@ -379,7 +502,7 @@ TEST(StackStringTest, Stack_Iterator)
     ++cit; EXPECT_EQ(*cit, "a");
 
     stack<std::string>::iterator it = s.begin();
-    *it = "x";                      //  c  x
+    *it = "x";                      // меняем c на x
     std::stringstream sout;
     sout << s;
     EXPECT_EQ(sout.str(), "x b a");
@@ -403,7 +526,7 @@ TEST(StackStringTest, Stack_PushPopCopy)
 {
     stack<std::string> s;
     s.push("one"); s.push("two"); s.push("three");
-    s.pop();                        //  three
+    s.pop();                        // убрали three
 
     stack<std::string> copy(s);
     EXPECT_EQ(copy.size(), 2);
@@ -414,7 +537,7 @@ TEST(StackStringTest, Stack_PushPopCopy)
     stack<std::string> s2;
     s2 = s;
     s2.push("new");
-    EXPECT_EQ(s.size(), 2);         //   
+    EXPECT_EQ(s.size(), 2);         // оригинал не изменился
     EXPECT_EQ(s2.size(), 3);
 }
 
@@ -433,13 +556,1491 @@ TEST(StackStringTest, Stack_IO)
 TEST(StackStringTest, Stack_Algs)
 {
     stack<std::string> s;
-    s.push("aa"); s.push("bbb"); s.push("c");   // : c -> bbb -> aa
+    s.push("aa"); s.push("bbb"); s.push("c");   // стек: c -> bbb -> aa
 
     auto it = std::find_if(s.begin(), s.end(), [](const std::string& v){ return v.length() > 2; });
-    EXPECT_EQ(*it, "bbb");          //   2
+    EXPECT_EQ(*it, "bbb");          //нашли строку длиннее 2
 
     auto count = std::count_if(s.begin(), s.end(), [](const std::string& v){ return v.length() < 3; });
-    EXPECT_EQ(count, 2);            // c  aa
+    EXPECT_EQ(count, 2);            // c и aa
+}
+
+// тесты очереди с журналом
+
+//временный каталог под журнал, удаляется в конце теста
+struct TempDir {
+    std::filesystem::path path;
+    explicit TempDir(const char* name)
+        : path(std::filesystem::temp_directory_path() / name) { std::filesystem::remove_all(path); }
+    ~TempDir() { std::filesystem::remove_all(path); }
+};
+
+TEST(WalQueueTest, Wal_Replay)
+{
+    TempDir dir("fwd_wal_replay");
+    {
+        wal_queue<int> q(dir.path.string());
+        for (int i = 1; i <= 5; ++i) q.push(i);
+        EXPECT_EQ(q.pop(), 1);
+        EXPECT_EQ(q.pop(), 2);
+    }
+
+    wal_queue<int> q(dir.path.string());     //переоткрытие = восстановление после падения
+    EXPECT_EQ(q.size(), 3);
+    EXPECT_EQ(q.front(), 3);
+    q.push(6);
+    int expected[] = {3, 4, 5, 6};
+    for (int v : expected) EXPECT_EQ(q.pop(), v);
+    EXPECT_TRUE(q.is_empty());
+    EXPECT_THROW(q.pop(), std::runtime_error);
+}
+
+TEST(WalQueueTest, Wal_Checkpoint)
+{
+    TempDir dir("fwd_wal_ckpt");
+    wal_options opt;
+    opt.segment_bytes = 256;        //маленькие сегменты, чтобы ротация шла постоянно
+    opt.checkpoint_segments = 3;
+    {
+        wal_queue<std::string> q(dir.path.string(), opt);
+        for (int i = 0; i < 200; ++i) {
+            q.push("item" + std::to_string(i));
+            if (i % 3 == 0) q.pop();
+        }
+        EXPECT_LE(q.segment_count(), 3u);      //старые сегменты удалены
+        q.checkpoint();
+        EXPECT_EQ(q.segment_count(), 1u);
+    }
+
+    wal_queue<std::string> q(dir.path.string(), opt);
+    EXPECT_EQ(q.size(), 133u);
+    EXPECT_EQ(q.front(), "item67");
+}
+
+TEST(WalQueueTest, Wal_TornTail)
+{
+    TempDir dir("fwd_wal_torn");
+    {
+        wal_queue<int> q(dir.path.string());
+        q.push(1);
+        q.push(2);
+    }
+
+    //оборванная запись в конце последнего сегмента
+    std::filesystem::path last;
+    for (const auto& e : std::filesystem::directory_iterator(dir.path))
+        if (last.empty() || e.path() > last) last = e.path();
+    {
+        std::ofstream out(last, std::ios::binary | std::ios::app);
+        out.write("\x20\x00\x00\x00\x01garbage", 12);
+    }
+
+    {
+        wal_queue<int> q(dir.path.string());
+        EXPECT_EQ(q.size(), 2u);
+        q.push(3);
+    }
+    wal_queue<int> q(dir.path.string());
+    EXPECT_EQ(q.size(), 3u);
+}
+
+#ifndef _WIN32
+TEST(WalQueueTest, Wal_WriteFailure)
+{
+    TempDir dir("fwd_wal_fail");
+    {
+        wal_queue<int> q(dir.path.string());
+        q.push(1);
+        q.push(2);
+
+        //лимит размера файла по текущему сегменту: следующий write падает с EFBIG
+        std::uintmax_t bytes = 0;
+        for (auto& e : std::filesystem::directory_iterator(dir.path))
+            bytes = std::max(bytes, std::filesystem::file_size(e.path()));
+        rlimit old{};
+        ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &old), 0);
+        auto old_handler = std::signal(SIGXFSZ, SIG_IGN);
+        rlimit lim = old;
+        lim.rlim_cur = bytes;
+        ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &lim), 0);
+        EXPECT_THROW(q.push(3), std::runtime_error);
+        setrlimit(RLIMIT_FSIZE, &old);
+        std::signal(SIGXFSZ, old_handler);
+
+        //после ошибки состояние в памяти не показывается
+        EXPECT_THROW(q.front(), std::runtime_error);
+        EXPECT_THROW(q.size(), std::runtime_error);
+        EXPECT_THROW(q.is_empty(), std::runtime_error);
+        EXPECT_THROW(q.pop(), std::runtime_error);
+        int v;
+        EXPECT_THROW(q.try_pop(v), std::runtime_error);
+        EXPECT_THROW(q.push(4), std::runtime_error);
+    }
+
+    wal_queue<int> q(dir.path.string());     //на диске только то, что успело записаться
+    EXPECT_EQ(q.size(), 2u);
+    EXPECT_EQ(q.pop(), 1);
+    EXPECT_EQ(q.pop(), 2);
+}
+#endif
+
+TEST(WalQueueTest, Wal_GroupCommit)
+{
+    TempDir dir("fwd_wal_group");
+    wal_options opt;
+    opt.group_commit_window = std::chrono::microseconds(200);
+    {
+        wal_queue<long long> q(dir.path.string(), opt);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+            threads.emplace_back([&q, t]{ for (int i = 0; i < 50; ++i) q.push(t * 1000 + i); });
+        for (auto& th : threads) th.join();
+        EXPECT_EQ(q.size(), 200u);
+    }
+
+    wal_queue<long long> q(dir.path.string(), opt);
+    EXPECT_EQ(q.size(), 200u);
+    long long last[4] = {-1, -1, -1, -1};
+    while (!q.is_empty()) {         //порядок внутри одного потока сохраняется
+        long long v = q.pop();
+        EXPECT_GT(v % 1000, last[v / 1000]);
+        last[v / 1000] = v % 1000;
+    }
+}
+
+// тесты сжатой очереди
+
+TEST(CompressedQueueTest, Compressed_PushPop)
+{
+    compressed_queue<std::int64_t> q;
+    std::vector<std::int64_t> ref;
+    std::int64_t v = 1700000000000;
+    for (int i = 0; i < 5000; ++i) {        //несколько блоков, разности разного знака
+        v += (i % 7 == 0) ? -300 : 1000 + i;
+        q.push(v);
+        ref.push_back(v);
+    }
+    q.push(std::numeric_limits<std::int64_t>::min());   //крайние разности
+    q.push(std::numeric_limits<std::int64_t>::max());
+    ref.push_back(std::numeric_limits<std::int64_t>::min());
+    ref.push_back(std::numeric_limits<std::int64_t>::max());
+
+    EXPECT_EQ(q.size(), ref.size());
+    EXPECT_TRUE(std::equal(q.begin(), q.end(), ref.begin(), ref.end()));
+
+    for (std::size_t i = 0; i < 3000; ++i) EXPECT_EQ(q.pop(), ref[i]);
+    EXPECT_EQ(q.get_front(), ref[3000]);
+    EXPECT_TRUE(std::equal(q.begin(), q.end(), ref.begin() + 3000, ref.end()));
+
+    while (!q.is_empty()) q.pop();
+    EXPECT_THROW(q.pop(), std::runtime_error);
+    q.push(7);
+    EXPECT_EQ(q.get_front(), 7);
+}
+
+TEST(CompressedQueueTest, Compressed_CopyIO)
+{
+    compressed_queue<std::uint8_t> q;
+    q.push(250); q.push(3); q.push(255); q.push(0);
+    q.pop();
+
+    compressed_queue<std::uint8_t> copy(q);     //копия после pop сохраняет позицию чтения
+    std::stringstream sout;
+    sout << copy;
+    EXPECT_EQ(sout.str(), "3 255 0");
+
+    compressed_queue<std::uint8_t> moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved.size(), 3);
+
+    compressed_queue<std::uint8_t> q2;
+    q2 = q;
+    q2.push(1);
+    EXPECT_EQ(q.size(), 3);         //оригинал не изменился
+    EXPECT_EQ(q2.size(), 4);
+}
+
+TEST(CompressedQueueTest, Compressed_Memory)
+{
+    compressed_queue<std::int64_t> q;
+    for (std::int64_t i = 0; i < 100000; ++i) q.push(i * 3);
+    //разность 3 занимает байт, против 16+ байт узла queue<int64_t>
+    EXPECT_LT(q.memory_usage(), q.size() * 2);
+}
+
+// тесты персистентного стека
+
+TEST(PersistentStackTest, PStack_Versions)
+{
+    persistent_stack<int> s;
+    s.push(1); s.push(2); s.push(3);
+
+    persistent_stack<int> snap(s);      //снимок за O(1)
+    s.pop();
+    s.push(10);
+
+    std::stringstream sout;
+    sout << s << " | " << snap;
+    EXPECT_EQ(sout.str(), "10 2 1 | 3 2 1");
+
+    persistent_stack<int> snap2;
+    snap2 = snap;
+    snap2.push(4);
+    EXPECT_EQ(snap.size(), 3);
+    EXPECT_EQ(snap2.size(), 4);
+    EXPECT_EQ(snap2.pop(), 4);
+    EXPECT_EQ(snap2.pop(), 3);          //общий узел: значение копируется, snap не трогаем
+    EXPECT_EQ(snap.get_front(), 3);
+
+    persistent_stack<int> moved(std::move(snap2));
+    EXPECT_TRUE(snap2.empty());
+    EXPECT_EQ(moved.size(), 2);
+}
+
+TEST(PersistentStackTest, PStack_CopyOnWrite)
+{
+    persistent_stack<std::string> s;
+    s.push("a"); s.push("b"); s.push("c");
+    persistent_stack<std::string> snap(s);
+
+    s.get_front() = "x";                //отделяется только вершина
+    for (auto& v : s) v += "!";         //изменяемый обход отделяет всю цепочку
+
+    std::string expected_s[] = {"x!", "b!", "a!"};
+    std::string expected_snap[] = {"c", "b", "a"};
+    int idx = 0;
+    for (const auto& v : s) EXPECT_EQ(v, expected_s[idx++]);
+    idx = 0;
+    const persistent_stack<std::string>& r = snap;
+    for (auto& v : r) EXPECT_EQ(v, expected_snap[idx++]);
+
+    fwd_container<std::string>& base = snap;    //присваивание через базу
+    stack<std::string> plain;
+    plain.push("z");
+    base = plain;
+    EXPECT_EQ(snap.get_front(), "z");
+    EXPECT_EQ(s.size(), 3);
+}
+
+TEST(PersistentStackTest, PStack_History)
+{
+    persistent_stack<int> s;
+    std::vector<persistent_stack<int>> history;
+    for (int i = 0; i < 1000; ++i) {
+        history.push_back(s);
+        s.push(i);
+        if (i % 3 == 0) s.pop();
+    }
+    for (std::size_t i = 0; i < history.size(); i += 97) {  //каждая версия осталась прежней
+        std::size_t expected = i - (i + 2) / 3;
+        EXPECT_EQ(history[i].size(), expected);
+    }
+    history.clear();
+    EXPECT_EQ(s.size(), 666);
+}
+
+// тесты персистентной очереди
+
+TEST(PersistentQueueTest, PQueue_Fifo)
+{
+    persistent_queue<int> q;
+    std::vector<int> ref;
+    for (int i = 0; i < 100; ++i) {     //перемешиваем push и pop, чтобы развороты шли постоянно
+        q.push(i);
+        ref.push_back(i);
+        if (i % 3 == 0) {
+            EXPECT_EQ(q.pop(), ref.front());
+            ref.erase(ref.begin());
+        }
+    }
+    EXPECT_EQ(q.size(), ref.size());
+    EXPECT_EQ(q.get_front(), ref.front());
+
+    std::size_t idx = 0;
+    for (auto it = q.cbegin(); it != q.cend(); ++it) EXPECT_EQ(*it, ref[idx++]);
+    EXPECT_EQ(idx, ref.size());
+
+    while (!q.is_empty()) q.pop();
+    EXPECT_THROW(q.pop(), std::runtime_error);
+    EXPECT_THROW(q.get_front(), std::runtime_error);
+}
+
+TEST(PersistentQueueTest, PQueue_Snapshots)
+{
+    persistent_queue<std::string> q;
+    q.push("a"); q.push("b"); q.push("c");
+    persistent_queue<std::string> snap(q);      //O(1)
+
+    q.pop();
+    q.push("d");
+    persistent_queue<std::string> snap2;
+    snap2 = q;
+    q.pop(); q.pop();
+
+    std::stringstream sout;
+    sout << snap << " | " << snap2 << " | " << q;
+    EXPECT_EQ(sout.str(), "a b c | b c d | d");
+
+    //старая версия продолжает жить своей жизнью
+    snap.push("x");
+    EXPECT_EQ(snap.pop(), "a");
+    EXPECT_EQ(snap.size(), 3);
+    EXPECT_EQ(snap2.get_front(), "b");
+
+    persistent_queue<std::string> moved(std::move(snap));
+    EXPECT_TRUE(snap.empty());
+    std::stringstream sout2;
+    sout2 << moved;
+    EXPECT_EQ(sout2.str(), "b c x");
+}
+
+TEST(PersistentQueueTest, PQueue_Algs)
+{
+    persistent_queue<int> q;
+    for (int i = 1; i <= 10; ++i) q.push(i);
+    q.pop();
+
+    auto it = std::find_if(q.begin(), q.end(), [](int v){ return v % 4 == 0; });
+    EXPECT_EQ(*it, 4);
+    auto count = std::count_if(q.cbegin(), q.cend(), [](int v){ return v > 5; });
+    EXPECT_EQ(count, 5);
+}
+
+// тесты стека со встроенным буфером
+
+TEST(SmallStackTest, Small_Spill)
+{
+    small_stack<int, 4> s;
+    for (int i = 1; i <= 4; ++i) s.push(i);
+    EXPECT_TRUE(s.is_inline());
+    s.push(5);                          //переполнение - переезд в кучу
+    EXPECT_FALSE(s.is_inline());
+    EXPECT_EQ(s.capacity(), 8);
+
+    std::stringstream sout;
+    sout << s;
+    EXPECT_EQ(sout.str(), "5 4 3 2 1");
+
+    for (auto& v : s) v *= 10;
+    EXPECT_EQ(s.pop(), 50);
+    EXPECT_EQ(s.get_front(), 40);
+
+    auto it = std::find_if(s.begin(), s.end(), [](int v){ return v < 25; });
+    EXPECT_EQ(*it, 20);
+    EXPECT_EQ(std::count_if(s.cbegin(), s.cend(), [](int v){ return v > 15; }), 3);
+
+    while (!s.is_empty()) s.pop();
+    EXPECT_THROW(s.pop(), std::runtime_error);
+}
+
+TEST(SmallStackTest, Small_CopyMove)
+{
+    small_stack<std::string, 2> a;
+    a.push("x"); a.push("y");
+    small_stack<std::string, 2> b(a);       //копия во встроенном буфере
+    b.push("z");                            //b уходит в кучу, a нет
+    EXPECT_TRUE(a.is_inline());
+    EXPECT_FALSE(b.is_inline());
+
+    small_stack<std::string, 2> c(std::move(b));    //забираем массив из кучи
+    EXPECT_TRUE(b.empty());
+    EXPECT_FALSE(c.is_inline());
+    small_stack<std::string, 2> d(std::move(a));    //поэлементное перемещение
+    EXPECT_TRUE(a.empty());
+    EXPECT_TRUE(d.is_inline());
+
+    std::stringstream sout;
+    sout << c << " | " << d;
+    EXPECT_EQ(sout.str(), "z y x | y x");
+
+    fwd_container<std::string>& base = d;   //присваивание через базу сохраняет порядок
+    base = c;
+    std::stringstream sout2;
+    sout2 << d;
+    EXPECT_EQ(sout2.str(), "z y x");
+
+    d.push(d.get_front());
+    d.push(d.get_front());                  //ссылка на собственный элемент во время переезда
+    EXPECT_EQ(d.get_front(), "z");
+    EXPECT_EQ(d.size(), 5);
+}
+
+// тесты интрузивных контейнеров
+
+//элемент из пула: одно звено для стека, другое для очереди
+struct Job {
+    int id;
+    intrusive_hook<Job> hook;
+    intrusive_hook<Job> qhook;
+    explicit Job(int i = 0): id(i) {}
+};
+
+TEST(IntrusiveTest, Intrusive_Stack)
+{
+    Job pool[4] = {Job(1), Job(2), Job(3), Job(4)};
+    intrusive_stack<Job> s;
+    for (auto& j : pool) s.push(j);
+
+    EXPECT_EQ(s.size(), 4);
+    EXPECT_EQ(&s.get_front(), &pool[3]);    //в стеке сами элементы, не копии
+
+    int expected[] = {4, 3, 2, 1};
+    int idx = 0;
+    for (auto& j : s) EXPECT_EQ(j.id, expected[idx++]);
+
+    intrusive_stack<Job>::const_iterator cit = s.cbegin();
+    intrusive_stack<Job>::iterator it = s.begin();
+    EXPECT_EQ(cit, it);
+    ++it;
+    EXPECT_NE(cit, it);
+    it->id = 30;
+    EXPECT_EQ(pool[2].id, 30);
+
+    Job& top = s.pop();
+    EXPECT_EQ(&top, &pool[3]);
+    s.push(top);                            //после pop элемент можно класть снова
+
+    intrusive_stack<Job> moved(std::move(s));
+    EXPECT_TRUE(s.empty());
+    EXPECT_EQ(moved.size(), 4);
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+    EXPECT_THROW(moved.pop(), std::runtime_error);
+}
+
+TEST(IntrusiveTest, Intrusive_Queue)
+{
+    Job pool[3] = {Job(1), Job(2), Job(3)};
+    intrusive_queue<Job, &Job::qhook> q;
+    intrusive_stack<Job> s;
+    for (auto& j : pool) {                  //один элемент сразу в двух контейнерах через разные звенья
+        q.push(j);
+        s.push(j);
+    }
+
+    int idx = 1;
+    for (const auto& j : q) EXPECT_EQ(j.id, idx++);
+    EXPECT_EQ(std::count_if(q.begin(), q.end(), [](const Job& j){ return j.id > 1; }), 2);
+
+    EXPECT_EQ(q.pop().id, 1);
+    q.push(pool[0]);
+    idx = 0;
+    int expected[] = {2, 3, 1};
+    for (auto& j : q) EXPECT_EQ(j.id, expected[idx++]);
+    EXPECT_EQ(s.get_front().id, 3);         //стек не пострадал
+
+    EXPECT_THROW(q.push(pool[1]), std::logic_error);   //повторная вставка ловится и с NDEBUG
+    EXPECT_THROW(s.push(pool[1]), std::logic_error);
+
+    //копия лежащего элемента свободна, присваивание не отвязывает приёмник
+    Job copy = pool[1];
+    EXPECT_FALSE(copy.qhook.linked);
+    EXPECT_EQ(copy.qhook.next, nullptr);
+    q.push(copy);
+    EXPECT_EQ(q.size(), 4);
+    pool[2] = pool[0];
+    EXPECT_EQ(pool[2].id, 1);
+    EXPECT_TRUE(pool[2].qhook.linked);
+    idx = 0;
+    int after[] = {2, 1, 1, 2};
+    for (auto& j : q) EXPECT_EQ(j.id, after[idx++]);
+    EXPECT_EQ(idx, 4);
+    q.clear();
+    s.clear();
+}
+
+// тесты статистики контейнеров
+
+//свои записи реестра, чтобы тесты не мешали друг другу
+struct stack_stats_tag { static constexpr const char* name = "test_stack"; };
+struct queue_stats_tag { static constexpr const char* name = "test_queue"; };
+struct stack_stats_policy : default_policy { using stats = counted_stats<stack_stats_tag>; };
+struct queue_stats_policy : default_policy { using stats = counted_stats<queue_stats_tag>; };
+
+TEST(StatsTest, Stats_Stack)
+{
+    container_stats& st = counted_stats<stack_stats_tag>::stats();
+    st.reset();
+    {
+        stack<int, stack_stats_policy> s;
+        s.push(1);
+        s.push(2);
+        s.push(3);
+        EXPECT_EQ(s.pop(), 3);
+
+        stack<int, stack_stats_policy> c(s);            //2 узла
+        int sum = 0;
+        for (auto it = c.cbegin(), e = c.cend(); it != e; ++it) sum += *it;    //2 итератора
+        EXPECT_EQ(sum, 3);
+        s = c;                                          //2 освобождения и 2 выделения
+    }                                                   //ещё 4 освобождения
+
+    EXPECT_EQ(st.pushes.load(), 3u);
+    EXPECT_EQ(st.pops.load(), 1u);
+    EXPECT_EQ(st.node_allocs.load(), 7u);
+    EXPECT_EQ(st.node_frees.load(), 7u);
+    EXPECT_EQ(st.iter_allocs.load(), 2u);
+    EXPECT_EQ(st.copies.load(), 1u);
+    EXPECT_EQ(st.assigns.load(), 1u);
+    EXPECT_EQ(st.max_size.load(), 3u);
+
+    //выключенная статистика не занимает места в объекте
+    static_assert(!default_policy::stats::enabled, "статистика по умолчанию выключена");
+    EXPECT_EQ(sizeof(stack<int>), sizeof(stack<int, stack_stats_policy>));
+}
+
+TEST(StatsTest, Stats_QueueRegistry)
+{
+    container_stats& st = counted_stats<queue_stats_tag>::stats();
+    st.reset();
+
+    queue<std::string, queue_stats_policy> q;
+    std::istringstream in("a b c d");
+    in >> q;
+
+    queue<std::string, queue_stats_policy> q2;
+    fwd_container<std::string>& base = q2;
+    base = q;                                           //присваивание через базу: 4 push в q2
+    EXPECT_EQ(q2.size(), 4u);
+
+    EXPECT_EQ(st.pushes.load(), 8u);
+    EXPECT_EQ(st.assigns.load(), 1u);
+    EXPECT_EQ(st.max_size.load(), 4u);
+    EXPECT_GT(st.iter_allocs.load(), 0u);
+
+    EXPECT_EQ(stats_registry::instance().find("test_queue"), &st);
+    EXPECT_EQ(stats_registry::instance().find("no_such_entry"), nullptr);
+
+    counted_stats<stack_stats_tag>::stats();            //вторая запись в реестре
+    std::ostringstream out;
+    stats_registry::instance().dump(out);
+    EXPECT_NE(out.str().find("test_queue: push=8 pop=0 node_alloc=8"), std::string::npos);
+    EXPECT_NE(out.str().find("test_stack: "), std::string::npos);
+}
+
+// тесты подсчёта памяти
+
+TEST(MemoryTest, Memory_Usage)
+{
+    stack<int> s;
+    queue<int> q;
+    const std::size_t empty_stack = s.memory_usage();
+    EXPECT_EQ(empty_stack, sizeof(stack<int>));
+    EXPECT_EQ(q.memory_usage(), sizeof(queue<int>));
+
+    s.push(1);
+    const std::size_t node = s.memory_usage() - empty_stack;    //узел int + next с заголовком malloc
+    EXPECT_GE(node, sizeof(int) + sizeof(void*));
+    EXPECT_EQ(node % 16, 0u);
+    for (int i = 2; i <= 10; ++i) s.push(i);
+    EXPECT_EQ(s.memory_usage(), empty_stack + 10 * node);
+
+    for (int i = 0; i < 10; ++i) q.push(i);
+    EXPECT_EQ(q.memory_usage(), sizeof(queue<int>) + 10 * node);
+
+    //строка в куче добавляет свой буфер, короткая живёт в SSO
+    stack<std::string> ss;
+    ss.push("x");
+    const std::size_t short_str = ss.memory_usage();
+    ss.pop();
+    ss.push(std::string(100, 'x'));
+    EXPECT_GE(ss.memory_usage(), short_str + 101);
+    EXPECT_EQ(heap_usage<std::string>::bytes(std::string("x")), 0u);
+
+    //через базу: наследник считает своё, а у базы по умолчанию только элементы
+    const fwd_container<std::string>& base = ss;
+    EXPECT_EQ(base.memory_usage(), ss.memory_usage());
+
+    small_stack<int, 4> sm;
+    for (int i = 0; i < 4; ++i) sm.push(i);
+    EXPECT_EQ(sm.memory_usage(), sizeof(sm));                   //всё во встроенном буфере
+    sm.push(4);
+    EXPECT_EQ(sm.memory_usage(), sizeof(sm) + heap_block_bytes(8 * sizeof(int)));
+
+    EXPECT_EQ(heap_block_bytes(1), 32u);
+    EXPECT_EQ(heap_block_bytes(24), 32u);
+    EXPECT_EQ(heap_block_bytes(25), 48u);
+}
+
+// тесты раскладки узлов
+
+TEST(LayoutTest, Layout_Policies)
+{
+    //узел {next, int64} занимает 16 байт, {next, 24 байта} - 32, {next, 100 байт} упирается в строку
+    static_assert(node_alignment<long long>(0) == alignof(void*), "обычное выравнивание");
+    static_assert(node_alignment<long long>(node_align_line) == 16, "степень двойки по размеру узла");
+    static_assert(node_alignment<char[24]>(node_align_line) == 32, "узел 32 байта");
+    static_assert(node_alignment<char[100]>(node_align_line) == cache_line_size, "не больше строки кэша");
+    static_assert(node_alignment<int>(128) == 128, "явное выравнивание");
+
+    queue<std::string, cache_line_policy> q;
+    stack<std::string, prefetch_policy> s;
+    for (int i = 0; i < 100; ++i) {
+        q.push(std::to_string(i));
+        s.push(std::to_string(i));
+    }
+    queue<std::string, cache_line_policy> qc(q);
+    stack<std::string, prefetch_policy> sc(s);
+
+    int idx = 0;
+    for (const auto& v : qc) EXPECT_EQ(v, std::to_string(idx++));
+    EXPECT_EQ(idx, 100);
+    for (const auto& v : sc) EXPECT_EQ(v, std::to_string(--idx));
+
+    std::ostringstream out;
+    out << q;
+    EXPECT_EQ(out.str().substr(0, 6), "0 1 2 ");
+
+    //узлы действительно выровнены: адреса элементов кратны выравниванию узла
+    for (const auto& v : q)
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&v) % node_alignment<std::string>(node_align_line), sizeof(void*));
+}
+
+// тесты узлов из арены
+
+TEST(ArenaTest, Arena_StackQueue)
+{
+    stack<int, arena_policy> s;
+    for (int i = 0; i < 10000; ++i) s.push(i);
+    for (int i = 0; i < 100; ++i) EXPECT_EQ(s.pop(), 9999 - i);
+    const std::size_t mem = s.memory_usage();
+    for (int i = 0; i < 100; ++i) s.push(i);            //снятые узлы используются снова
+    EXPECT_EQ(s.memory_usage(), mem);
+    EXPECT_EQ(s.size(), 10000u);
+
+    stack<int, arena_policy> copy(s);
+    EXPECT_EQ(copy.size(), s.size());
+    EXPECT_TRUE(std::equal(copy.cbegin(), copy.cend(), s.cbegin()));
+
+    stack<int, arena_policy> moved(std::move(copy));    //узлы переезжают вместе с блоками
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved.get_front(), 99);
+    copy.push(1);                                       //после перемещения хранилище снова рабочее
+    EXPECT_EQ(copy.pop(), 1);
+
+    moved = s;
+    moved = std::move(s);
+    EXPECT_EQ(moved.size(), 10000u);
+
+    queue<long long, arena_policy> q;
+    for (long long i = 0; i < 1000; ++i) q.push(i);
+    queue<long long, arena_policy> q2;
+    q2 = std::move(q);
+    for (long long i = 0; i < 500; ++i) EXPECT_EQ(q2.pop(), i);
+    q2.push(-1);
+    EXPECT_EQ(q2.size(), 501u);
+    fwd_container<long long>& base = q;
+    base = q2;                                          //присваивание через базу
+    EXPECT_EQ(q.size(), 501u);
+
+    q2 = queue<long long, arena_policy>();              //очистка блоками
+    EXPECT_TRUE(q2.empty());
+    EXPECT_EQ(q2.memory_usage(), sizeof(q2));
+}
+
+// тесты фонового освобождения узлов
+
+TEST(DeferredTest, Deferred_Reclaim)
+{
+    node_reclaimer& r = node_reclaimer::instance();
+    {
+        queue<std::string, deferred_policy> q;
+        for (int i = 0; i < 100000; ++i) q.push(std::string(40, 'a' + i % 26));
+        stack<std::string, deferred_policy> s;
+        for (int i = 0; i < 1000; ++i) s.push(std::to_string(i));
+        s = stack<std::string, deferred_policy>();      //цепочка ушла уборщику, контейнер снова пуст
+        EXPECT_TRUE(s.empty());
+        s.push("x");
+        EXPECT_EQ(s.pop(), "x");
+        EXPECT_EQ(q.get_front(), std::string(40, 'a'));
+    }
+    r.flush();
+    EXPECT_EQ(r.pending(), 0u);
+
+    //сверх предела отставания цепочка удаляется сразу в вызывающем потоке
+    const std::size_t limit = r.max_pending();
+    r.set_max_pending(10);
+    {
+        queue<std::string, deferred_policy> q;
+        for (int i = 0; i < 100; ++i) q.push(std::to_string(i));
+    }
+    EXPECT_EQ(r.pending(), 0u);
+
+    //одновременные retire не выходят за предел: уборщик стоит на первой цепочке,
+    //остальные либо влезают в предел, либо удаляются на месте
+    static std::atomic<bool> gate;
+    static std::atomic<int> freed;
+    gate = false;
+    freed = 0;
+    static int dummy;
+    node_reclaimer::free_fn blocking = [](void*, std::size_t) -> void* {
+        while (!gate) std::this_thread::yield();
+        return nullptr;
+    };
+    node_reclaimer::free_fn counting = [](void*, std::size_t) -> void* { ++freed; return nullptr; };
+    r.set_max_pending(100);
+    r.retire(&dummy, 1, blocking);
+    std::vector<std::thread> ts;
+    for (int t = 0; t < 4; ++t)
+        ts.emplace_back([&] { for (int i = 0; i < 50; ++i) r.retire(&dummy, 10, counting); });
+    for (auto& t : ts) t.join();
+    EXPECT_LE(r.pending(), 100u);
+    gate = true;
+    r.flush();
+    EXPECT_EQ(freed, 200);
+    EXPECT_EQ(r.pending(), 0u);
+    r.set_max_pending(limit);
+}
+
+// тесты стека фиксированной вместимости
+
+//вычисление выражения в обратной польской записи во время компиляции
+constexpr int rpn(const char* e)
+{
+    static_stack<int, 16> s;
+    for (; *e; ++e) {
+        if (*e >= '0' && *e <= '9') { s.push(*e - '0'); continue; }
+        if (*e == ' ') continue;
+        int b = s.pop(), a = s.pop();
+        s.push(*e == '+' ? a + b : *e == '-' ? a - b : a * b);
+    }
+    return s.pop();
+}
+
+//скобки сбалансированы
+constexpr bool balanced(const char* e)
+{
+    static_stack<char, 32> s;
+    for (; *e; ++e) {
+        if (*e == '(' || *e == '[') s.push(*e == '(' ? ')' : ']');
+        else if (*e == ')' || *e == ']') {
+            if (s.empty() || s.pop() != *e) return false;
+        }
+    }
+    return s.empty();
+}
+
+//сумма при обходе от вершины, с весом позиции
+constexpr int weighted()
+{
+    static_stack<int, 4> s{1, 2, 3};
+    int sum = 0, k = 1;
+    for (int v : s) sum += v * k++;
+    return sum;
+}
+
+TEST(StaticStackTest, StaticStack_Constexpr)
+{
+    static_assert(rpn("3 4 + 2 *") == 14, "rpn");
+    static_assert(rpn("9 5 - 7 *") == 28, "rpn");
+    static_assert(balanced("([()[]])") && !balanced("(]") && !balanced("(("), "balanced");
+    static_assert(weighted() == 3 * 1 + 2 * 2 + 1 * 3, "обход от вершины");
+    static_assert(static_stack<int, 3>{1, 2} == static_stack<int, 8>{1, 2}, "равенство при разной вместимости");
+    static_assert(static_stack<int, 3>{1, 2} != static_stack<int, 3>{2, 1}, "порядок важен");
+    static_assert(static_stack<int, 3>{5} < static_stack<int, 3>{1, 6}, "сравнение от вершины");
+    static_assert(static_stack<int, 3>{} < static_stack<int, 3>{0}, "пустой меньше");
+    static_assert(static_stack<int, 3>::capacity() == 3, "вместимость");
+    static_assert(sizeof(static_stack<int, 8>) == 8 * sizeof(int) + sizeof(std::size_t), "без лишних полей");
+    static_assert(!std::is_polymorphic<static_stack<int, 8>>::value, "без виртуальных функций");
+
+    //то же во время выполнения
+    const std::string expr = "12+3*";
+    EXPECT_EQ(rpn(expr.c_str()), 9);
+
+    static_stack<std::string, 3> s;
+    s.push("a");
+    s.push(std::string("b"));
+    s.push("c");
+    EXPECT_TRUE(s.full());
+    EXPECT_THROW(s.push("d"), std::length_error);
+    auto it = s.begin();
+    *it += "!";
+    EXPECT_EQ(s.get_front(), "c!");
+    static_stack<std::string, 3> copy(s);
+    EXPECT_EQ(copy, s);
+    EXPECT_EQ(s.pop(), "c!");
+    EXPECT_EQ(s.size(), 2u);
+    EXPECT_NE(copy, s);
+    EXPECT_TRUE(s < copy);
+    std::vector<std::string> out(copy.cbegin(), copy.cend());
+    EXPECT_EQ(out, (std::vector<std::string>{"c!", "b", "a"}));
+    s.clear();
+    EXPECT_THROW(s.pop(), std::runtime_error);
+    EXPECT_THROW(s.get_front(), std::runtime_error);
+}
+
+// тесты векторных алгоритмов
+
+TEST(SimdTest, Simd_Kernels)
+{
+    //векторные ядра совпадают со скалярными на всех длинах хвоста
+    std::vector<int> vi;
+    std::vector<double> vd;
+    for (int n = 0; n < 70; ++n) {
+        vi.push_back((n * 7919) % 61 - 30);
+        vd.push_back(((n * 7919) % 61 - 30) * 0.5);
+        for (int v : {-30, 0, 7, 100}) {
+            EXPECT_EQ(simd_kernel<int>::find(vi.data(), vi.size(), v), scalar_kernel<int>::find(vi.data(), vi.size(), v));
+            EXPECT_EQ(simd_kernel<int>::count(vi.data(), vi.size(), v), scalar_kernel<int>::count(vi.data(), vi.size(), v));
+            EXPECT_EQ(simd_kernel<double>::find(vd.data(), vd.size(), v * 0.5), scalar_kernel<double>::find(vd.data(), vd.size(), v * 0.5));
+            EXPECT_EQ(simd_kernel<double>::count(vd.data(), vd.size(), v * 0.5), scalar_kernel<double>::count(vd.data(), vd.size(), v * 0.5));
+        }
+        EXPECT_EQ(simd_kernel<int>::sum(vi.data(), vi.size()), scalar_kernel<int>::sum(vi.data(), vi.size()));
+        EXPECT_EQ(simd_kernel<double>::sum(vd.data(), vd.size()), scalar_kernel<double>::sum(vd.data(), vd.size()));
+        EXPECT_EQ(simd_kernel<int>::min(vi.data(), vi.size()), scalar_kernel<int>::min(vi.data(), vi.size()));
+        EXPECT_EQ(simd_kernel<int>::max(vi.data(), vi.size()), scalar_kernel<int>::max(vi.data(), vi.size()));
+        EXPECT_EQ(simd_kernel<double>::min(vd.data(), vd.size()), scalar_kernel<double>::min(vd.data(), vd.size()));
+        EXPECT_EQ(simd_kernel<double>::max(vd.data(), vd.size()), scalar_kernel<double>::max(vd.data(), vd.size()));
+    }
+    //сумма int не переполняется
+    std::vector<int> big(100, std::numeric_limits<int>::max());
+    EXPECT_EQ(simd_kernel<int>::sum(big.data(), big.size()), 100LL * std::numeric_limits<int>::max());
+}
+
+TEST(SimdTest, Simd_Containers)
+{
+    queue<int> q;
+    stack<double> s;
+    small_stack<int, 8> ss;
+    for (int i = 0; i < 10000; ++i) {
+        q.push(i % 1000 - 500);
+        s.push(i * 0.25);
+        ss.push(i % 1000 - 500);
+    }
+    EXPECT_EQ(fwd_find(q, 0), 500u);
+    EXPECT_EQ(fwd_find(q, 5000), q.size());
+    EXPECT_EQ(fwd_count(q, 0), 10u);
+    EXPECT_EQ(fwd_sum(q), std::accumulate(q.cbegin(), q.cend(), 0LL));
+    EXPECT_EQ(fwd_min(q), *std::min_element(q.cbegin(), q.cend()));
+    EXPECT_EQ(fwd_max(ss), 499);
+    EXPECT_EQ(fwd_count(ss, -500), 10u);
+    EXPECT_EQ(fwd_find(s, 2499.75), 0u);                   //вершина
+    EXPECT_EQ(fwd_find(s, 0.0), 9999u);
+    EXPECT_EQ(fwd_sum(s), 0.25 * 9999 * 10000 / 2);
+    EXPECT_EQ(fwd_max(s), 2499.75);
+    EXPECT_TRUE(fwd_any_of(s, [](double v) { return v > 2499.5; }));
+    EXPECT_FALSE(fwd_any_of(q, [](int v) { return v > 499; }));
+    EXPECT_THROW(fwd_min(stack<int>()), std::runtime_error);
+}
+
+// тесты сортировки очереди
+
+TEST(QueueTest, Queue_Sort)
+{
+    //слияние: устойчиво, узлы те же
+    queue<std::pair<int, int>> q;
+    for (int i = 0; i < 1000; ++i) q.push({(i * 7919) % 10, i});
+    std::vector<const void*> nodes;
+    for (const auto& v : q) nodes.push_back(&v);
+    q.sort([](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; });
+    EXPECT_EQ(q.size(), 1000u);
+    std::vector<std::pair<int, int>> got(q.cbegin(), q.cend());
+    EXPECT_TRUE(std::is_sorted(got.begin(), got.end()));     //при равных ключах второе поле растёт
+    std::vector<const void*> after;
+    for (const auto& v : q) after.push_back(&v);
+    std::sort(nodes.begin(), nodes.end());
+    std::sort(after.begin(), after.end());
+    EXPECT_EQ(nodes, after);                                //ничего не выделено и не скопировано
+    q.push({-1, -1});                                       //конец очереди указывает на последний узел
+    EXPECT_EQ(q.size(), 1001u);
+    std::pair<int, int> last;
+    for (const auto& v : q) last = v;
+    EXPECT_EQ(last.first, -1);
+
+    queue<std::string> qs;
+    for (const char* w : {"pear", "apple", "fig", "kiwi"}) qs.push(w);
+    qs.sort(std::greater<std::string>());
+    std::ostringstream out;
+    out << qs;
+    EXPECT_EQ(out.str(), "pear kiwi fig apple");
+
+    //поразрядная: знаковые ключи и пропуск одинаковых разрядов
+    queue<long long> qi;
+    for (long long i = 0; i < 5000; ++i) qi.push((i * 2654435761LL) % 100003 - 50000);
+    qi.push(std::numeric_limits<long long>::min());
+    qi.push(std::numeric_limits<long long>::max());
+    std::vector<long long> expect(qi.cbegin(), qi.cend());
+    std::sort(expect.begin(), expect.end());
+    qi.sort();
+    EXPECT_TRUE(std::equal(expect.begin(), expect.end(), qi.cbegin()));
+    qi.push(0);
+    EXPECT_EQ(qi.size(), expect.size() + 1);
+
+    //поразрядная по ключу тоже устойчива
+    q.radix_sort([](const std::pair<int, int>& v) { return -v.second; });
+    EXPECT_EQ(q.get_front().second, 999);
+
+    queue<int> empty;
+    empty.sort();
+    EXPECT_TRUE(empty.empty());
+
+    //сравнение или ключ бросили посреди сортировки: все элементы на месте, конец очереди верный
+    auto fill = [](queue<int>& qt) { for (int i = 0; i < 40; ++i) qt.push(i * 37 % 41); };
+    auto intact = [](queue<int>& qt) {
+        std::vector<int> got(qt.cbegin(), qt.cend());
+        std::sort(got.begin(), got.end());
+        std::vector<int> want;
+        for (int i = 0; i < 40; ++i) want.push_back(i * 37 % 41);
+        std::sort(want.begin(), want.end());
+        EXPECT_EQ(qt.size(), 40u);
+        EXPECT_EQ(got, want);
+        qt.push(-1);
+        int tail = 0;
+        for (int v : qt) tail = v;
+        EXPECT_EQ(tail, -1);
+    };
+    for (int fail = 1; fail < 120; fail += 3) {
+        int calls = 0;
+        queue<int> qc;
+        fill(qc);
+        EXPECT_THROW(qc.sort([&](int a, int b) {
+            if (++calls == fail) throw std::runtime_error("cmp");
+            return a > b;
+        }), std::runtime_error);
+        intact(qc);
+
+        calls = 0;
+        queue<int> qk;
+        fill(qk);
+        if (fail < 40) {                    //ключ зовётся по разу на узел за проход
+            EXPECT_THROW(qk.radix_sort([&](int v) {
+                if (++calls == fail) throw std::runtime_error("key");
+                return v;
+            }), std::runtime_error);
+            intact(qk);
+        }
+    }
+}
+
+// тесты слияния отсортированных очередей
+
+TEST(QueueTest, Queue_MergeSorted)
+{
+    for (std::size_t k : {1u, 2u, 5u, 16u}) {
+        std::vector<queue<std::pair<int, int>>> qs(k);
+        std::vector<queue<std::pair<int, int>>*> in;
+        std::vector<std::pair<int, int>> expect;
+        for (std::size_t i = 0; i < k; ++i) {
+            for (int v = 0; v < 50; v += static_cast<int>(i % 3) + 1) {
+                qs[i].push({v, static_cast<int>(i)});
+                expect.push_back({v, static_cast<int>(i)});
+            }
+            in.push_back(&qs[i]);
+        }
+        std::sort(expect.begin(), expect.end());    //при равных значениях - по номеру входа
+
+        queue<std::pair<int, int>> out;
+        out.push({-1, -1});                         //результат дописывается в конец
+        merge_sorted(in, out, [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; });
+        EXPECT_EQ(out.size(), expect.size() + 1);
+        EXPECT_EQ(out.pop().first, -1);
+        EXPECT_TRUE(std::equal(expect.begin(), expect.end(), out.cbegin()));
+        for (const auto& q : qs) EXPECT_TRUE(q.empty());
+        out.push({100, 0});                         //конец выхода - последний перецепленный узел
+        std::pair<int, int> last;
+        for (const auto& v : out) last = v;
+        EXPECT_EQ(last.first, 100);
+    }
+
+    //пустые входы и вход, совпадающий с выходом
+    queue<int> a, b, out;
+    a.push(3);
+    queue<int>* in[] = {&a, &b};
+    merge_sorted(in, 2, out);
+    EXPECT_EQ(out.pop(), 3);
+    EXPECT_TRUE(out.empty());
+    queue<int>* bad[] = {&a, &out};
+    EXPECT_THROW(merge_sorted(bad, 2, out), std::runtime_error);
+
+#ifdef __cpp_lib_span
+    //span любого вида: из вектора указателей и из массива
+    a.push(1);
+    b.push(2);
+    std::vector<queue<int>*> v = {&a, &b};
+    merge_sorted(std::span<queue<int>*>(v), out);
+    queue<int>* arr[] = {&b, &a};
+    b.push(0);
+    merge_sorted(std::span(arr), out, std::less<int>());
+    std::vector<int> got(out.cbegin(), out.cend());
+    EXPECT_EQ(got, std::vector<int>({1, 2, 0}));
+    out = queue<int>();
+#endif
+
+    //сравнение бросило: ни один узел не потерян, размер и конец выхода верны
+    for (int fail = 1; fail < 48; ++fail) {
+        queue<int> x, y, z, res;
+        for (int i = 0; i < 10; ++i) { x.push(i * 3); y.push(i * 3 + 1); z.push(i * 3 + 2); }
+        res.push(-1);
+        queue<int>* src[] = {&x, &y, &z};
+        int calls = 0;
+        EXPECT_THROW(merge_sorted(src, 3, res, [&](int l, int r) {
+            if (++calls == fail) throw std::runtime_error("cmp");
+            return l < r;
+        }), std::runtime_error);
+        std::vector<int> all;
+        for (queue<int>* q : {&res, &x, &y, &z}) {
+            EXPECT_EQ(static_cast<std::size_t>(std::distance(q->cbegin(), q->cend())), q->size());
+            all.insert(all.end(), q->cbegin(), q->cend());
+        }
+        std::sort(all.begin(), all.end());
+        EXPECT_EQ(all.size(), 31u);
+        EXPECT_EQ(all.front(), -1);
+        EXPECT_EQ(all.back(), 29);
+        if (fail <= 2) { EXPECT_EQ(x.size(), 10u); }    //первый турнир: входы ещё не тронуты
+        res.push(100);
+        int last = 0;
+        for (int w : res) last = w;
+        EXPECT_EQ(last, 100);
+    }
+}
+
+// тесты очереди с приоритетом
+
+template <std::size_t D>
+void check_heap_order()
+{
+    std::vector<int> src;
+    for (int i = 0; i < 1000; ++i) src.push_back((i * 7919) % 1009);
+    priority_queue<int, std::less<int>, D> pq;
+    for (int v : src) pq.push(v);
+    priority_queue<int, std::less<int>, D> built(src.begin(), src.end());
+    std::sort(src.begin(), src.end(), std::greater<int>());
+    for (int v : src) {
+        EXPECT_EQ(pq.pop(), v);
+        EXPECT_EQ(built.pop(), v);
+    }
+    EXPECT_TRUE(pq.empty() && built.empty());
+}
+
+TEST(PriorityQueueTest, PriorityQueue_Order)
+{
+    check_heap_order<2>();
+    check_heap_order<4>();
+    check_heap_order<8>();
+
+    //наименьший первым и строки
+    priority_queue<std::string, std::greater<std::string>> pq;
+    for (const char* w : {"pear", "apple", "fig", "kiwi"}) pq.push(w);
+    EXPECT_EQ(pq.get_front(), "apple");
+    EXPECT_EQ(pq.push_pop("banana"), "apple");
+    EXPECT_EQ(pq.push_pop("aaa"), "aaa");               //меньше вершины - куча не меняется
+    EXPECT_EQ(pq.replace_top("zzz"), "banana");
+    EXPECT_EQ(pq.pop(), "fig");
+    EXPECT_EQ(pq.size(), 3u);
+    EXPECT_THROW(priority_queue<int>().replace_top(1), std::runtime_error);
+    EXPECT_THROW(priority_queue<int>().pop(), std::runtime_error);
+    EXPECT_EQ(priority_queue<int>().push_pop(5), 5);
+}
+
+TEST(PriorityQueueTest, PriorityQueue_Base)
+{
+    priority_queue<int> pq;
+    pq.reserve(100);
+    EXPECT_GE(pq.capacity(), 100u);
+    fwd_container<int>& b = pq;
+    for (int i = 0; i < 10; ++i) b.push(i);
+    int big[] = {50, 40, 30};
+    b.push_many(big, 3);
+    EXPECT_EQ(b.get_front(), 50);
+    int counted = 0;
+    for (int v : b) counted += v >= 0;                  //обход всех элементов в порядке массива
+    EXPECT_EQ(counted, 13);
+
+    std::vector<int> many(100);
+    for (int i = 0; i < 100; ++i) many[i] = 1000 + i;
+    b.push_many(many.data(), many.size());              //пакет больше кучи - перестройка
+    EXPECT_EQ(b.pop(), 1099);
+
+    stack<int> s;
+    for (int i = 0; i < 5; ++i) s.push(i * 3);
+    b = s;                                              //присваивание через базу строит кучу
+    EXPECT_EQ(pq.size(), 5u);
+    EXPECT_EQ(pq.pop(), 12);
+
+    priority_queue<int> copy(pq);
+    priority_queue<int> moved(std::move(copy));
+    EXPECT_EQ(moved.pop(), 9);
+    EXPECT_GE(moved.memory_usage(), sizeof(moved) + 3 * sizeof(int));
+}
+
+// тесты очереди со свёрткой окна
+
+TEST(AggregateQueueTest, AggregateQueue_Window)
+{
+    aggregate_queue<long long> sum;
+    aggregate_queue<int, agg_min<int>> mn;
+    aggregate_queue<int, agg_max<int>> mx;
+    std::deque<int> window;
+    const std::size_t w = 37;
+    for (int i = 0; i < 2000; ++i) {
+        int v = (i * 7919) % 1009 - 500;
+        if (i % 5 == 0) v = 3;                          //повторы: равные кандидаты в монотонной очереди
+        sum.push(v);
+        mn.push(v);
+        mx.push(v);
+        window.push_back(v);
+        if (window.size() > w) {
+            EXPECT_EQ(sum.pop(), window.front());
+            EXPECT_EQ(mn.pop(), window.front());
+            EXPECT_EQ(mx.pop(), window.front());
+            window.pop_front();
+        }
+        EXPECT_EQ(sum.aggregate(), std::accumulate(window.begin(), window.end(), 0LL));
+        EXPECT_EQ(mn.aggregate(), *std::min_element(window.begin(), window.end()));
+        EXPECT_EQ(mx.aggregate(), *std::max_element(window.begin(), window.end()));
+        EXPECT_EQ(sum.get_front(), window.front());
+        EXPECT_EQ(mn.get_front(), window.front());
+    }
+    EXPECT_EQ(sum.size(), w);
+    EXPECT_EQ(mx.size(), w);
+
+    //некоммутативная операция: склейка строк в порядке очереди
+    struct concat {
+        std::string operator()(const std::string& a, const std::string& b) const { return a + b; }
+    };
+    aggregate_queue<std::string, concat> q;
+    for (const char* s : {"a", "b", "c"}) q.push(s);
+    EXPECT_EQ(q.pop(), "a");                            //перенос во front_
+    q.push("d");
+    EXPECT_EQ(q.aggregate(), "bcd");
+    EXPECT_EQ(q.get_front(), "b");
+    while (!q.empty()) q.pop();
+    EXPECT_THROW(q.aggregate(), std::runtime_error);
+    EXPECT_THROW((aggregate_queue<int, agg_min<int>>().aggregate()), std::runtime_error);
+}
+
+TEST(QueueTest, Queue_Splice)
+{
+    queue<int> a, b;
+    for (int i = 0; i < 3; ++i) a.push(i);
+    for (int i = 3; i < 6; ++i) b.push(i);
+    const int* p = &b.get_front();
+    a.splice_one(b);
+    EXPECT_EQ(p, &*(++++++a.cbegin()));     //узел не копировался
+    a.splice(b);
+    EXPECT_TRUE(b.is_empty());
+    EXPECT_EQ(a.size(), 6u);
+    b.push(7);                              //b после splice исправна
+    b.splice(a);
+    int expect[] = {7, 0, 1, 2, 3, 4, 5};
+    EXPECT_TRUE(std::equal(b.cbegin(), b.cend(), std::begin(expect), std::end(expect)));
+    EXPECT_THROW(a.splice_one(a), std::runtime_error);
+    a.splice(a);
+    EXPECT_TRUE(a.is_empty());
+}
+
+TEST(TimingWheelTest, TimingWheel_Expire)
+{
+    //маленькое колесо: 4 корзины на 3 уровнях, задержки до 64 тактов, дальше - через переполнение
+    timing_wheel<int, default_policy, 2, 3> w;
+    std::vector<std::uint64_t> due(2000);
+    std::vector<timer_handle> h(due.size());
+    std::vector<bool> cancelled(due.size());
+    std::size_t fired = 0;
+    auto on_fire = [&](int v) {
+        EXPECT_EQ(w.now(), due[v]) << v;
+        EXPECT_FALSE(cancelled[v]) << v;
+        EXPECT_FALSE(w.active(h[v]));
+        fired++;
+    };
+    for (std::size_t i = 0; i < due.size(); ++i) {
+        std::uint64_t d = i * 7919 % 300;
+        due[i] = w.now() + (d ? d : 1);
+        h[i] = w.schedule(d, int(i));
+        if (i % 7 == 0) w.advance(1, on_fire);
+    }
+    std::size_t n_cancelled = 0;
+    for (std::size_t i = 0; i < due.size(); i += 3) n_cancelled += cancelled[i] = w.cancel(h[i]);
+    EXPECT_GT(n_cancelled, 0u);
+    EXPECT_EQ(w.size() + fired + n_cancelled, due.size());
+    w.advance(400, on_fire);
+    EXPECT_EQ(fired + n_cancelled, due.size());
+    EXPECT_TRUE(w.empty());
+    EXPECT_EQ(w.pending(), 0u);
+    EXPECT_FALSE(w.cancel(h[0]));
+
+    //наименьшее допустимое колесо - два уровня; задержка намного дальше его охвата
+    timing_wheel<int, default_policy, 1, 2> tiny;
+    tiny.schedule(100, 1);
+    tiny.schedule(3, 2);
+    std::vector<std::uint64_t> at;
+    tiny.advance(200, [&](int) { at.push_back(tiny.now()); });
+    EXPECT_EQ(at, std::vector<std::uint64_t>({3, 100}));
+
+    //таймер из колбэка и повторное использование ячейки
+    timing_wheel<std::string> s;
+    timer_handle a = s.schedule(0, "a");
+    std::string log;
+    timer_handle ab;
+    s.advance(1, [&](std::string v) { log += v; ab = s.schedule(70000, v + "b"); });
+    s.schedule(5, "c");
+    EXPECT_EQ(ab.id, a.id);                 //ячейка сработавшего таймера уже свободна
+    EXPECT_FALSE(s.active(a));
+    EXPECT_TRUE(s.active(ab));
+    EXPECT_FALSE(s.cancel(a));
+    s.advance(70000, [&](std::string v) { log += v; });
+    EXPECT_EQ(log, "acab");
+    EXPECT_FALSE(s.cancel(timer_handle{}));
+
+    //перемещённое колесо снова пустое и годно к работе
+    timing_wheel<int> wa;
+    timer_handle t1 = wa.schedule(5, 1);
+    wa.advance(2, [](int) {});
+    timing_wheel<int> wb = std::move(wa);
+    EXPECT_TRUE(wa.empty());
+    EXPECT_EQ(wa.now(), 0u);
+    EXPECT_EQ(wa.pending(), 0u);
+    EXPECT_FALSE(wa.active(t1));
+    wa.schedule(5, 2);
+    int moved = 0;
+    wa.advance(5, [&](int v) { EXPECT_EQ(v, 2); moved++; });
+    wb.advance(3, [&](int v) { EXPECT_EQ(v, 1); moved++; });
+    EXPECT_EQ(moved, 2);
+    wa.schedule(1, 3);
+    wb = std::move(wa);
+    EXPECT_TRUE(wa.empty());
+    wa.schedule(1, 4);
+    wb.advance(1, [&](int v) { EXPECT_EQ(v, 3); moved++; });
+    wa.advance(1, [&](int v) { EXPECT_EQ(v, 4); moved++; });
+    EXPECT_EQ(moved, 4);
+}
+
+TEST(LruCacheTest, LruCache_Reference)
+{
+    //сверка с эталоном на std::list + std::unordered_map
+    const std::size_t cap = 50;
+    lru_cache<int, int> c(cap);
+    std::list<std::pair<int, int>> order;
+    std::unordered_map<int, std::list<std::pair<int, int>>::iterator> index;
+    for (int step = 0; step < 20000; ++step) {
+        int k = (step * 7919 % 157) ^ (step % 13);
+        int* got = c.get(k);
+        auto it = index.find(k);
+        ASSERT_EQ(got != nullptr, it != index.end()) << step;
+        if (got) {
+            EXPECT_EQ(*got, it->second->second);
+            order.splice(order.end(), order, it->second);
+        }
+        if (step % 5 == 0) {
+            EXPECT_EQ(c.erase(k), it != index.end());
+            if (it != index.end()) { order.erase(it->second); index.erase(it); }
+        } else if (!got) {
+            EXPECT_TRUE(c.put(k, step));
+            if (order.size() == cap) { index.erase(order.front().first); order.pop_front(); }
+            index[k] = order.insert(order.end(), {k, step});
+        } else if (step % 3 == 0) {
+            EXPECT_FALSE(c.put(k, -step));
+            it->second->second = -step;
+            order.splice(order.end(), order, it->second);
+        }
+        ASSERT_EQ(c.size(), order.size());
+        if (!order.empty()) {
+            EXPECT_EQ(c.lru_key(), order.front().first);
+        }
+    }
+    for (auto& kv : order) EXPECT_EQ(*c.peek(kv.first), kv.second);
+}
+
+TEST(LruCacheTest, LruCache_Basic)
+{
+    lru_cache<std::string, std::string> c(2);
+    c.put("a", "1");
+    c.put("b", "2");
+    EXPECT_EQ(*c.get("a"), "1");            //b теперь самый давний
+    c.put("c", "3");
+    EXPECT_FALSE(c.contains("b"));
+    EXPECT_TRUE(c.contains("a"));
+    EXPECT_EQ(c.lru_key(), "a");
+    EXPECT_EQ(c.peek("x"), nullptr);
+    EXPECT_TRUE(c.erase("a"));
+    EXPECT_FALSE(c.erase("a"));
+    EXPECT_EQ(c.lru_key(), "c");
+    EXPECT_TRUE(c.erase("c"));
+    EXPECT_TRUE(c.empty());
+    EXPECT_THROW(c.lru_key(), std::runtime_error);
+    EXPECT_THROW((lru_cache<int, int>(0)), std::runtime_error);
+
+    lru_cache<int, int> one(1);
+    one.put(1, 1);
+    one.put(2, 2);
+    EXPECT_EQ(one.get(1), nullptr);
+    EXPECT_EQ(*one.get(2), 2);
+
+    //перемещённый кэш пуст, сохраняет вместимость и годен к работе
+    lru_cache<int, int> a(4);
+    a.put(1, 1);
+    lru_cache<int, int> b = std::move(a);
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(a.capacity(), 4u);
+    EXPECT_FALSE(a.contains(1));
+    for(int i = 2; i < 8; ++i) a.put(i, i);
+    EXPECT_EQ(a.size(), 4u);
+    EXPECT_EQ(a.lru_key(), 4);
+    EXPECT_EQ(*b.get(1), 1);
+    lru_cache<int, int> c2(1);
+    c2.put(9, 9);
+    c2 = std::move(a);
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(c2.size(), 4u);
+    EXPECT_EQ(*c2.get(7), 7);
+    EXPECT_FALSE(c2.contains(9));
+    a.put(10, 10);
+    EXPECT_EQ(*a.get(10), 10);
+    lru_cache<int, int>& self = b;
+    b = std::move(self);
+    EXPECT_EQ(*b.get(1), 1);
+}
+
+#ifdef __cpp_lib_ranges
+TEST(RangesTest, Ranges_Views)
+{
+    static_assert(std::forward_iterator<fwd_container<int>::iterator>);
+    static_assert(std::forward_iterator<fwd_container<int>::const_iterator>);
+    static_assert(std::ranges::forward_range<queue<int>>);
+    static_assert(std::ranges::forward_range<const stack<int>>);
+    static_assert(std::ranges::sized_range<decltype(queue<int>().view())>);
+    static_assert(std::ranges::view<decltype(queue<int>().view())>);
+    static_assert(std::ranges::borrowed_range<decltype(stack<int>().view())>);
+    static_assert(std::is_same_v<decltype(std::declval<const queue<int>&>().view().begin()), decltype(as_view(std::declval<const queue<int>&>()).begin())>);
+
+    queue<int> q;
+    stack<int> s;
+    for (int i = 0; i < 20; ++i) { q.push(i); s.push(i); }
+    auto pipeline = std::views::filter([](int x) { return x % 3 == 0; })
+                  | std::views::transform([](int x) { return x * x; })
+                  | std::views::take(4);
+
+    std::vector<int> expect{0, 9, 36, 81};
+    EXPECT_TRUE(std::ranges::equal(q.view() | pipeline, expect));
+    EXPECT_TRUE(std::ranges::equal(q | pipeline, expect));      //полиморфные итераторы
+    EXPECT_TRUE(std::ranges::equal(q | as_view | pipeline, expect));
+    EXPECT_TRUE(std::ranges::equal(s | as_view | pipeline, std::vector<int>{324, 225, 144, 81}));
+
+    //через базовый класс as_view берёт полиморфные итераторы
+    const fwd_container<int>& base = s;
+    EXPECT_EQ(std::ranges::distance(base | as_view), 20);
+    EXPECT_EQ(*std::ranges::max_element(base), 19);
+
+    //изменение элементов через вид
+    for (int& x : q.view()) x = -x;
+    EXPECT_EQ(q.get_front(), 0);
+    EXPECT_EQ(*std::ranges::next(q.view().begin(), 5), -5);
+    EXPECT_EQ(std::ranges::count_if(std::as_const(q).view(), [](int x) { return x < 0; }), 19);
+    EXPECT_EQ(q.view().size(), 20u);
+    EXPECT_TRUE(queue<int>().view().empty());
+}
+#endif
+
+namespace {
+
+task produce(async_channel<int>& ch, int n, std::vector<std::size_t>& sizes)
+{
+    for (int i = 0; i < n; ++i) {
+        if (!co_await ch.push(i)) co_return;    //канал закрыли, пока ждали
+        sizes.push_back(ch.size());
+    }
+    ch.close();
+}
+
+task consume(async_channel<int>& ch, std::vector<int>& got)
+{
+    while (auto v = co_await ch.pop()) got.push_back(*v);
+}
+
+task fail(event_loop& loop)
+{
+    co_await loop.yield();
+    throw std::runtime_error("fail");
+}
+
+}
+
+TEST(AsyncChannelTest, AsyncChannel_Backpressure)
+{
+    for (std::size_t cap : {0u, 1u, 3u}) {
+        event_loop loop;
+        async_channel<int> ch(loop, cap);
+        std::vector<int> got;
+        std::vector<std::size_t> sizes;
+        loop.spawn(produce(ch, 100, sizes));
+        loop.spawn(consume(ch, got));
+        loop.run();
+        EXPECT_TRUE(loop.idle());
+        std::vector<int> expect(100);
+        std::iota(expect.begin(), expect.end(), 0);
+        EXPECT_EQ(got, expect) << cap;
+        EXPECT_LE(*std::max_element(sizes.begin(), sizes.end()), cap);
+    }
+
+    //производитель без потребителя останавливается на полном буфере
+    event_loop loop;
+    async_channel<int> ch(loop, 2);
+    std::vector<std::size_t> sizes;
+    loop.spawn(produce(ch, 5, sizes));
+    loop.run();
+    EXPECT_EQ(ch.size(), 2u);
+    EXPECT_EQ(sizes.size(), 2u);
+    EXPECT_EQ(ch.try_pop(), 0);                 //место занял ждущий push
+    EXPECT_EQ(ch.size(), 2u);
+    loop.run();
+    EXPECT_EQ(sizes.size(), 3u);
+    int x = 7;
+    EXPECT_FALSE(ch.try_push(x));
+    EXPECT_EQ(x, 7);
+    ch.close();
+    loop.run();                                 //ждущий push получил false
+    EXPECT_EQ(sizes.size(), 3u);
+    EXPECT_FALSE(ch.try_push(8));
+    EXPECT_EQ(ch.try_pop(), 1);
+    EXPECT_EQ(ch.try_pop(), 2);
+    EXPECT_EQ(ch.try_pop(), std::nullopt);
+
+    //исключение из корутины выходит из run
+    loop.spawn(fail(loop));
+    EXPECT_THROW(loop.run(), std::runtime_error);
+    EXPECT_EQ(loop.run(), 0u);
+}
+
+TEST(MultiQueueTest, MultiQueue_Threads)
+{
+    multi_queue<int> one(3);
+    for (int i = 0; i < 10; ++i) one.push(i);
+    EXPECT_EQ(one.size(), 10u);
+    int v = -1;
+    for (int i = 0; i < 10; ++i) {              //один поток - один шард, порядок FIFO
+        ASSERT_TRUE(one.try_pop(v));
+        EXPECT_EQ(v, i);
+    }
+    EXPECT_FALSE(one.try_pop(v));
+    EXPECT_TRUE(one.empty());
+
+    //каждый элемент ровно один раз, у каждого производителя порядок сохраняется
+    const int producers = 4, consumers = 4, per = 20000;
+    multi_queue<std::pair<int, int>> q(4);
+    std::atomic<int> popped{0};
+    std::vector<std::vector<std::pair<int, int>>> got(consumers);
+    std::vector<std::thread> ts;
+    for (int p = 0; p < producers; ++p)
+        ts.emplace_back([&, p] { for (int i = 0; i < per; ++i) q.push({p, i}); });
+    for (int c = 0; c < consumers; ++c)
+        ts.emplace_back([&, c] {
+            std::pair<int, int> x;
+            while (popped.load() < producers * per)
+                if (q.try_pop(x)) { got[c].push_back(x); popped++; }
+                else std::this_thread::yield();
+        });
+    for (auto& t : ts) t.join();
+    std::vector<int> seen(producers * per);
+    for (auto& g : got) {
+        std::vector<int> last(producers, -1);
+        for (auto [p, i] : g) {
+            EXPECT_GT(i, last[p]);
+            last[p] = i;
+            seen[p * per + i]++;
+        }
+    }
+    EXPECT_EQ(std::count(seen.begin(), seen.end(), 1), producers * per);
+    EXPECT_TRUE(q.empty());
 }
 
 int main(int argc, char** argv)
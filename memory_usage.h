@@ -0,0 +1,47 @@
+#ifndef MEMORY_USAGE_H
+#define MEMORY_USAGE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+//подсчёт памяти для memory_usage()
+
+//сколько байт кучи на самом деле уходит на запрос new/malloc размера n
+//модель glibc x86-64: запрос + 8 байт заголовка, кратно 16, не меньше 32
+inline std::size_t heap_block_bytes(std::size_t n) {
+    std::size_t c = (n + sizeof(std::size_t) + 15) & ~std::size_t(15);
+    return c < 32 ? 32 : c;
+}
+
+//точка настройки: память в куче, которой владеет значение (сверх sizeof(T))
+//для своего типа достаточно специализировать heap_usage<T> с bytes() и none = false
+template <typename T>
+struct heap_usage {
+    static constexpr bool none = true;      //у T нет своей памяти - обход элементов можно пропустить
+    static std::size_t bytes(const T&) { return 0; }
+};
+
+//строка: буфер в куче, если не влезла во встроенный (SSO)
+template <typename C, typename Tr, typename A>
+struct heap_usage<std::basic_string<C, Tr, A>> {
+    static constexpr bool none = false;
+    static std::size_t bytes(const std::basic_string<C, Tr, A>& s) {
+        static const std::size_t sso = std::basic_string<C, Tr, A>().capacity();
+        return s.capacity() > sso ? heap_block_bytes((s.capacity() + 1) * sizeof(C)) : 0;
+    }
+};
+
+//вектор: массив в куче и всё, чем владеют его элементы
+template <typename U, typename A>
+struct heap_usage<std::vector<U, A>> {
+    static constexpr bool none = false;
+    static std::size_t bytes(const std::vector<U, A>& v) {
+        std::size_t n = v.capacity() ? heap_block_bytes(v.capacity() * sizeof(U)) : 0;
+        if(!heap_usage<U>::none)
+            for(const auto& e : v) n += heap_usage<U>::bytes(e);
+        return n;
+    }
+};
+
+#endif
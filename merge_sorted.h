@@ -0,0 +1,50 @@
+#ifndef MERGE_SORTED_H
+#define MERGE_SORTED_H
+
+#include "queue.h"
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <vector>
+#if __has_include(<span>)
+#include <span>
+#endif
+
+//слияние k отсортированных очередей деревом проигравших: O(log k) сравнений на элемент
+//узлы перецепляются из входов в выход без копирования, входы остаются пустыми
+//при равных элементах первым идёт элемент из входа с меньшим номером (устойчиво)
+template <typename T, typename Policy, typename Compare>
+class loser_tree {
+    using Q = queue<T, Policy>;
+    using Node = typename Q::Node;
+
+    std::vector<Node*> cur_;            //текущая голова каждого входа, nullptr - вход кончился
+    std::vector<std::size_t> tree_;     //tree_[0] - победитель, tree_[1..k) - проигравшие во внутренних узлах
+    Compare& cmp_;
+
+public:
+    loser_tree(Q* const* in, std::size_t k, Compare& cmp);
+
+    void merge_into(Q& out);            //все элементы по порядку в конец out
+
+private:
+    bool before(std::size_t a, std::size_t b) const;    //голова a идёт раньше головы b
+    void build();
+};
+
+//in[0..k) - отсортированные по cmp очереди; результат добавляется в конец out
+template <typename T, typename Policy, typename Compare = std::less<T>>
+void merge_sorted(queue<T, Policy>* const* in, std::size_t k, queue<T, Policy>& out, Compare cmp = Compare());
+
+template <typename T, typename Policy, typename Compare = std::less<T>>
+void merge_sorted(const std::vector<queue<T, Policy>*>& in, queue<T, Policy>& out, Compare cmp = Compare());
+
+#ifdef __cpp_lib_span
+//T и Policy выводятся из out, поэтому подходит любой span указателей и массив через std::span(arr)
+template <typename T, typename Policy, typename Compare = std::less<T>>
+void merge_sorted(std::type_identity_t<std::span<queue<T, Policy>* const>> in, queue<T, Policy>& out, Compare cmp = Compare());
+#endif
+
+#include "merge_sorted_impl.h"
+
+#endif
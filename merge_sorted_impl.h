@@ -0,0 +1,116 @@
+#ifndef MERGE_SORTED_IMPL_H
+#define MERGE_SORTED_IMPL_H
+
+//реализация loser_tree
+
+//цепочки входов забираются сразу, сами очереди становятся пустыми
+//первый турнир - до того, как входы опустели: если cmp бросил, входы не тронуты
+template <typename T, typename Policy, typename Compare>
+loser_tree<T, Policy, Compare>::loser_tree(Q* const* in, std::size_t k, Compare& cmp)
+    : cur_(k), tree_(k ? k : 1), cmp_(cmp) {
+    static_assert(Q::portable_nodes, "merge_sorted: узлы этого хранилища нельзя переносить между очередями");
+    for(std::size_t i = 0; i < k; ++i) cur_[i] = in[i]->front_;
+    build();
+    for(std::size_t i = 0; i < k; ++i) {
+        in[i]->front_ = in[i]->back_ = nullptr;
+        in[i]->sz_ = 0;
+    }
+}
+
+//вход a раньше входа b; кончившийся вход проигрывает всем, при равенстве выигрывает меньший номер
+//одно сравнение cmp: для a < b равенство в пользу a, иначе нужно строгое cur[a] < cur[b]
+template <typename T, typename Policy, typename Compare>
+bool loser_tree<T, Policy, Compare>::before(std::size_t a, std::size_t b) const {
+    const Node* x = cur_[a];
+    const Node* y = cur_[b];
+    if(!y) return x || a < b;
+    if(!x) return false;
+    if(a < b) return !cmp_(y->data, x->data);
+    return cmp_(x->data, y->data);
+}
+
+//турнир снизу вверх: листья k..2k-1, у узла n дети 2n и 2n+1
+template <typename T, typename Policy, typename Compare>
+void loser_tree<T, Policy, Compare>::build() {
+    const std::size_t k = cur_.size();
+    tree_[0] = 0;
+    if(k < 2) return;
+    std::vector<std::size_t> win(2 * k);
+    for(std::size_t i = 0; i < k; ++i) win[k + i] = i;
+    for(std::size_t n = k - 1; n > 0; --n) {
+        std::size_t a = win[2 * n], b = win[2 * n + 1];
+        if(before(a, b)) {
+            win[n] = a;
+            tree_[n] = b;
+        } else {
+            win[n] = b;
+            tree_[n] = a;
+        }
+    }
+    tree_[0] = win[1];
+}
+
+//победитель уходит в выход, его вход сдвигается, и он переигрывает только свой путь до корня
+template <typename T, typename Policy, typename Compare>
+void loser_tree<T, Policy, Compare>::merge_into(Q& out) {
+    const std::size_t k = cur_.size();
+    Node** link = out.front_ ? &out.back_->next : &out.front_;
+    Node* last = out.back_;
+    std::size_t moved = 0;
+    try {
+        while(k) {
+            std::size_t w = tree_[0];
+            Node* n = cur_[w];
+            if(!n) break;
+            *link = n;
+            link = &n->next;
+            last = n;
+            ++moved;
+            cur_[w] = n->next;
+            Q::prefetch_next(n);
+            for(std::size_t p = (w + k) / 2; p > 0; p /= 2)
+                if(before(tree_[p], w)) std::swap(tree_[p], w);
+            tree_[0] = w;
+        }
+    } catch(...) {
+        //cmp бросил: недослитые остатки входов дописываются в out как есть, узлы не теряются
+        for(Node*& c : cur_) {
+            for(; c; c = c->next) {
+                *link = c;
+                link = &c->next;
+                last = c;
+                ++moved;
+            }
+        }
+        out.back_ = last;
+        out.sz_ += moved;
+        throw;
+    }
+    *link = nullptr;
+    out.back_ = last;
+    out.sz_ += moved;
+}
+
+//слияние
+
+template <typename T, typename Policy, typename Compare>
+void merge_sorted(queue<T, Policy>* const* in, std::size_t k, queue<T, Policy>& out, Compare cmp) {
+    for(std::size_t i = 0; i < k; ++i)
+        if(in[i] == &out) throw std::runtime_error("merge_sorted: out is one of the inputs");
+    loser_tree<T, Policy, Compare> t(in, k, cmp);
+    t.merge_into(out);
+}
+
+template <typename T, typename Policy, typename Compare>
+void merge_sorted(const std::vector<queue<T, Policy>*>& in, queue<T, Policy>& out, Compare cmp) {
+    merge_sorted(in.data(), in.size(), out, cmp);
+}
+
+#ifdef __cpp_lib_span
+template <typename T, typename Policy, typename Compare>
+void merge_sorted(std::type_identity_t<std::span<queue<T, Policy>* const>> in, queue<T, Policy>& out, Compare cmp) {
+    merge_sorted(in.data(), in.size(), out, cmp);
+}
+#endif
+
+#endif
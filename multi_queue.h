@@ -0,0 +1,71 @@
+#ifndef MULTI_QUEUE_H
+#define MULTI_QUEUE_H
+
+#include "queue.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+
+//спин-замок на одном атомике: захват - один exchange, при занятости - pause, потом yield
+//годится только для коротких участков, здесь это перецепление одного узла
+class spin_lock {
+    std::atomic<bool> locked_{false};
+public:
+    bool try_lock() noexcept;
+    void lock() noexcept;
+    void unlock() noexcept;
+};
+
+//многопоточная очередь с ослабленным FIFO: N шардов queue<T>, каждый за своим spin_lock
+//поток кладёт всегда в свой шард (номер потока по модулю N), берёт сначала из своего,
+//потом из более длинного из двух случайных, потом обходит все
+//узел создаётся и освобождается вне замка: под замком только splice/splice_one
+//
+//гарантии порядка:
+//- каждый элемент снимается ровно один раз, ничего не теряется
+//- элементы одного производителя снимаются в порядке push: его шард всегда один и тот же,
+//  а шард - обычная FIFO под замком
+//- между производителями порядка нет: более ранний push другого потока может выйти позже
+//- try_pop == false: при обходе каждый шард был пуст; без одновременных push это значит,
+//  что очередь пуста
+//- size() и is_empty() приблизительны, пока идут push и pop
+template <typename T, typename Policy = default_policy>
+class multi_queue {
+    //шард на своей строке кэша, чтобы замки соседей не делили строку
+    struct alignas(64) shard {
+        spin_lock lock;
+        std::atomic<std::size_t> size{0};   //копия q.size() для проверки без замка
+        queue<T, Policy> q;
+    };
+
+    std::unique_ptr<shard[]> shards_;
+    std::size_t n_;
+
+public:
+    explicit multi_queue(std::size_t shards = 0);      //0 - вдвое больше аппаратных потоков
+    multi_queue(const multi_queue&) = delete;
+    multi_queue& operator=(const multi_queue&) = delete;
+
+    void push(const T& v);
+    void push(T&& v);
+    bool try_pop(T& out);                   //false - все шарды пусты
+
+    std::size_t size() const;
+    bool is_empty() const;
+    bool empty() const;
+    std::size_t shards() const;
+
+private:
+    std::size_t home() const;               //шард текущего потока
+    std::size_t random_shard() const;
+    void push_chain(queue<T, Policy>& one);
+    bool pop_from(shard& s, queue<T, Policy>& out, bool wait);
+};
+
+#include "multi_queue_impl.h"
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef MULTI_QUEUE_IMPL_H
+#define MULTI_QUEUE_IMPL_H
+
+//реализация spin_lock
+
+//сначала чтение: занятый замок не гоняет строку кэша между ядрами
+inline bool spin_lock::try_lock() noexcept {
+    return !locked_.load(std::memory_order_relaxed) && !locked_.exchange(true, std::memory_order_acquire);
+}
+
+//на одном ядре держатель замка не продвинется, пока мы крутимся, поэтому после нескольких попыток yield
+inline void spin_lock::lock() noexcept {
+    for(unsigned i = 0; !try_lock(); ++i) {
+        if(i >= 64) {
+            std::this_thread::yield();
+        } else {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+    }
+}
+
+inline void spin_lock::unlock() noexcept { locked_.store(false, std::memory_order_release); }
+
+//номер потока для выбора шарда: раздаются по порядку при первом обращении
+inline std::size_t multi_queue_thread_id() {
+    static std::atomic<std::size_t> next{0};
+    thread_local std::size_t id = next.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+//xorshift на поток, для выбора шардов при краже
+inline std::uint64_t multi_queue_random() {
+    thread_local std::uint64_t x = 0x9E3779B97F4A7C15ull * (multi_queue_thread_id() + 1);
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return x;
+}
+
+//реализация multi_queue
+
+template <typename T, typename Policy>
+multi_queue<T, Policy>::multi_queue(std::size_t shards): n_(shards) {
+    if(n_ == 0) n_ = 2 * std::max(1u, std::thread::hardware_concurrency());
+    shards_.reset(new shard[n_]);
+}
+
+//узел готовится до замка
+template <typename T, typename Policy>
+void multi_queue<T, Policy>::push(const T& v) {
+    queue<T, Policy> one;
+    one.push(v);
+    push_chain(one);
+}
+
+template <typename T, typename Policy>
+void multi_queue<T, Policy>::push(T&& v) {
+    queue<T, Policy> one;
+    one.push(std::move(v));
+    push_chain(one);
+}
+
+//свой шард, затем более длинный из двух случайных, затем все по кругу с ожиданием замка
+template <typename T, typename Policy>
+bool multi_queue<T, Policy>::try_pop(T& out) {
+    queue<T, Policy> one;
+    bool got = pop_from(shards_[home()], one, false);
+    for(int i = 0; !got && i < 2; ++i) {
+        shard& a = shards_[random_shard()];
+        shard& b = shards_[random_shard()];
+        got = pop_from(a.size.load(std::memory_order_relaxed) >= b.size.load(std::memory_order_relaxed) ? a : b, one, false);
+    }
+    for(std::size_t i = 0, s = random_shard(); !got && i < n_; ++i, s = (s + 1 == n_ ? 0 : s + 1))
+        got = pop_from(shards_[s], one, true);
+    if(!got) return false;
+    out = one.pop();                        //узел освобождается вне замка
+    return true;
+}
+
+template <typename T, typename Policy>
+std::size_t multi_queue<T, Policy>::size() const {
+    std::size_t n = 0;
+    for(std::size_t i = 0; i < n_; ++i) n += shards_[i].size.load(std::memory_order_relaxed);
+    return n;
+}
+
+template <typename T, typename Policy>
+bool multi_queue<T, Policy>::is_empty() const { return size() == 0; }
+
+template <typename T, typename Policy>
+bool multi_queue<T, Policy>::empty() const { return size() == 0; }
+
+template <typename T, typename Policy>
+std::size_t multi_queue<T, Policy>::shards() const { return n_; }
+
+//вспомогательные методы
+
+template <typename T, typename Policy>
+std::size_t multi_queue<T, Policy>::home() const { return multi_queue_thread_id() % n_; }
+
+template <typename T, typename Policy>
+std::size_t multi_queue<T, Policy>::random_shard() const { return multi_queue_random() % n_; }
+
+//всегда в свой шард, иначе порядок одного производителя не сохранится
+template <typename T, typename Policy>
+void multi_queue<T, Policy>::push_chain(queue<T, Policy>& one) {
+    shard& s = shards_[home()];
+    s.lock.lock();
+    s.q.splice(one);
+    s.size.store(s.q.size(), std::memory_order_relaxed);
+    s.lock.unlock();
+}
+
+//пустой по счётчику шард не запирается; без wait занятый замок - промах, идём к другому шарду
+template <typename T, typename Policy>
+bool multi_queue<T, Policy>::pop_from(shard& s, queue<T, Policy>& out, bool wait) {
+    if(s.size.load(std::memory_order_relaxed) == 0) return false;
+    if(wait) s.lock.lock();
+    else if(!s.lock.try_lock()) return false;
+    bool got = !s.q.is_empty();
+    if(got) {
+        out.splice_one(s.q);
+        s.size.store(s.q.size(), std::memory_order_relaxed);
+    }
+    s.lock.unlock();
+    return got;
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef NODE_RECLAIMER_H
+#define NODE_RECLAIMER_H
+
+#include "container_policy.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+//фоновое освобождение узлов: clear() и деструктор отдают цепочку за O(1),
+//поток-уборщик удаляет её порциями по batch узлов
+//отставание ограничено: если в очереди больше max_pending узлов, цепочка удаляется сразу в вызывающем потоке
+//деструкторы T выполняются в потоке-уборщике, поэтому они не должны зависеть от потока владельца
+class node_reclaimer {
+public:
+    //удалить до budget узлов с начала цепочки, вернуть остаток
+    using free_fn = void* (*)(void* head, std::size_t budget);
+
+    static node_reclaimer& instance();
+
+    node_reclaimer(const node_reclaimer&) = delete;
+    node_reclaimer& operator=(const node_reclaimer&) = delete;
+
+    void retire(void* head, std::size_t n, free_fn f);  //передать цепочку из n узлов
+    void flush();                                       //дождаться, пока всё переданное удалено
+    std::size_t pending() const;                        //узлов ждут удаления
+
+    void set_max_pending(std::size_t n);                //предел отставания в узлах
+    std::size_t max_pending() const;
+    void set_batch(std::size_t n);                      //узлов за одну порцию
+
+private:
+    //цепочка в очереди на удаление
+    struct chain {
+        void* head;
+        std::size_t count;
+        free_fn free;
+    };
+
+    mutable std::mutex m_;
+    std::condition_variable work_cv_;       //появилась работа
+    std::condition_variable done_cv_;       //что-то удалено
+    std::deque<chain> chains_;
+    std::atomic<std::size_t> pending_;
+    std::atomic<std::size_t> max_pending_;
+    std::atomic<std::size_t> batch_;
+
+    node_reclaimer();
+    ~node_reclaimer() = delete;             //живёт до конца процесса, см. instance()
+    void run();
+};
+
+//удаление порции узлов типа Node
+template <typename Node>
+void* reclaim_nodes(void* head, std::size_t budget);
+
+//узлы по одному через new/delete, как heap_node_storage, но цепочку целиком удаляет node_reclaimer
+template <typename Node>
+class deferred_node_storage : public heap_node_storage<Node> {
+protected:
+    static constexpr bool bulk_release = true;
+
+    void release_chain(Node* first, std::size_t n);
+};
+
+//clear() и деструктор за O(1), узлы удаляются в фоне
+struct deferred_policy : default_policy {
+    template <typename Node>
+    using node_storage = deferred_node_storage<Node>;
+};
+
+#include "node_reclaimer_impl.h"
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef NODE_RECLAIMER_IMPL_H
+#define NODE_RECLAIMER_IMPL_H
+
+//реализация node_reclaimer
+
+//единственный экземпляр; не разрушается, чтобы контейнеры из статических объектов
+//могли отдавать цепочки и во время завершения программы
+inline node_reclaimer& node_reclaimer::instance() {
+    static node_reclaimer* r = new node_reclaimer;
+    return *r;
+}
+
+//по умолчанию отставание до 16M узлов, порции по 4096
+inline node_reclaimer::node_reclaimer()
+    : pending_(0), max_pending_(std::size_t(16) << 20), batch_(4096) {
+    std::thread([this] { run(); }).detach();
+}
+
+//передача цепочки; сверх предела - удаляем сами, чтобы память не росла без границы
+//проверка и добавление под m_, иначе одновременные retire вместе проходят мимо предела
+inline void node_reclaimer::retire(void* head, std::size_t n, free_fn f) {
+    if(!head) return;
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        std::size_t p = pending_.load(std::memory_order_relaxed);
+        std::size_t lim = max_pending_.load(std::memory_order_relaxed);
+        if(p <= lim && n <= lim - p) {
+            chains_.push_back(chain{head, n, f});
+            pending_.fetch_add(n, std::memory_order_relaxed);
+            head = nullptr;
+        }
+    }
+    if(!head) {
+        work_cv_.notify_one();
+        return;
+    }
+    while(head) head = f(head, n);
+}
+
+//ожидание пустой очереди
+inline void node_reclaimer::flush() {
+    std::unique_lock<std::mutex> lk(m_);
+    done_cv_.wait(lk, [this] { return pending_.load(std::memory_order_relaxed) == 0; });
+}
+
+inline std::size_t node_reclaimer::pending() const { return pending_.load(std::memory_order_relaxed); }
+
+inline void node_reclaimer::set_max_pending(std::size_t n) { max_pending_.store(n, std::memory_order_relaxed); }
+
+inline std::size_t node_reclaimer::max_pending() const { return max_pending_.load(std::memory_order_relaxed); }
+
+inline void node_reclaimer::set_batch(std::size_t n) { batch_.store(n ? n : 1, std::memory_order_relaxed); }
+
+//поток-уборщик: берёт цепочку и удаляет её порциями, между порциями отпускает процессор
+inline void node_reclaimer::run() {
+    std::unique_lock<std::mutex> lk(m_);
+    for(;;) {
+        work_cv_.wait(lk, [this] { return !chains_.empty(); });
+        chain c = chains_.front();
+        chains_.pop_front();
+        lk.unlock();
+
+        while(c.head) {
+            std::size_t budget = batch_.load(std::memory_order_relaxed);
+            c.head = c.free(c.head, budget);
+            std::size_t n = c.head && budget < c.count ? budget : c.count;
+            c.count -= n;
+            {
+                std::lock_guard<std::mutex> g(m_);
+                pending_.fetch_sub(n, std::memory_order_relaxed);
+            }
+            done_cv_.notify_all();
+            if(c.head) std::this_thread::yield();
+        }
+        lk.lock();
+    }
+}
+
+//удаление порции
+
+template <typename Node>
+void* reclaim_nodes(void* head, std::size_t budget) {
+    Node* p = static_cast<Node*>(head);
+    while(p && budget--) {
+        Node* t = p;
+        p = p->next;
+        delete t;
+    }
+    return p;
+}
+
+//реализация deferred_node_storage
+
+//цепочка уходит уборщику целиком
+template <typename Node>
+void deferred_node_storage<Node>::release_chain(Node* first, std::size_t n) {
+    node_reclaimer::instance().retire(first, n, &reclaim_nodes<Node>);
+}
+
+#endif
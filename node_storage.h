@@ -0,0 +1,122 @@
+#ifndef NODE_STORAGE_H
+#define NODE_STORAGE_H
+
+#include "memory_usage.h"
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//узел односвязного списка stack и queue: next первым, чтобы шаг по списку читал начало узла
+template <typename T, std::size_t Align>
+struct alignas(Align) list_node {
+    using value_type = T;
+
+    list_node* next;
+    T data;
+
+    list_node(const T& v, list_node* n = nullptr): next(n), data(v) {}
+    list_node(T&& v, list_node* n = nullptr): next(n), data(std::move(v)) {}
+};
+
+//обход цепочки порциями для visit_chunks у stack и queue
+//тривиально копируемые T собираются в буфер на стеке до list_chunk_bytes байт,
+//остальные отдаются по одному прямо из узлов, без копирования
+constexpr std::size_t list_chunk_bytes = 4096;
+
+template <typename Node>
+void visit_list_chunks(const Node* p, bool (*f)(void*, const typename Node::value_type*, std::size_t), void* ctx);
+
+//хранилища узлов: контейнер наследует хранилище закрыто и берёт узлы через make_node/free_node
+//при bulk_release clear() не обходит узлы сам, а отдаёт всю цепочку в release_chain
+//при portable_nodes узел можно перенести в другой контейнер с тем же хранилищем без копирования
+//пустое хранилище ничего не добавляет к размеру контейнера
+
+//каждый узел - отдельный new/delete (по умолчанию)
+template <typename Node>
+class heap_node_storage {
+protected:
+    static constexpr bool bulk_release = false;     //clear() обязан пройти по всем узлам
+    static constexpr bool portable_nodes = true;    //узлы можно перецепить в другой контейнер
+
+    heap_node_storage() = default;
+    heap_node_storage(const heap_node_storage&) {}                  //у копии своё хранилище
+    heap_node_storage& operator=(const heap_node_storage&) { return *this; }
+    heap_node_storage(heap_node_storage&&) noexcept = default;
+    heap_node_storage& operator=(heap_node_storage&&) noexcept = default;
+
+    template <typename... A>
+    Node* make_node(A&&... a) { return new Node(std::forward<A>(a)...); }
+    void free_node(Node* n) { delete n; }
+    void release_chain(Node*, std::size_t) {}                       //для bulk_release, здесь не нужен
+    std::size_t node_bytes(std::size_t live) const { return live * heap_block_bytes(sizeof(Node)); }
+};
+
+//узлы нарезаются из больших блоков; clear() освобождает блоки целиком за O(блоков)
+//только для T с тривиальным деструктором: при освобождении блока деструкторы не вызываются
+//снятые через pop узлы уходят в список свободных и используются снова
+template <typename Node>
+class arena_node_storage {
+    static_assert(std::is_trivially_destructible<typename Node::value_type>::value,
+                  "arena_node_storage: только для T с тривиальным деструктором");
+
+    //заголовок блока, узлы лежат следом
+    struct Block {
+        Block* next;
+        std::size_t bytes;      //размер блока вместе с заголовком
+    };
+
+    //свободный узел: на его месте хранится ссылка на следующий свободный
+    struct Free {
+        Free* next;
+    };
+
+    static constexpr std::size_t first_nodes = 64;          //узлов в первом блоке
+    static constexpr std::size_t max_nodes = 64 * 1024;     //блоки растут вдвое до этого предела
+    static constexpr std::size_t header = (sizeof(Block) + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+
+    Block* blocks_;         //все блоки, последний выделенный первым
+    Free* free_;            //узлы после pop
+    char* cur_;             //свободное место в текущем блоке
+    std::size_t left_;      //сколько узлов ещё влезет в текущий блок
+    std::size_t next_;      //узлов в следующем блоке
+
+protected:
+    static constexpr bool bulk_release = true;              //clear() может просто отдать блоки
+    static constexpr bool portable_nodes = false;           //узлы живут в блоках своего контейнера
+
+    arena_node_storage();
+    ~arena_node_storage();
+    arena_node_storage(const arena_node_storage&);          //у копии своё пустое хранилище
+    arena_node_storage& operator=(const arena_node_storage&);
+    arena_node_storage(arena_node_storage&& o) noexcept;
+    arena_node_storage& operator=(arena_node_storage&& o) noexcept;
+
+    template <typename... A>
+    Node* make_node(A&&... a);
+    void free_node(Node* n);
+    void release_chain(Node* first, std::size_t n);         //все узлы сразу, деструкторы T не вызываются
+    std::size_t node_bytes(std::size_t live) const;
+
+private:
+    void release_blocks();
+    void* take();                                           //место под один узел
+    void add_block();
+    void steal(arena_node_storage& o);
+    static void* block_alloc(std::size_t bytes);
+    static void block_free(void* p);
+};
+
+//политики хранения: member template node_storage<Node>
+struct heap_nodes {
+    template <typename Node> using node_storage = heap_node_storage<Node>;
+};
+
+struct arena_nodes {
+    template <typename Node> using node_storage = arena_node_storage<Node>;
+};
+
+#include "node_storage_impl.h"
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef NODE_STORAGE_IMPL_H
+#define NODE_STORAGE_IMPL_H
+
+//обход цепочки порциями
+
+template <typename Node>
+void visit_list_chunks(const Node* p, bool (*f)(void*, const typename Node::value_type*, std::size_t), void* ctx) {
+    using T = typename Node::value_type;
+    if constexpr(std::is_trivially_copyable<T>::value) {
+        constexpr std::size_t cap = list_chunk_bytes / sizeof(T) ? list_chunk_bytes / sizeof(T) : 1;
+        alignas(T) unsigned char buf[cap * sizeof(T)];
+        while(p) {
+            std::size_t n = 0;
+            for(; p && n < cap; p = p->next, ++n) std::memcpy(buf + n * sizeof(T), &p->data, sizeof(T));
+            if(!f(ctx, reinterpret_cast<const T*>(buf), n)) return;
+        }
+    } else {
+        for(; p; p = p->next)
+            if(!f(ctx, &p->data, 1)) return;
+    }
+}
+
+//реализация arena_node_storage
+
+//пустое хранилище, первый блок выделяется при первом узле
+template <typename Node>
+arena_node_storage<Node>::arena_node_storage()
+    : blocks_(nullptr), free_(nullptr), cur_(nullptr), left_(0), next_(first_nodes) {}
+
+//деструктор: контейнер уже отдал узлы, остались только блоки
+template <typename Node>
+arena_node_storage<Node>::~arena_node_storage() { release_blocks(); }
+
+//копия начинает с пустого хранилища, узлы копирует сам контейнер
+template <typename Node>
+arena_node_storage<Node>::arena_node_storage(const arena_node_storage&) : arena_node_storage() {}
+
+//при присваивании свои блоки остаются, контейнер освобождает узлы сам
+template <typename Node>
+arena_node_storage<Node>& arena_node_storage<Node>::operator=(const arena_node_storage&) { return *this; }
+
+//перемещение: блоки уходят вместе с узлами
+template <typename Node>
+arena_node_storage<Node>::arena_node_storage(arena_node_storage&& o) noexcept : arena_node_storage() {
+    steal(o);
+}
+
+template <typename Node>
+arena_node_storage<Node>& arena_node_storage<Node>::operator=(arena_node_storage&& o) noexcept {
+    if(this != &o) {
+        release_blocks();
+        steal(o);
+    }
+    return *this;
+}
+
+//новый узел на месте свободного или в текущем блоке
+template <typename Node>
+template <typename... A>
+Node* arena_node_storage<Node>::make_node(A&&... a) {
+    void* p = take();
+    try {
+        return ::new (p) Node(std::forward<A>(a)...);
+    } catch(...) {
+        Free* f = static_cast<Free*>(p);
+        f->next = free_;
+        free_ = f;
+        throw;
+    }
+}
+
+//узел после pop: деструктор тривиальный, место - в список свободных
+template <typename Node>
+void arena_node_storage<Node>::free_node(Node* n) {
+    n->~Node();
+    Free* f = ::new (static_cast<void*>(n)) Free;
+    f->next = free_;
+    free_ = f;
+}
+
+//цепочка из всех узлов контейнера: блоки разом, по узлам не идём
+template <typename Node>
+void arena_node_storage<Node>::release_chain(Node*, std::size_t) { release_blocks(); }
+
+//все блоки
+template <typename Node>
+void arena_node_storage<Node>::release_blocks() {
+    while(blocks_) {
+        Block* b = blocks_;
+        blocks_ = b->next;
+        block_free(b);
+    }
+    free_ = nullptr;
+    cur_ = nullptr;
+    left_ = 0;
+    next_ = first_nodes;
+}
+
+//память: блоки целиком, независимо от числа живых узлов
+template <typename Node>
+std::size_t arena_node_storage<Node>::node_bytes(std::size_t) const {
+    std::size_t n = 0;
+    for(const Block* b = blocks_; b; b = b->next) n += heap_block_bytes(b->bytes);
+    return n;
+}
+
+//место под узел: сначала свободные, потом текущий блок, потом новый блок
+template <typename Node>
+void* arena_node_storage<Node>::take() {
+    if(free_) {
+        Free* f = free_;
+        free_ = f->next;
+        return f;
+    }
+    if(left_ == 0) add_block();
+    void* p = cur_;
+    cur_ += sizeof(Node);
+    left_--;
+    return p;
+}
+
+//следующий блок вдвое больше предыдущего, но не больше max_nodes узлов
+template <typename Node>
+void arena_node_storage<Node>::add_block() {
+    std::size_t bytes = header + next_ * sizeof(Node);
+    Block* b = static_cast<Block*>(block_alloc(bytes));
+    b->next = blocks_;
+    b->bytes = bytes;
+    blocks_ = b;
+    cur_ = reinterpret_cast<char*>(b) + header;
+    left_ = next_;
+    if(next_ < max_nodes) next_ *= 2;
+}
+
+//забрать блоки у o
+template <typename Node>
+void arena_node_storage<Node>::steal(arena_node_storage& o) {
+    blocks_ = o.blocks_;
+    free_ = o.free_;
+    cur_ = o.cur_;
+    left_ = o.left_;
+    next_ = o.next_;
+    o.blocks_ = nullptr;
+    o.free_ = nullptr;
+    o.cur_ = nullptr;
+    o.left_ = 0;
+    o.next_ = first_nodes;
+}
+
+//блок с выравниванием узла
+template <typename Node>
+void* arena_node_storage<Node>::block_alloc(std::size_t bytes) {
+    if constexpr(alignof(Node) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        return ::operator new(bytes, std::align_val_t(alignof(Node)));
+    else
+        return ::operator new(bytes);
+}
+
+template <typename Node>
+void arena_node_storage<Node>::block_free(void* p) {
+    if constexpr(alignof(Node) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        ::operator delete(p, std::align_val_t(alignof(Node)));
+    else
+        ::operator delete(p);
+}
+
+#endif
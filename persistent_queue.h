@@ -0,0 +1,108 @@
+#ifndef PERSISTENT_QUEUE_H
+#define PERSISTENT_QUEUE_H
+
+#include "fwd_container.h"
+#include "persistent_stack.h"
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+//неизменяемая очередь Окасаки (banker's queue): копия за O(1), push и pop - амортизированно O(1)
+//даже при работе со старыми версиями: начало - ленивый поток с запоминанием,
+//конец - persistent_stack, который разворачивается в поток, когда становится длиннее начала
+//наследника fwd_container нет - элементы общие для версий и менять их нельзя,
+//но обход идёт через те же fwd_container<T>::const_iterator
+template <typename T>
+class persistent_queue {
+    struct Cell;
+
+    //отложенное вычисление f ++ reverse(r)
+    struct Pending {
+        Cell* f;
+        persistent_stack<T> r;
+    };
+
+    //ячейка ленивого потока: сначала Pending, после вычисления - пусто или (значение, хвост)
+    //вычисляется один раз и видна всем версиям, которые на неё ссылаются
+    struct Cell {
+        std::size_t refs;
+        Pending* pending;           //не nullptr, пока ячейка не вычислена
+        std::optional<T> head;      //пусто - конец потока
+        Cell* tail;
+        Cell(): refs(1), pending(nullptr), tail(nullptr) {}
+    };
+
+    Cell* front_;                   //ленивое начало
+    std::size_t front_sz_;          //его длина
+    persistent_stack<T> rear_;      //конец, сверху - последний добавленный
+
+public:
+    using const_iterator = typename fwd_container<T>::const_iterator;
+    using iterator_base = typename fwd_container<T>::iterator_base;
+    using const_iterator_base = typename fwd_container<T>::const_iterator_base;
+
+    // константный итератор: сначала по потоку, потом по развёрнутому концу
+    class pqueue_const_iterator : public const_iterator_base {
+        Cell* cur;                                          //текущая ячейка потока
+        std::shared_ptr<std::vector<const T*>> rear;        //конец в порядке очереди
+        std::size_t idx;                                    //позиция в rear
+    public:
+        pqueue_const_iterator(Cell* c = nullptr, std::shared_ptr<std::vector<const T*>> r = nullptr);
+
+        typename const_iterator_base::reference operator*() const override;
+        typename const_iterator_base::pointer operator->() const override;
+        pqueue_const_iterator& operator++() override;
+
+        //сравнения
+        bool operator==(const const_iterator_base& o) const override;
+        bool operator!=(const const_iterator_base& o) const override;
+        bool operator==(const iterator_base& o) const override;
+        bool operator!=(const iterator_base& o) const override;
+
+    protected:
+        const_iterator_base* clone() const override;
+
+    private:
+        bool at_end() const;
+        void skip_empty();          //перейти к концу, если поток кончился
+    };
+
+    // конструкторы
+    persistent_queue();                                         //пустая очередь
+    ~persistent_queue();
+    persistent_queue(const persistent_queue& o);                //O(1)
+    persistent_queue(persistent_queue&& o) noexcept;
+    persistent_queue& operator=(const persistent_queue& o);     //O(1)
+    persistent_queue& operator=(persistent_queue&& o) noexcept;
+
+    void push(const T& v);              //новая версия с v в конце
+    void push(T&& v);
+    T pop();                            //новая версия без первого элемента, значение копируется
+    const T& get_front() const;         //первый элемент
+
+    bool is_empty() const;
+    bool empty() const { return is_empty(); }
+    std::size_t size() const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+
+private:
+    static void retain(Cell* c);
+    static void release(Cell* c);
+    static void force(Cell* c);         //вычислить ячейку, если она отложена
+    void check();                       //инвариант |rear| <= |front|
+};
+
+//вывод
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const persistent_queue<T>& c);
+
+#include "persistent_queue_impl.h"
+
+#endif
@@ -0,0 +1,292 @@
+#ifndef PERSISTENT_QUEUE_IMPL_H
+#define PERSISTENT_QUEUE_IMPL_H
+
+//реализация ленивого потока
+
+//захват ссылки
+template <typename T>
+void persistent_queue<T>::retain(Cell* c) {
+    if(c) c->refs++;
+}
+
+//отпускание ссылки, по хвосту - циклом
+template <typename T>
+void persistent_queue<T>::release(Cell* c) {
+    while(c && --c->refs == 0) {
+        Cell* next = c->tail;
+        if(c->pending) {
+            release(c->pending->f);     //вложенность отложенных ячеек - O(log n)
+            delete c->pending;
+        }
+        delete c;
+        c = next;
+    }
+}
+
+//вычисление f ++ reverse(r) на один шаг:
+//пока f не кончился - берём его голову, хвост снова откладываем;
+//когда кончился - разворачиваем r целиком (за это заранее "заплачено" push-ами)
+template <typename T>
+void persistent_queue<T>::force(Cell* c) {
+    if(!c->pending) return;
+    Pending* p = c->pending;
+    Cell* f = p->f;
+
+    if(f) force(f);
+    if(f && f->head) {
+        Cell* rest = new Cell();
+        rest->pending = new Pending{f->tail, p->r};
+        retain(f->tail);
+        c->head.emplace(*f->head);
+        c->tail = rest;
+    } else {
+        //разворот: снизу стека - самый ранний элемент
+        Cell* lst = nullptr;
+        for(auto it = p->r.cbegin(); it != p->r.cend(); ++it) {
+            Cell* n = new Cell();
+            n->head.emplace(*it);
+            n->tail = lst;
+            lst = n;
+        }
+        if(lst) {
+            c->head.emplace(std::move(*lst->head));
+            c->tail = lst->tail;
+            lst->tail = nullptr;
+            delete lst;
+        }
+    }
+    c->pending = nullptr;
+    release(f);
+    delete p;
+}
+
+//поддержание инварианта: как только конец длиннее начала, откладываем их склейку
+template <typename T>
+void persistent_queue<T>::check() {
+    if(rear_.size() <= front_sz_) return;
+    Cell* c = new Cell();
+    c->pending = new Pending{front_, std::move(rear_)};
+    front_ = c;                     //ссылка на старое начало перешла в Pending
+    front_sz_ += c->pending->r.size();
+    rear_ = persistent_stack<T>();
+}
+
+//реализация pqueue_const_iterator
+
+//итератор по ячейке c, потом по r
+template <typename T>
+persistent_queue<T>::pqueue_const_iterator::pqueue_const_iterator(Cell* c, std::shared_ptr<std::vector<const T*>> r)
+    : cur(c), rear(std::move(r)), idx(0) {
+    skip_empty();
+}
+
+//дошли ли до конца очереди
+template <typename T>
+bool persistent_queue<T>::pqueue_const_iterator::at_end() const {
+    return !cur && (!rear || idx == rear->size());
+}
+
+//вычисляем ячейку; пустая ячейка = конец потока
+template <typename T>
+void persistent_queue<T>::pqueue_const_iterator::skip_empty() {
+    if(!cur) return;
+    force(cur);
+    if(!cur->head) cur = nullptr;
+}
+
+//разыменование
+template <typename T>
+typename persistent_queue<T>::const_iterator_base::reference
+persistent_queue<T>::pqueue_const_iterator::operator*() const {
+    return cur ? *cur->head : *(*rear)[idx];
+}
+
+//доступ к полю
+template <typename T>
+typename persistent_queue<T>::const_iterator_base::pointer
+persistent_queue<T>::pqueue_const_iterator::operator->() const {
+    return &**this;
+}
+
+//шаг вперёд
+template <typename T>
+typename persistent_queue<T>::pqueue_const_iterator&
+persistent_queue<T>::pqueue_const_iterator::operator++() {
+    if(cur) {
+        cur = cur->tail;
+        skip_empty();
+    } else if(!at_end()) {
+        ++idx;
+    }
+    return *this;
+}
+
+//сравнение с константным итератором
+template <typename T>
+bool persistent_queue<T>::pqueue_const_iterator::operator==(const const_iterator_base& o) const {
+    auto* p = dynamic_cast<const pqueue_const_iterator*>(&o);
+    if(!p) return false;
+    if(at_end() || p->at_end()) return at_end() && p->at_end();
+    return cur == p->cur && (cur || (rear == p->rear && idx == p->idx));
+}
+
+template <typename T>
+bool persistent_queue<T>::pqueue_const_iterator::operator!=(const const_iterator_base& o) const {
+    return !(*this == o);
+}
+
+//обычных итераторов у очереди нет
+template <typename T>
+bool persistent_queue<T>::pqueue_const_iterator::operator==(const iterator_base&) const {
+    return false;
+}
+
+template <typename T>
+bool persistent_queue<T>::pqueue_const_iterator::operator!=(const iterator_base& o) const {
+    return !(*this == o);
+}
+
+//копия итератора
+template <typename T>
+typename persistent_queue<T>::const_iterator_base*
+persistent_queue<T>::pqueue_const_iterator::clone() const {
+    return new pqueue_const_iterator(*this);
+}
+
+//реализация конструкторов и присваиваний
+
+//пустая очередь
+template <typename T>
+persistent_queue<T>::persistent_queue(): front_(nullptr), front_sz_(0) {}
+
+//деструктор
+template <typename T>
+persistent_queue<T>::~persistent_queue() { release(front_); }
+
+//копия: ссылка на поток + копия persistent_stack, оба за O(1)
+template <typename T>
+persistent_queue<T>::persistent_queue(const persistent_queue& o)
+    : front_(o.front_), front_sz_(o.front_sz_), rear_(o.rear_) {
+    retain(front_);
+}
+
+//перемещающий конструктор
+template <typename T>
+persistent_queue<T>::persistent_queue(persistent_queue&& o) noexcept
+    : front_(o.front_), front_sz_(o.front_sz_), rear_(std::move(o.rear_)) {
+    o.front_ = nullptr;
+    o.front_sz_ = 0;
+}
+
+//копирующее присваивание
+template <typename T>
+persistent_queue<T>& persistent_queue<T>::operator=(const persistent_queue& o) {
+    if(this != &o) {
+        retain(o.front_);
+        release(front_);
+        front_ = o.front_;
+        front_sz_ = o.front_sz_;
+        rear_ = o.rear_;
+    }
+    return *this;
+}
+
+//перемещающее присваивание
+template <typename T>
+persistent_queue<T>& persistent_queue<T>::operator=(persistent_queue&& o) noexcept {
+    if(this != &o) {
+        release(front_);
+        front_ = o.front_;
+        front_sz_ = o.front_sz_;
+        rear_ = std::move(o.rear_);
+        o.front_ = nullptr;
+        o.front_sz_ = 0;
+    }
+    return *this;
+}
+
+//реализация операций
+
+//добавление в конец
+template <typename T>
+void persistent_queue<T>::push(const T& v) {
+    rear_.push(v);
+    check();
+}
+
+//добавление перемещением
+template <typename T>
+void persistent_queue<T>::push(T&& v) {
+    rear_.push(std::move(v));
+    check();
+}
+
+//извлечение: ячейка может быть общей, поэтому значение копируем
+template <typename T>
+T persistent_queue<T>::pop() {
+    if(is_empty()) throw std::runtime_error("persistent_queue empty");
+    force(front_);
+    T val = *front_->head;
+    Cell* next = front_->tail;
+    retain(next);
+    release(front_);
+    front_ = next;
+    front_sz_--;
+    check();
+    return val;
+}
+
+//первый элемент
+template <typename T>
+const T& persistent_queue<T>::get_front() const {
+    if(is_empty()) throw std::runtime_error("persistent_queue empty");
+    force(front_);
+    return *front_->head;
+}
+
+//пустота: по инварианту начало пусто только вместе с концом
+template <typename T>
+bool persistent_queue<T>::is_empty() const { return front_sz_ == 0; }
+
+//размер
+template <typename T>
+std::size_t persistent_queue<T>::size() const { return front_sz_ + rear_.size(); }
+
+//итераторы
+
+//начало обхода: конец очереди разворачиваем в массив указателей один раз на обход
+template <typename T>
+typename persistent_queue<T>::const_iterator persistent_queue<T>::begin() const {
+    std::shared_ptr<std::vector<const T*>> r;
+    if(!rear_.is_empty()) {
+        r = std::make_shared<std::vector<const T*>>(rear_.size());
+        std::size_t i = rear_.size();
+        for(auto it = rear_.cbegin(); it != rear_.cend(); ++it) (*r)[--i] = &*it;
+    }
+    return const_iterator(new pqueue_const_iterator(front_sz_ ? front_ : nullptr, std::move(r)));
+}
+
+template <typename T>
+typename persistent_queue<T>::const_iterator persistent_queue<T>::end() const {
+    return const_iterator(new pqueue_const_iterator());
+}
+
+template <typename T>
+typename persistent_queue<T>::const_iterator persistent_queue<T>::cbegin() const { return begin(); }
+
+template <typename T>
+typename persistent_queue<T>::const_iterator persistent_queue<T>::cend() const { return end(); }
+
+//вывод
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const persistent_queue<T>& c) {
+    bool first = true;
+    for (auto it = c.cbegin(); it != c.cend(); ++it) {
+        if (!first) os << ' ';
+        os << *it;
+        first = false;
+    }
+    return os;
+}
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef PERSISTENT_STACK_H
+#define PERSISTENT_STACK_H
+
+#include "fwd_container.h"
+#include <stdexcept>
+#include <utility>
+
+//стек с общими узлами: копия за O(1), push/pop создают новую версию,
+//неизменённый хвост остаётся общим для всех копий
+//счётчики ссылок не атомарные: копии одной версии нельзя трогать из разных потоков одновременно
+template <typename T>
+class persistent_stack : public fwd_container<T> {
+    // узел списка со счётчиком ссылок
+    struct Node {
+        T data;
+        Node* next;
+        std::size_t refs;       //сколько стеков и узлов указывают на этот узел
+        Node(const T& v, Node* n = nullptr): data(v), next(n), refs(1) {}
+        Node(T&& v, Node* n = nullptr): data(std::move(v)), next(n), refs(1) {}
+    };
+
+    Node* top_;         //вершина этой версии
+    std::size_t sz_;    //количество элементов
+
+public:
+    using iterator = typename fwd_container<T>::iterator;
+    using const_iterator = typename fwd_container<T>::const_iterator;
+    using iterator_base = typename fwd_container<T>::iterator_base;
+    using const_iterator_base = typename fwd_container<T>::const_iterator_base;
+
+    class pstack_const_iterator;
+
+    // итератор (выдаётся только после отделения цепочки от других версий)
+    class pstack_iterator : public iterator_base {
+        Node* cur;
+        friend class pstack_const_iterator;
+    public:
+        pstack_iterator(Node* n = nullptr);
+
+        typename iterator_base::reference operator*() override;
+        typename iterator_base::pointer operator->() override;
+        pstack_iterator& operator++() override;
+
+        //сравнения
+        bool operator==(const iterator_base& o) const override;
+        bool operator!=(const iterator_base& o) const override;
+        bool operator==(const const_iterator_base& o) const override;
+        bool operator!=(const const_iterator_base& o) const override;
+
+    protected:
+        iterator_base* clone() const override;             //копия итератора
+        const_iterator_base* make_const() const override;  //создание константного итератора
+    };
+
+    // константный итератор, ходит по общим узлам
+    class pstack_const_iterator : public const_iterator_base {
+        const Node* cur;
+        friend class pstack_iterator;
+    public:
+        pstack_const_iterator(const Node* n = nullptr);
+        pstack_const_iterator(const pstack_iterator& o);
+
+        typename const_iterator_base::reference operator*() const override;
+        typename const_iterator_base::pointer operator->() const override;
+        pstack_const_iterator& operator++() override;
+
+        // сравнения
+        bool operator==(const const_iterator_base& o) const override;
+        bool operator!=(const const_iterator_base& o) const override;
+        bool operator==(const iterator_base& o) const override;
+        bool operator!=(const iterator_base& o) const override;
+
+    protected:
+        const_iterator_base* clone() const override;
+    };
+
+    // конструкторы
+    persistent_stack();                                         //пустой стек
+    ~persistent_stack() override;                               //отпускает свою ссылку на цепочку
+    persistent_stack(const persistent_stack& o);                //O(1): общая цепочка
+    persistent_stack(persistent_stack&& o);
+    persistent_stack& operator=(const persistent_stack& o);     //O(1)
+    persistent_stack& operator=(persistent_stack&& o);
+    fwd_container<T>& operator=(const fwd_container<T>& o) override;  //присваивание через базу
+
+    void push(const T& v) override;         //новый узел поверх общей цепочки
+    void push(T&& v) override;
+    T pop() override;                       //перемещает значение, если узел ничей больше
+
+    T& get_front() override;                //отделяет вершину, если она общая
+    const T& get_front() const override;
+
+    bool is_empty() const override;
+    std::size_t size() const override;
+    std::size_t memory_usage() const override;  //все узлы этой версии, в том числе общие с другими
+
+    iterator begin() override;              //отделяет всю цепочку (копирование при записи)
+    iterator end() override;
+    const_iterator begin() const override;
+    const_iterator end() const override;
+    const_iterator cbegin() const override;
+    const_iterator cend() const override;
+
+private:
+    static void retain(Node* n);            //+1 ссылка
+    static void release(Node* n);           //-1 ссылка, освобождение ставших ничьими узлов
+    void clear();                           //отпустить цепочку
+    void unshare_top();                     //своя копия вершины
+    void unshare_all();                     //своя копия всех общих узлов
+};
+
+#include "persistent_stack_impl.h"
+
+#endif
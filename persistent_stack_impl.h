@@ -0,0 +1,345 @@
+#ifndef PERSISTENT_STACK_IMPL_H
+#define PERSISTENT_STACK_IMPL_H
+
+//реализация pstack_iterator
+
+//конструктор
+template <typename T>
+persistent_stack<T>::pstack_iterator::pstack_iterator(Node* n): cur(n) {}
+
+//возвращаем данные узла
+template <typename T>
+typename persistent_stack<T>::iterator_base::reference
+persistent_stack<T>::pstack_iterator::operator*() { return cur->data; }
+
+//доступ к полю
+template <typename T>
+typename persistent_stack<T>::iterator_base::pointer
+persistent_stack<T>::pstack_iterator::operator->() { return &cur->data; }
+
+//шаг вперёд
+template <typename T>
+typename persistent_stack<T>::pstack_iterator&
+persistent_stack<T>::pstack_iterator::operator++() {
+    if(cur) cur = cur->next;
+    return *this;
+}
+
+//сравнение с итератором
+template <typename T>
+bool persistent_stack<T>::pstack_iterator::operator==(const iterator_base& o) const {
+    auto* p = dynamic_cast<const pstack_iterator*>(&o);
+    return p && cur == p->cur;
+}
+
+template <typename T>
+bool persistent_stack<T>::pstack_iterator::operator!=(const iterator_base& o) const {
+    return !(*this == o);
+}
+
+//сравнение с константным итератором
+template <typename T>
+bool persistent_stack<T>::pstack_iterator::operator==(const const_iterator_base& o) const {
+    auto* p = dynamic_cast<const pstack_const_iterator*>(&o);
+    return p && cur == p->cur;
+}
+
+template <typename T>
+bool persistent_stack<T>::pstack_iterator::operator!=(const const_iterator_base& o) const {
+    return !(*this == o);
+}
+
+//копия итератора
+template <typename T>
+typename persistent_stack<T>::iterator_base*
+persistent_stack<T>::pstack_iterator::clone() const {
+    return new pstack_iterator(*this);
+}
+
+//создаем константную версию
+template <typename T>
+typename persistent_stack<T>::const_iterator_base*
+persistent_stack<T>::pstack_iterator::make_const() const {
+    return new pstack_const_iterator(cur);
+}
+
+//реализация pstack_const_iterator
+
+//конструктор
+template <typename T>
+persistent_stack<T>::pstack_const_iterator::pstack_const_iterator(const Node* n): cur(n) {}
+
+//конструктор из обычного итератора
+template <typename T>
+persistent_stack<T>::pstack_const_iterator::pstack_const_iterator(const pstack_iterator& o): cur(o.cur) {}
+
+//возвращаем константную ссылку
+template <typename T>
+typename persistent_stack<T>::const_iterator_base::reference
+persistent_stack<T>::pstack_const_iterator::operator*() const { return cur->data; }
+
+//доступ к полю
+template <typename T>
+typename persistent_stack<T>::const_iterator_base::pointer
+persistent_stack<T>::pstack_const_iterator::operator->() const { return &cur->data; }
+
+//шаг вперёд
+template <typename T>
+typename persistent_stack<T>::pstack_const_iterator&
+persistent_stack<T>::pstack_const_iterator::operator++() {
+    if(cur) cur = cur->next;
+    return *this;
+}
+
+//сравнение с константным итератором
+template <typename T>
+bool persistent_stack<T>::pstack_const_iterator::operator==(const const_iterator_base& o) const {
+    auto* p = dynamic_cast<const pstack_const_iterator*>(&o);
+    return p && cur == p->cur;
+}
+
+template <typename T>
+bool persistent_stack<T>::pstack_const_iterator::operator!=(const const_iterator_base& o) const {
+    return !(*this == o);
+}
+
+//сравнение с обычным итератором
+template <typename T>
+bool persistent_stack<T>::pstack_const_iterator::operator==(const iterator_base& o) const {
+    auto* p = dynamic_cast<const pstack_iterator*>(&o);
+    return p && cur == p->cur;
+}
+
+template <typename T>
+bool persistent_stack<T>::pstack_const_iterator::operator!=(const iterator_base& o) const {
+    return !(*this == o);
+}
+
+//копия итератора
+template <typename T>
+typename persistent_stack<T>::const_iterator_base*
+persistent_stack<T>::pstack_const_iterator::clone() const {
+    return new pstack_const_iterator(*this);
+}
+
+//реализация конструкторов и присваиваний
+
+//пустой стек
+template <typename T>
+persistent_stack<T>::persistent_stack(): top_(nullptr), sz_(0) {}
+
+//деструктор
+template <typename T>
+persistent_stack<T>::~persistent_stack() { clear(); }
+
+//копия - просто ещё одна ссылка на ту же вершину
+template <typename T>
+persistent_stack<T>::persistent_stack(const persistent_stack& o): top_(o.top_), sz_(o.sz_) {
+    retain(top_);
+}
+
+//перемещающий конструктор
+template <typename T>
+persistent_stack<T>::persistent_stack(persistent_stack&& o): top_(o.top_), sz_(o.sz_) {
+    o.top_ = nullptr;
+    o.sz_ = 0;
+}
+
+//копирующее присваивание за O(1)
+template <typename T>
+persistent_stack<T>& persistent_stack<T>::operator=(const persistent_stack& o) {
+    if(this != &o) {
+        retain(o.top_);         //сначала захватываем, на случай общей цепочки
+        clear();
+        top_ = o.top_;
+        sz_ = o.sz_;
+    }
+    return *this;
+}
+
+//перемещающее присваивание
+template <typename T>
+persistent_stack<T>& persistent_stack<T>::operator=(persistent_stack&& o) {
+    if(this != &o) {
+        clear();
+        top_ = o.top_;
+        sz_ = o.sz_;
+        o.top_ = nullptr;
+        o.sz_ = 0;
+    }
+    return *this;
+}
+
+//присваивание через базовый класс
+template <typename T>
+fwd_container<T>& persistent_stack<T>::operator=(const fwd_container<T>& o) {
+    return fwd_container<T>::operator=(o);
+}
+
+//реализация методов интерфейса
+
+//новый узел забирает нашу ссылку на старую вершину
+template <typename T>
+void persistent_stack<T>::push(const T& v) {
+    top_ = new Node(v, top_);
+    sz_++;
+}
+
+//перемещающее добавление
+template <typename T>
+void persistent_stack<T>::push(T&& v) {
+    top_ = new Node(std::move(v), top_);
+    sz_++;
+}
+
+//снятие вершины: если узел больше никому не нужен - перемещаем, иначе копируем
+template <typename T>
+T persistent_stack<T>::pop() {
+    if(is_empty()) throw std::runtime_error("persistent_stack empty");
+    Node* old = top_;
+    if(old->refs == 1) {
+        T val = std::move(old->data);
+        top_ = old->next;       //ссылка узла на next переходит к нам
+        delete old;
+        sz_--;
+        return val;
+    }
+    T val = old->data;
+    top_ = old->next;
+    retain(top_);
+    release(old);
+    sz_--;
+    return val;
+}
+
+//изменяемый доступ к вершине
+template <typename T>
+T& persistent_stack<T>::get_front() {
+    if(is_empty()) throw std::runtime_error("persistent_stack empty");
+    unshare_top();
+    return top_->data;
+}
+
+//константный доступ к вершине
+template <typename T>
+const T& persistent_stack<T>::get_front() const {
+    if(is_empty()) throw std::runtime_error("persistent_stack empty");
+    return top_->data;
+}
+
+//пустота
+template <typename T>
+bool persistent_stack<T>::is_empty() const { return top_ == nullptr; }
+
+//размер
+template <typename T>
+std::size_t persistent_stack<T>::size() const { return sz_; }
+
+//память: общие узлы считаются в каждой версии, сумма по версиям больше реальной
+template <typename T>
+std::size_t persistent_stack<T>::memory_usage() const {
+    std::size_t n = sizeof(*this) + sz_ * heap_block_bytes(sizeof(Node));
+    if(!heap_usage<T>::none)
+        for(const Node* p = top_; p; p = p->next) n += heap_usage<T>::bytes(p->data);
+    return n;
+}
+
+//реализация итераторов
+
+//изменяемый обход: сначала отделяем цепочку от других версий
+template <typename T>
+typename persistent_stack<T>::iterator persistent_stack<T>::begin() {
+    unshare_all();
+    return iterator(new pstack_iterator(top_));
+}
+
+//итератор на конец
+template <typename T>
+typename persistent_stack<T>::iterator persistent_stack<T>::end() {
+    return iterator(new pstack_iterator(nullptr));
+}
+
+//константный итератор на вершину
+template <typename T>
+typename persistent_stack<T>::const_iterator persistent_stack<T>::begin() const {
+    return const_iterator(new pstack_const_iterator(top_));
+}
+
+//константный итератор на конец
+template <typename T>
+typename persistent_stack<T>::const_iterator persistent_stack<T>::end() const {
+    return const_iterator(new pstack_const_iterator(nullptr));
+}
+
+//cbegin
+template <typename T>
+typename persistent_stack<T>::const_iterator persistent_stack<T>::cbegin() const {
+    return const_iterator(new pstack_const_iterator(top_));
+}
+
+//cend
+template <typename T>
+typename persistent_stack<T>::const_iterator persistent_stack<T>::cend() const {
+    return const_iterator(new pstack_const_iterator(nullptr));
+}
+
+//вспомогательные методы
+
+//захват ссылки
+template <typename T>
+void persistent_stack<T>::retain(Node* n) {
+    if(n) n->refs++;
+}
+
+//отпускание ссылки; цикл вместо рекурсии, чтобы длинная цепочка не переполнила стек вызовов
+template <typename T>
+void persistent_stack<T>::release(Node* n) {
+    while(n && --n->refs == 0) {
+        Node* next = n->next;
+        delete n;
+        n = next;
+    }
+}
+
+//отпускаем свою цепочку
+template <typename T>
+void persistent_stack<T>::clear() {
+    release(top_);
+    top_ = nullptr;
+    sz_ = 0;
+}
+
+//своя копия вершины, остальная цепочка по-прежнему общая
+template <typename T>
+void persistent_stack<T>::unshare_top() {
+    if(top_->refs == 1) return;
+    Node* n = new Node(top_->data, top_->next);
+    retain(top_->next);
+    release(top_);
+    top_ = n;
+}
+
+//копирование при записи: всё, что ниже первого общего узла, копируем себе
+template <typename T>
+void persistent_stack<T>::unshare_all() {
+    Node** link = &top_;
+    while(*link && (*link)->refs == 1) link = &(*link)->next;
+    Node* shared = *link;
+    if(!shared) return;
+
+    Node* head = nullptr;
+    Node** out = &head;
+    try {
+        for(const Node* n = shared; n; n = n->next) {
+            *out = new Node(n->data);
+            out = &(*out)->next;
+        }
+    } catch(...) {
+        release(head);
+        throw;
+    }
+    *link = head;
+    release(shared);
+}
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef PRIORITY_QUEUE_H
+#define PRIORITY_QUEUE_H
+
+#include "fwd_container.h"
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+//очередь с приоритетом на d-куче в непрерывном массиве: get_front - наибольший по Compare элемент
+//D = 4: дети узла лежат рядом, высота вдвое меньше двоичной, на спуске меньше промахов кэша
+//итераторы идут в порядке массива кучи, а не по приоритету; менять элементы через них нельзя,
+//это ломает кучу
+template <typename T, typename Compare = std::less<T>, std::size_t D = 4>
+class priority_queue : public fwd_container<T> {
+    static_assert(D >= 2, "priority_queue: D должно быть не меньше 2");
+
+    std::vector<T> data_;   //куча: дети узла i - D*i+1 ... D*i+D
+    Compare cmp_;
+
+public:
+    using iterator = typename fwd_container<T>::iterator;
+    using const_iterator = typename fwd_container<T>::const_iterator;
+    using iterator_base = typename fwd_container<T>::iterator_base;
+    using const_iterator_base = typename fwd_container<T>::const_iterator_base;
+
+    class heap_const_iterator;
+
+    // итератор по массиву кучи
+    class heap_iterator : public iterator_base {
+        T* cur;
+        friend class heap_const_iterator;
+    public:
+        heap_iterator(T* p = nullptr);
+
+        typename iterator_base::reference operator*() override;
+        typename iterator_base::pointer operator->() override;
+        heap_iterator& operator++() override;
+
+        //сравнения
+        bool operator==(const iterator_base& o) const override;
+        bool operator!=(const iterator_base& o) const override;
+        bool operator==(const const_iterator_base& o) const override;
+        bool operator!=(const const_iterator_base& o) const override;
+
+    protected:
+        iterator_base* clone() const override;
+        const_iterator_base* make_const() const override;
+    };
+
+    // константный итератор
+    class heap_const_iterator : public const_iterator_base {
+        const T* cur;
+        friend class heap_iterator;
+    public:
+        heap_const_iterator(const T* p = nullptr);
+        heap_const_iterator(const heap_iterator& o);
+
+        typename const_iterator_base::reference operator*() const override;
+        typename const_iterator_base::pointer operator->() const override;
+        heap_const_iterator& operator++() override;
+
+        // сравнения
+        bool operator==(const const_iterator_base& o) const override;
+        bool operator!=(const const_iterator_base& o) const override;
+        bool operator==(const iterator_base& o) const override;
+        bool operator!=(const iterator_base& o) const override;
+
+    protected:
+        const_iterator_base* clone() const override;
+    };
+
+    // конструкторы
+    explicit priority_queue(const Compare& cmp = Compare());
+    template <typename It>
+    priority_queue(It first, It last, const Compare& cmp = Compare());     //построение кучи за O(n)
+    priority_queue(const priority_queue& o);
+    priority_queue(priority_queue&& o) noexcept;
+    priority_queue& operator=(const priority_queue& o);
+    priority_queue& operator=(priority_queue&& o) noexcept;
+    fwd_container<T>& operator=(const fwd_container<T>& o) override;      //копия элементов и построение кучи
+
+    void push(const T& v) override;
+    void push(T&& v) override;
+    T pop() override;                       //наибольший элемент
+
+    T push_pop(T v);                        //push(v), затем pop(); если v не меньше вершины, куча не трогается
+    T replace_top(T v);                     //pop(), затем push(v) за один спуск; std::runtime_error на пустой
+    void push_many(const T* p, std::size_t n) override;    //много элементов - дописать и перестроить кучу
+
+    T& get_front() override;                //менять вершину можно, если не уменьшать её приоритет
+    const T& get_front() const override;
+
+    bool is_empty() const override;
+    std::size_t size() const override;
+    std::size_t memory_usage() const override;     //объект + массив кучи + память элементов
+    void reserve(std::size_t n);
+    std::size_t capacity() const;
+
+    iterator begin() override;
+    iterator end() override;
+    const_iterator begin() const override;
+    const_iterator end() const override;
+    const_iterator cbegin() const override;
+    const_iterator cend() const override;
+
+private:
+    void sift_up(std::size_t i);
+    void sift_down(std::size_t i);
+    void sift_down_leaf(std::size_t i);     //для pop: до листа, потом вверх
+    void heapify();
+};
+
+#include "priority_queue_impl.h"
+
+#endif
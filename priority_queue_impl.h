@@ -0,0 +1,367 @@
+#ifndef PRIORITY_QUEUE_IMPL_H
+#define PRIORITY_QUEUE_IMPL_H
+
+//реализация heap_iterator
+
+//конструктор
+template <typename T, typename Compare, std::size_t D>
+priority_queue<T, Compare, D>::heap_iterator::heap_iterator(T* p): cur(p) {}
+
+//разыменование
+template <typename T, typename Compare, std::size_t D>
+typename priority_queue<T, Compare, D>::iterator_base::reference
+priority_queue<T, Compare, D>::heap_iterator::operator*() { return *cur; }
+
+//доступ к полю
+template <typename T, typename Compare, std::size_t D>
+typename priority_queue<T, Compare, D>::iterator_base::pointer
+priority_queue<T, Compare, D>::heap_iterator::operator->() { return cur; }
+
+//следующий элемент массива
+template <typename T, typename Compare, std::size_t D>
+typename priority_queue<T, Compare, D>::heap_iterator&
+priority_queue<T, Compare, D>::heap_iterator::operator++() {
+    ++cur;
+    return *this;
+}
+
+//сравнение с обычным итератором
+template <typename T, typename Compare, std::size_t D>
+bool priority_queue<T, Compare, D>::heap_iterator::operator==(const iterator_base& o) const {
+    auto* p = dynamic_cast<const heap_iterator*>(&o);
+    return p && cur == p->cur;
+}
+
+template <typename T, typename Compare, std::size_t D>
+bool priority_queue<T, Compare, D>::heap_iterator::operator!=(const iterator_base& o) const {
+    return !(*this == o);
+}
+
+//сравнение с константным итератором
+template <typename T, typename Compare, std::size_t D>
+bool priority_queue<T, Compare, D>::heap_iterator::operator==(const const_iterator_base& o) const {
+    auto* p = dynamic_cast<const heap_const_iterator*>(&o);
+    return p && cur == p->cur;
+}
+
+template <typename T, typename Compare, std::size_t D>
+bool priority_queue<T, Compare, D>::heap_iterator::operator!=(const const_iterator_base& o) const {
+    return !(*this == o);
+}
+
+//копия итератора
+template <typename T, typename Compare, std::size_t D>
+typename priority_queue<T, Compare, D>::iterator_base*
+priority_queue<T, Compare, D>::heap_iterator::clone() const {
+    return new heap_iterator(*this);
+}
+
+//константная версия
+template <typename T, typename Compare, std::size_t D>
+typename priority_queue<T, Compare, D>::const_iterator_base*
+priority_queue<T, Compare, D>::heap_iterator::make_const() const {
+    return new heap_const_iterator(*this);
+}
+
+//реализация heap_const_iterator
+
+//конструктор
+template <typename T, typename Compare, std::size_t D>
+priority_queue<T, Compare, D>::heap_const_iterator::heap_const_iterator(const T* p): cur(p) {}
+
+//из обычного итератора
+template <typename T, typename Compare, std::size_t D>
+priority_queue<T, Compare, D>::heap_const_iterator::heap_const_iterator(const heap_iterator& o): cur(o.cur) {}
+
+//разыменование
+template <typename T, typename Compare, std::size_t D>
+typename priority_queue<T, Compare, D>::const_iterator_base::reference
+priority_queue<T, Compare, D>::heap_const_iterator::operator*() const { return *cur; }
+
+//доступ к полю
+template <typename T, typename Compare, std::size_t D>
+typename priority_queue<T, Compare, D>::const_iterator_base::pointer
+priority_queue<T, Compare, D>::heap_const_iterator::operator->() const { return cur; }
+
+//следующий элемент массива
+template <typename T, typename Compare, std::size_t D>
+typename priority_queue<T, Compare, D>::heap_const_iterator&
+priority_queue<T, Compare, D>::heap_const_iterator::operator++() {
+    ++cur;
+    return *this;
+}
+
+//сравнение с константным итератором
+template <typename T, typename Compare, std::size_t D>
+bool priority_queue<T, Compare, D>::heap_const_iterator::operator==(const const_iterator_base& o) const {
+    auto* p = dynamic_cast<const heap_const_iterator*>(&o);
+    return p && cur == p->cur;
+}
+
+template <typename T, typename Compare, std::size_t D>
+bool priority_queue<T, Compare, D>::heap_const_iterator::operator!=(const const_iterator_base& o) const {
+    return !(*this == o);
+}
+
+//сравнение с обычным итератором
+template <typename T, typename Compare, std::size_t D>
+bool priority_queue<T, Compare, D>::heap_const_iterator::operator==(const iterator_base& o) const {
+    auto* p = dynamic_cast<const heap_iterator*>(&o);
+    return p && cur == p->cur;
+}
+
+template <typename T, typename Compare, std::size_t D>
+bool priority_queue<T, Compare, D>::heap_const_iterator::operator!=(const iterator_base& o) const {
+    return !(*this == o);
+}
+
+//копия итератора
+template <typename T, typename Compare, std::size_t D>
+typename priority_queue<T, Compare, D>::const_iterator_base*
+priority_queue<T, Compare, D>::heap_const_iterator::clone() const {
+    return new heap_const_iterator(*this);
+}
+
+//реализация конструкторов и присваиваний
+
+//пустая очередь
+template <typename T, typename Compare, std::size_t D>
+priority_queue<T, Compare, D>::priority_queue(const Compare& cmp): cmp_(cmp) {}
+
+//из диапазона: элементы подряд, затем куча снизу вверх за O(n)
+template <typename T, typename Compare, std::size_t D>
+template <typename It>
+priority_queue<T, Compare, D>::priority_queue(It first, It last, const Compare& cmp): data_(first, last), cmp_(cmp) {
+    heapify();
+}
+
+//копирующий конструктор
+template <typename T, typename Compare, std::size_t D>
+priority_queue<T, Compare, D>::priority_queue(const priority_queue& o): fwd_container<T>(), data_(o.data_), cmp_(o.cmp_) {}
+
+//перемещающий конструктор
+template <typename T, typename Compare, std::size_t D>
+priority_queue<T, Compare, D>::priority_queue(priority_queue&& o) noexcept: data_(std::move(o.data_)), cmp_(std::move(o.cmp_)) {}
+
+//копирующее присваивание
+template <typename T, typename Compare, std::size_t D>
+priority_queue<T, Compare, D>& priority_queue<T, Compare, D>::operator=(const priority_queue& o) {
+    if(this != &o) {
+        data_ = o.data_;
+        cmp_ = o.cmp_;
+    }
+    return *this;
+}
+
+//перемещающее присваивание
+template <typename T, typename Compare, std::size_t D>
+priority_queue<T, Compare, D>& priority_queue<T, Compare, D>::operator=(priority_queue&& o) noexcept {
+    if(this != &o) {
+        data_ = std::move(o.data_);
+        cmp_ = std::move(o.cmp_);
+    }
+    return *this;
+}
+
+//присваивание через базовый класс: порядок o не важен, куча строится заново
+template <typename T, typename Compare, std::size_t D>
+fwd_container<T>& priority_queue<T, Compare, D>::operator=(const fwd_container<T>& o) {
+    if(this != &o) {
+        std::vector<T> v;
+        v.reserve(o.size());
+        for(auto it = o.cbegin(); it != o.cend(); ++it) v.push_back(*it);
+        data_.swap(v);
+        heapify();
+    }
+    return *this;
+}
+
+//реализация методов интерфейса
+
+//добавление копированием
+template <typename T, typename Compare, std::size_t D>
+void priority_queue<T, Compare, D>::push(const T& v) {
+    data_.push_back(v);
+    sift_up(data_.size() - 1);
+}
+
+//добавление перемещением
+template <typename T, typename Compare, std::size_t D>
+void priority_queue<T, Compare, D>::push(T&& v) {
+    data_.push_back(std::move(v));
+    sift_up(data_.size() - 1);
+}
+
+//снятие вершины: на её место последний элемент и спуск до листа
+template <typename T, typename Compare, std::size_t D>
+T priority_queue<T, Compare, D>::pop() {
+    if(is_empty()) throw std::runtime_error("priority_queue empty");
+    T top = std::move(data_.front());
+    if(data_.size() > 1) {
+        data_.front() = std::move(data_.back());
+        data_.pop_back();
+        sift_down_leaf(0);
+    } else {
+        data_.pop_back();
+    }
+    return top;
+}
+
+//push и pop сразу: v сам становится ответом, если не меньше вершины
+template <typename T, typename Compare, std::size_t D>
+T priority_queue<T, Compare, D>::push_pop(T v) {
+    if(is_empty() || !cmp_(v, data_.front())) return v;
+    std::swap(v, data_.front());
+    sift_down(0);
+    return v;
+}
+
+//замена вершины
+template <typename T, typename Compare, std::size_t D>
+T priority_queue<T, Compare, D>::replace_top(T v) {
+    if(is_empty()) throw std::runtime_error("priority_queue empty");
+    std::swap(v, data_.front());
+    sift_down(0);
+    return v;
+}
+
+//пакет не меньше самой кучи: перестроить дешевле, чем поднимать каждый элемент
+template <typename T, typename Compare, std::size_t D>
+void priority_queue<T, Compare, D>::push_many(const T* p, std::size_t n) {
+    const std::size_t old = data_.size();
+    data_.insert(data_.end(), p, p + n);
+    if(n >= old) heapify();
+    else
+        for(std::size_t i = old; i < data_.size(); ++i) sift_up(i);
+}
+
+//вершина
+template <typename T, typename Compare, std::size_t D>
+T& priority_queue<T, Compare, D>::get_front() {
+    if(is_empty()) throw std::runtime_error("priority_queue empty");
+    return data_.front();
+}
+
+template <typename T, typename Compare, std::size_t D>
+const T& priority_queue<T, Compare, D>::get_front() const {
+    if(is_empty()) throw std::runtime_error("priority_queue empty");
+    return data_.front();
+}
+
+template <typename T, typename Compare, std::size_t D>
+bool priority_queue<T, Compare, D>::is_empty() const { return data_.empty(); }
+
+template <typename T, typename Compare, std::size_t D>
+std::size_t priority_queue<T, Compare, D>::size() const { return data_.size(); }
+
+//память: массив кучи - один блок
+template <typename T, typename Compare, std::size_t D>
+std::size_t priority_queue<T, Compare, D>::memory_usage() const {
+    std::size_t n = sizeof(*this);
+    if(data_.capacity()) n += heap_block_bytes(data_.capacity() * sizeof(T));
+    if(!heap_usage<T>::none)
+        for(const T& v : data_) n += heap_usage<T>::bytes(v);
+    return n;
+}
+
+template <typename T, typename Compare, std::size_t D>
+void priority_queue<T, Compare, D>::reserve(std::size_t n) { data_.reserve(n); }
+
+template <typename T, typename Compare, std::size_t D>
+std::size_t priority_queue<T, Compare, D>::capacity() const { return data_.capacity(); }
+
+//реализация итераторов
+
+template <typename T, typename Compare, std::size_t D>
+typename priority_queue<T, Compare, D>::iterator priority_queue<T, Compare, D>::begin() {
+    return iterator(new heap_iterator(data_.data()));
+}
+
+template <typename T, typename Compare, std::size_t D>
+typename priority_queue<T, Compare, D>::iterator priority_queue<T, Compare, D>::end() {
+    return iterator(new heap_iterator(data_.data() + data_.size()));
+}
+
+template <typename T, typename Compare, std::size_t D>
+typename priority_queue<T, Compare, D>::const_iterator priority_queue<T, Compare, D>::begin() const {
+    return const_iterator(new heap_const_iterator(data_.data()));
+}
+
+template <typename T, typename Compare, std::size_t D>
+typename priority_queue<T, Compare, D>::const_iterator priority_queue<T, Compare, D>::end() const {
+    return const_iterator(new heap_const_iterator(data_.data() + data_.size()));
+}
+
+template <typename T, typename Compare, std::size_t D>
+typename priority_queue<T, Compare, D>::const_iterator priority_queue<T, Compare, D>::cbegin() const {
+    return const_iterator(new heap_const_iterator(data_.data()));
+}
+
+template <typename T, typename Compare, std::size_t D>
+typename priority_queue<T, Compare, D>::const_iterator priority_queue<T, Compare, D>::cend() const {
+    return const_iterator(new heap_const_iterator(data_.data() + data_.size()));
+}
+
+//вспомогательные методы
+
+//подъём: элемент вынимается, родители сдвигаются вниз в дырку, пока меньше него
+template <typename T, typename Compare, std::size_t D>
+void priority_queue<T, Compare, D>::sift_up(std::size_t i) {
+    T v = std::move(data_[i]);
+    while(i > 0) {
+        std::size_t p = (i - 1) / D;
+        if(!cmp_(data_[p], v)) break;
+        data_[i] = std::move(data_[p]);
+        i = p;
+    }
+    data_[i] = std::move(v);
+}
+
+//спуск: на каждом уровне наибольший из D детей, они лежат подряд
+template <typename T, typename Compare, std::size_t D>
+void priority_queue<T, Compare, D>::sift_down(std::size_t i) {
+    const std::size_t n = data_.size();
+    T v = std::move(data_[i]);
+    for(;;) {
+        std::size_t c = i * D + 1;
+        if(c >= n) break;
+        std::size_t last = c + D < n ? c + D : n;
+        std::size_t best = c;
+        for(std::size_t j = c + 1; j < last; ++j)
+            if(cmp_(data_[best], data_[j])) best = j;
+        if(!cmp_(v, data_[best])) break;
+        data_[i] = std::move(data_[best]);
+        i = best;
+    }
+    data_[i] = std::move(v);
+}
+
+//спуск Флойда: дырка идёт до листа по наибольшим детям без сравнения с самим элементом,
+//затем элемент поднимается; последний элемент обычно и так мал, подъём короткий
+template <typename T, typename Compare, std::size_t D>
+void priority_queue<T, Compare, D>::sift_down_leaf(std::size_t i) {
+    const std::size_t n = data_.size();
+    T v = std::move(data_[i]);
+    for(;;) {
+        std::size_t c = i * D + 1;
+        if(c >= n) break;
+        std::size_t last = c + D < n ? c + D : n;
+        std::size_t best = c;
+        for(std::size_t j = c + 1; j < last; ++j)
+            if(cmp_(data_[best], data_[j])) best = j;
+        data_[i] = std::move(data_[best]);
+        i = best;
+    }
+    data_[i] = std::move(v);
+    sift_up(i);
+}
+
+//построение кучи: спуск от последнего родителя к корню
+template <typename T, typename Compare, std::size_t D>
+void priority_queue<T, Compare, D>::heapify() {
+    const std::size_t n = data_.size();
+    if(n < 2) return;
+    for(std::size_t i = (n - 2) / D + 1; i-- > 0; ) sift_down(i);
+}
+
+#endif
@@ -2,56 +2,71 @@
 #define QUEUE_H
 
 #include "fwd_container.h"
+#include "container_policy.h"
+#include "list_view.h"
+#include <algorithm>
+#include <functional>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
-template <typename T>
-// queue -  fwd_container
-class queue : public fwd_container<T> {
-    //  
-    struct Node {
-        T data;             // 
-        Node* next;         //   
-        Node(const T& v, Node* n = nullptr): data(v), next(n) {}            // 
-        Node(T&& v, Node* n = nullptr): data(std::move(v)), next(n) {}      // 
-    };
+template <typename T, typename Policy, typename Compare>
+class loser_tree;
+
+template <typename K, typename V, typename Hash, typename Eq, typename Policy>
+class lru_cache;
+
+template <typename T, typename Policy = default_policy>
+//контейнер queue - потомок fwd_container
+class queue : public fwd_container<T>, private node_storage_t<T, Policy> {
+    using Node = list_node_t<T, Policy>;            // узел списка
+    using storage = node_storage_t<T, Policy>;      // откуда берутся узлы
+
+    Node* front_;           //указатель на 1 элемент
+    Node* back_;            //последний
+    std::size_t sz_;        //количество элементов в контейнере
+
+    using stats = typename Policy::stats;   //хуки статистики, у no_stats пустые
 
-    Node* front_;           //  1 
-    Node* back_;            //
-    std::size_t sz_;        //   
+    static void prefetch_next(const Node* n);   //подгрузить узел после n, если включено в Policy
+
+    template <typename, typename, typename>
+    friend class loser_tree;                    //слияние перецепляет узлы между очередями
+    template <typename, typename, typename, typename, typename>
+    friend class lru_cache;                     //переставляет узлы из середины в конец
 
 public:
-    // 
-    using iterator = typename fwd_container<T>::iterator;                           //      
+    //сокращам имена
+    using iterator = typename fwd_container<T>::iterator;                           //итератор принадлежит кнт с типом данных Т
     using const_iterator = typename fwd_container<T>::const_iterator;
-    using iterator_base = typename fwd_container<T>::iterator_base;                 // 
+    using iterator_base = typename fwd_container<T>::iterator_base;                 //абстрактный итератор
     using const_iterator_base = typename fwd_container<T>::const_iterator_base;
 
     class queue_const_iterator;
 
-    //  
+    // итератор очереди
     class queue_iterator : public iterator_base {
-        Node* cur;                                  //   
-        friend class queue_const_iterator;          // 
+        Node* cur;                                  // текущий узел итератора
+        friend class queue_const_iterator;          //дружеский класс
     public:
-        queue_iterator(Node* n = nullptr);          //   
+        queue_iterator(Node* n = nullptr);          //конструктор с указанием узла
 
-        typename iterator_base::reference operator*() override;     //  
-        typename iterator_base::pointer operator->() override;      //    
+        typename iterator_base::reference operator*() override;     //доступ к элементу
+        typename iterator_base::pointer operator->() override;      //доступ к элементу черещ указатель
         queue_iterator& operator++() override;
 
-        //
+        //сравнения
         bool operator==(const iterator_base& o) const override;
         bool operator!=(const iterator_base& o) const override;
         bool operator==(const const_iterator_base& o) const override;
         bool operator!=(const const_iterator_base& o) const override;
 
     protected:
-        iterator_base* clone() const override;              // 
-        const_iterator_base* make_const() const override;   //  
+        iterator_base* clone() const override;              //копия итератора
+        const_iterator_base* make_const() const override;   //создания конст итератора
     };
 
-    //   
+    // константный итератор очереди
     class queue_const_iterator : public const_iterator_base {
         const Node* cur;
         friend class queue_iterator;
@@ -63,7 +78,7 @@ public:
         typename const_iterator_base::pointer operator->() const override;
         queue_const_iterator& operator++() override;
 
-        //
+        //сравнения
         bool operator==(const const_iterator_base& o) const override;
         bool operator!=(const const_iterator_base& o) const override;
         bool operator==(const iterator_base& o) const override;
@@ -73,33 +88,51 @@ public:
         const_iterator_base* clone() const override;
     };
 
-    // 
-    queue();                                //  
-    ~queue() override;                      //
-    queue(const queue& o);                  // 
-    queue(queue&& o);                       // 
-    queue& operator=(const queue& o);       // 
-    queue& operator=(queue&& o);            // 
+    // конструкторы
+    queue();                                //созданет пустую очередь
+    ~queue() override;                      //диструктор
+    queue(const queue& o);                  //копирующий конструктор
+    queue(queue&& o);                       //перемещающий конструктор
+    queue& operator=(const queue& o);       //копирующее присваивание
+    queue& operator=(queue&& o);            //перемещающее присваивание
 
-    //  
+    //присваивание через баз
     fwd_container<T>& operator=(const fwd_container<T>& o) override;
 
-    //   
-    void push(const T& v) override;         //   
-    void push(T&& v) override;              //   
+    // добавление в конец
+    void push(const T& v) override;         //вставка копированием в конец
+    void push(T&& v) override;              //вставка перемещением в конец
+
+    // удаление
+    T pop() override;                       //удаление из начала
+
+    //пакетные операции
+    void push_many(const T* p, std::size_t n) override;     //p[0] встаёт первым
+    std::size_t pop_many(T* out, std::size_t n) override;   //out[0] - бывшее начало
+    void visit_chunks(typename fwd_container<T>::chunk_fn f, void* ctx) const override;
 
-    // 
-    T pop() override;                       //  
+    //доступ к первому элементу
+    T& get_front() override;                //получить ссылку на 1 э
+    const T& get_front() const override;    //получить конст ссылку на 1 э
 
-    //   
-    T& get_front() override;                //   1 
-    const T& get_front() const override;    //    1 
+    //сортировка перестановкой узлов: без выделения памяти, устойчивая
+    //для целых T с std::less - поразрядная, иначе слиянием снизу вверх за O(n log n)
+    //если cmp или key бросили, все элементы остаются в очереди в неопределённом порядке
+    template <typename Compare = std::less<T>>
+    void sort(Compare cmp = Compare());
+    template <typename Key>
+    void radix_sort(Key key);               //по целому ключу key(v), устойчивая, O(n * sizeof(ключа))
 
-    //
+    //перецепление узлов из другой очереди без копирования, только для хранилищ с portable_nodes
+    void splice(queue& o);                  //все элементы o в конец за O(1), o пустеет
+    void splice_one(queue& o);              //первый элемент o в конец; std::runtime_error, если o пуста
+
+    //пустой
     bool is_empty() const override;
     std::size_t size() const override;
+    std::size_t memory_usage() const override;     //объект + узлы с заголовками malloc + память элементов
 
-    // 
+    // итераторы
     iterator begin() override;
     iterator end() override;
     const_iterator begin() const override;
@@ -107,9 +140,16 @@ public:
     const_iterator cbegin() const override;
     const_iterator cend() const override;
 
+    //вид для std::ranges и std::views: итераторы - указатель на узел, без new и виртуальных вызовов
+    list_view<Node> view();
+    list_view<const Node> view() const;
+
 private:
-    void clear();                           // 
-    void copy_from(const queue& o);         //    
+    void clear();                           //очистка очереди
+    void copy_from(const queue& o);         //копирование эл из другой оч
+    template <typename Compare>
+    static void merge(Node* a, Node* b, Compare& cmp, Node*& out);     //слияние двух отсортированных цепочек в out
+    void relink(Node* const* parts, std::size_t n, Node* rest);       //собрать куски в одну цепочку после исключения
 };
 
 #include "queue_impl.h"
@@ -1,154 +1,165 @@
 #ifndef QUEUE_IMPL_H
 #define QUEUE_IMPL_H
 
-// queue_iterator
-
-//
-template <typename T>
-queue<T>::queue_iterator::queue_iterator(Node* n): cur(n) {}
-
-//  
-template <typename T>
-typename queue<T>::iterator_base::reference
-queue<T>::queue_iterator::operator*() { return cur->data; }
-
-//  
-template <typename T>
-typename queue<T>::iterator_base::pointer
-queue<T>::queue_iterator::operator->() { return &cur->data; }
-
-// 
-template <typename T>
-typename queue<T>::queue_iterator&
-queue<T>::queue_iterator::operator++() {
-    if(cur) cur = cur->next;
+//реализация queue_iterator
+
+//конструктор
+template <typename T, typename Policy>
+queue<T, Policy>::queue_iterator::queue_iterator(Node* n): cur(n) {}
+
+//возвращает данные узла
+template <typename T, typename Policy>
+typename queue<T, Policy>::iterator_base::reference
+queue<T, Policy>::queue_iterator::operator*() { return cur->data; }
+
+//доступ к полю
+template <typename T, typename Policy>
+typename queue<T, Policy>::iterator_base::pointer
+queue<T, Policy>::queue_iterator::operator->() { return &cur->data; }
+
+//шаг вперед
+template <typename T, typename Policy>
+typename queue<T, Policy>::queue_iterator&
+queue<T, Policy>::queue_iterator::operator++() {
+    if(cur) {
+        cur = cur->next;
+        prefetch_next(cur);
+    }
     return *this;
 }
 
-//  
-template <typename T>
-bool queue<T>::queue_iterator::operator==(const iterator_base& o) const {
+//сравнение с итератором
+template <typename T, typename Policy>
+bool queue<T, Policy>::queue_iterator::operator==(const iterator_base& o) const {
     auto* p = dynamic_cast<const queue_iterator*>(&o);
     return p && cur == p->cur;
 }
 
-template <typename T>
-bool queue<T>::queue_iterator::operator!=(const iterator_base& o) const {
+template <typename T, typename Policy>
+bool queue<T, Policy>::queue_iterator::operator!=(const iterator_base& o) const {
     return !(*this == o);
 }
 
-//   
-template <typename T>
-bool queue<T>::queue_iterator::operator==(const const_iterator_base& o) const {
+//сравнение с константным итератором
+template <typename T, typename Policy>
+bool queue<T, Policy>::queue_iterator::operator==(const const_iterator_base& o) const {
     auto* p = dynamic_cast<const queue_const_iterator*>(&o);
     return p && cur == p->cur;
 }
 
-template <typename T>
-bool queue<T>::queue_iterator::operator!=(const const_iterator_base& o) const {
+template <typename T, typename Policy>
+bool queue<T, Policy>::queue_iterator::operator!=(const const_iterator_base& o) const {
     return !(*this == o);
 }
 
-// 
-template <typename T>
-typename queue<T>::iterator_base*
-queue<T>::queue_iterator::clone() const {
+//копия итератора
+template <typename T, typename Policy>
+typename queue<T, Policy>::iterator_base*
+queue<T, Policy>::queue_iterator::clone() const {
+    stats::on_iter_alloc();
     return new queue_iterator(*this);
 }
 
-//  
-template <typename T>
-typename queue<T>::const_iterator_base*
-queue<T>::queue_iterator::make_const() const {
+//создает константную версию
+template <typename T, typename Policy>
+typename queue<T, Policy>::const_iterator_base*
+queue<T, Policy>::queue_iterator::make_const() const {
+    stats::on_iter_alloc();
     return new queue_const_iterator(cur);
 }
 
-// queue_const_iterator
+//реализация queue_const_iterator
 
-//
-template <typename T>
-queue<T>::queue_const_iterator::queue_const_iterator(const Node* n): cur(n) {}
+//конструктор
+template <typename T, typename Policy>
+queue<T, Policy>::queue_const_iterator::queue_const_iterator(const Node* n): cur(n) {}
 
-//   
-template <typename T>
-queue<T>::queue_const_iterator::queue_const_iterator(const queue_iterator& o): cur(o.cur) {}
+//конструктор из обычного итератора
+template <typename T, typename Policy>
+queue<T, Policy>::queue_const_iterator::queue_const_iterator(const queue_iterator& o): cur(o.cur) {}
 
-//  
-template <typename T>
-typename queue<T>::const_iterator_base::reference
-queue<T>::queue_const_iterator::operator*() const { return cur->data; }
+//возвращает константную ссылку
+template <typename T, typename Policy>
+typename queue<T, Policy>::const_iterator_base::reference
+queue<T, Policy>::queue_const_iterator::operator*() const { return cur->data; }
 
-//  
-template <typename T>
-typename queue<T>::const_iterator_base::pointer
-queue<T>::queue_const_iterator::operator->() const { return &cur->data; }
+//доступ к полю
+template <typename T, typename Policy>
+typename queue<T, Policy>::const_iterator_base::pointer
+queue<T, Policy>::queue_const_iterator::operator->() const { return &cur->data; }
 
-// 
-template <typename T>
-typename queue<T>::queue_const_iterator&
-queue<T>::queue_const_iterator::operator++() {
-    if(cur) cur = cur->next;
+//шаг вперед
+template <typename T, typename Policy>
+typename queue<T, Policy>::queue_const_iterator&
+queue<T, Policy>::queue_const_iterator::operator++() {
+    if(cur) {
+        cur = cur->next;
+        prefetch_next(cur);
+    }
     return *this;
 }
 
-//   
-template <typename T>
-bool queue<T>::queue_const_iterator::operator==(const const_iterator_base& o) const {
+//сравнение с константным итератором
+template <typename T, typename Policy>
+bool queue<T, Policy>::queue_const_iterator::operator==(const const_iterator_base& o) const {
     auto* p = dynamic_cast<const queue_const_iterator*>(&o);
     return p && cur == p->cur;
 }
 
-template <typename T>
-bool queue<T>::queue_const_iterator::operator!=(const const_iterator_base& o) const {
+template <typename T, typename Policy>
+bool queue<T, Policy>::queue_const_iterator::operator!=(const const_iterator_base& o) const {
     return !(*this == o);
 }
 
-//   
-template <typename T>
-bool queue<T>::queue_const_iterator::operator==(const iterator_base& o) const {
+//сравнение с обычным итератором
+template <typename T, typename Policy>
+bool queue<T, Policy>::queue_const_iterator::operator==(const iterator_base& o) const {
     auto* p = dynamic_cast<const queue_iterator*>(&o);
     return p && cur == p->cur;
 }
 
-template <typename T>
-bool queue<T>::queue_const_iterator::operator!=(const iterator_base& o) const {
+template <typename T, typename Policy>
+bool queue<T, Policy>::queue_const_iterator::operator!=(const iterator_base& o) const {
     return !(*this == o);
 }
 
-// 
-template <typename T>
-typename queue<T>::const_iterator_base*
-queue<T>::queue_const_iterator::clone() const {
+//копия итератора
+template <typename T, typename Policy>
+typename queue<T, Policy>::const_iterator_base*
+queue<T, Policy>::queue_const_iterator::clone() const {
+    stats::on_iter_alloc();
     return new queue_const_iterator(*this);
 }
 
-//    
+//реализация конструкторов и деструктора очереди
 
-//  
-template <typename T>
-queue<T>::queue(): front_(nullptr), back_(nullptr), sz_(0) {}
+//создает пустую очередь
+template <typename T, typename Policy>
+queue<T, Policy>::queue(): front_(nullptr), back_(nullptr), sz_(0) {}
 
-//
-template <typename T>
-queue<T>::~queue() { clear(); }
+//деструктор
+template <typename T, typename Policy>
+queue<T, Policy>::~queue() { clear(); }
 
-// 
-template <typename T>
-queue<T>::queue(const queue& o): front_(nullptr), back_(nullptr), sz_(0) {
+//копирующий конструктор
+template <typename T, typename Policy>
+queue<T, Policy>::queue(const queue& o): fwd_container<T>(), storage(), front_(nullptr), back_(nullptr), sz_(0) {
+    stats::on_copy();
     copy_from(o);
 }
 
-// 
-template <typename T>
-queue<T>::queue(queue&& o): front_(o.front_), back_(o.back_), sz_(o.sz_) {
+//перемещающий конструктор
+template <typename T, typename Policy>
+queue<T, Policy>::queue(queue&& o): storage(std::move(o)), front_(o.front_), back_(o.back_), sz_(o.sz_) {
     o.front_ = nullptr;
     o.back_ = nullptr;
     o.sz_ = 0;
 }
 
-// 
-template <typename T>
-queue<T>& queue<T>::operator=(const queue& o) {
+//копирующее присваивание
+template <typename T, typename Policy>
+queue<T, Policy>& queue<T, Policy>::operator=(const queue& o) {
+    stats::on_assign();
     if(this != &o) {
         clear();
         copy_from(o);
@@ -156,11 +167,12 @@ queue<T>& queue<T>::operator=(const queue& o) {
     return *this;
 }
 
-// 
-template <typename T>
-queue<T>& queue<T>::operator=(queue&& o) {
+//перемещающее присваивание
+template <typename T, typename Policy>
+queue<T, Policy>& queue<T, Policy>::operator=(queue&& o) {
     if(this != &o) {
         clear();
+        storage::operator=(std::move(o));   //узлы o переезжают вместе с его хранилищем
         front_ = o.front_;
         back_ = o.back_;
         sz_ = o.sz_;
@@ -171,18 +183,19 @@ queue<T>& queue<T>::operator=(queue&& o) {
     return *this;
 }
 
-//   
-template <typename T>
-fwd_container<T>& queue<T>::operator=(const fwd_container<T>& o) {
+//присваивание через базовый класс
+template <typename T, typename Policy>
+fwd_container<T>& queue<T, Policy>::operator=(const fwd_container<T>& o) {
+    stats::on_assign();
     return fwd_container<T>::operator=(o);
 }
 
-//  
+//реализация методов контейнера
 
-//   
-template <typename T>
-void queue<T>::push(const T& v) {
-    Node* n = new Node(v);
+//вставка копированием в конец
+template <typename T, typename Policy>
+void queue<T, Policy>::push(const T& v) {
+    Node* n = this->make_node(v);
     if(is_empty()) {
         front_ = back_ = n;
     } else {
@@ -190,12 +203,15 @@ void queue<T>::push(const T& v) {
         back_ = n;
     }
     sz_++;
+    stats::on_node_alloc();
+    stats::on_push();
+    stats::on_size(sz_);
 }
 
-//   
-template <typename T>
-void queue<T>::push(T&& v) {
-    Node* n = new Node(std::move(v));
+//вставка перемещением в конец
+template <typename T, typename Policy>
+void queue<T, Policy>::push(T&& v) {
+    Node* n = this->make_node(std::move(v));
     if(is_empty()) {
         front_ = back_ = n;
     } else {
@@ -203,103 +219,391 @@ void queue<T>::push(T&& v) {
         back_ = n;
     }
     sz_++;
+    stats::on_node_alloc();
+    stats::on_push();
+    stats::on_size(sz_);
 }
 
-//  
-template <typename T>
-T queue<T>::pop() {
-    if(is_empty()) throw std::runtime_error(" ");
+//удаление из начала
+template <typename T, typename Policy>
+T queue<T, Policy>::pop() {
+    if(is_empty()) throw std::runtime_error("очередь пуста");
     Node* tmp = front_;
     T val = std::move(front_->data);
     front_ = front_->next;
     if(front_ == nullptr) back_ = nullptr;
-    delete tmp;
+    this->free_node(tmp);
     sz_--;
+    stats::on_node_free();
+    stats::on_pop();
     return val;
 }
 
-//   
-template <typename T>
-T& queue<T>::get_front() {
+//пакетная вставка: цепочка собирается отдельно и пристёгивается к концу за один шаг,
+//при исключении очередь не меняется
+template <typename T, typename Policy>
+void queue<T, Policy>::push_many(const T* p, std::size_t n) {
+    if(n == 0) return;
+    Node* first = nullptr;
+    Node* last = nullptr;
+    try {
+        first = last = this->make_node(p[0]);
+        for(std::size_t i = 1; i < n; ++i) {
+            last->next = this->make_node(p[i]);
+            last = last->next;
+        }
+    } catch(...) {
+        while(first) {
+            Node* t = first;
+            first = first->next;
+            this->free_node(t);
+        }
+        throw;
+    }
+    if(is_empty()) front_ = first;
+    else back_->next = first;
+    back_ = last;
+    sz_ += n;
+    stats::on_node_alloc(n);
+    stats::on_push(n);
+    stats::on_size(sz_);
+}
+
+//пакетное снятие из начала
+template <typename T, typename Policy>
+std::size_t queue<T, Policy>::pop_many(T* out, std::size_t n) {
+    std::size_t k = 0;
+    //счётчики - одним вызовом после цикла; если присваивание бросило, элемент остался на месте
+    auto settle = [&] {
+        if(front_ == nullptr) back_ = nullptr;
+        sz_ -= k;
+        stats::on_node_free(k);
+        stats::on_pop(k);
+    };
+    try {
+        for(; k < n && front_; ++k) {
+            Node* t = front_;
+            out[k] = std::move(t->data);
+            front_ = t->next;
+            prefetch_next(front_);
+            this->free_node(t);
+        }
+    } catch(...) {
+        settle();
+        throw;
+    }
+    settle();
+    return k;
+}
+
+//обход порциями от начала
+template <typename T, typename Policy>
+void queue<T, Policy>::visit_chunks(typename fwd_container<T>::chunk_fn f, void* ctx) const {
+    visit_list_chunks(front_, f, ctx);
+}
+
+//сортировка слиянием снизу вверх: bins[i] - отсортированная цепочка из 2^i узлов,
+//очередной узел переносится по разрядам как при сложении двоичных чисел
+template <typename T, typename Policy>
+template <typename Compare>
+void queue<T, Policy>::sort(Compare cmp) {
+    if(sz_ < 2) return;
+    if constexpr(std::is_integral<T>::value && !std::is_same<T, bool>::value
+                 && (std::is_same<Compare, std::less<T>>::value || std::is_same<Compare, std::less<>>::value)) {
+        radix_sort([](const T& v) { return v; });
+    } else {
+        Node* bins[64] = {};
+        Node* carry = nullptr;                          //цепочка, которая переносится в старший разряд
+        Node* p = front_;
+        try {
+            while(p) {
+                carry = p;
+                p = p->next;
+                carry->next = nullptr;
+                std::size_t i = 0;
+                for(; bins[i]; ++i) {
+                    Node* b = bins[i];                  //в bins[i] узлы, стоявшие раньше
+                    bins[i] = nullptr;
+                    merge(b, carry, cmp, carry);
+                }
+                bins[i] = carry;
+                carry = nullptr;
+            }
+            for(Node*& b : bins) {
+                if(!b) continue;
+                Node* c = b;
+                b = nullptr;
+                if(carry) merge(c, carry, cmp, carry);
+                else carry = c;
+            }
+        } catch(...) {
+            bins[63] = carry;                           //старший разряд не бывает занят: узлов меньше 2^63
+            relink(bins, 64, p);
+            throw;
+        }
+        front_ = carry;
+        for(back_ = carry; back_->next; back_ = back_->next) prefetch_next(back_);
+    }
+}
+
+//при равенстве первым идёт узел из a, поэтому сортировка устойчива
+//если cmp бросил, в out все узлы a и b одной цепочкой
+template <typename T, typename Policy>
+template <typename Compare>
+void queue<T, Policy>::merge(Node* a, Node* b, Compare& cmp, Node*& out) {
+    Node** t = &out;
+    try {
+        while(a && b) {
+            if(cmp(b->data, a->data)) {
+                *t = b;
+                b = b->next;
+            } else {
+                *t = a;
+                a = a->next;
+            }
+            t = &(*t)->next;
+        }
+    } catch(...) {
+        *t = a;
+        while(*t) t = &(*t)->next;
+        *t = b;
+        throw;
+    }
+    *t = a ? a : b;
+}
+
+//после исключения в сортировке: непустые куски подряд, за ними нетронутый остаток rest
+template <typename T, typename Policy>
+void queue<T, Policy>::relink(Node* const* parts, std::size_t n, Node* rest) {
+    Node* r = nullptr;
+    Node** t = &r;
+    for(std::size_t i = 0; i < n; ++i) {
+        if(!parts[i]) continue;
+        *t = parts[i];
+        while(*t) t = &(*t)->next;
+    }
+    *t = rest;
+    front_ = r;
+    back_ = r;
+    if(back_) while(back_->next) back_ = back_->next;
+}
+
+//поразрядная сортировка по байтам ключа, младший первым
+//узлы переставляются по 256 корзинам, каждый проход - обход списка с промахами кэша,
+//поэтому гистограммы всех разрядов считаются в первом проходе, а разряд, где все узлы
+//в одной корзине, пропускается
+template <typename T, typename Policy>
+template <typename Key>
+void queue<T, Policy>::radix_sort(Key key) {
+    using K = std::decay_t<decltype(key(front_->data))>;
+    static_assert(std::is_integral<K>::value && !std::is_same<K, bool>::value, "radix_sort: ключ должен быть целым");
+    using U = std::make_unsigned_t<K>;
+    constexpr std::size_t digits = sizeof(U);
+    if(sz_ < 2) return;
+
+    //знаковый ключ: инверсия старшего бита ставит отрицательные перед положительными
+    auto ukey = [&key](const Node* n) {
+        U u = static_cast<U>(key(n->data));
+        if constexpr(std::is_signed<K>::value) u = static_cast<U>(u ^ (U(1) << (digits * 8 - 1)));
+        return u;
+    };
+
+    std::size_t hist[digits][256] = {};
+    Node* heads[256];
+    Node* tails[256];
+    for(std::size_t d = 0; d < digits; ++d) {
+        if(d > 0 && hist[d][(ukey(front_) >> (d * 8)) & 0xff] == sz_) continue;
+        std::fill(heads, heads + 256, nullptr);
+        Node* p = front_;
+        try {
+            while(p) {
+                Node* next = p->next;
+                prefetch_next(p);
+                U u = ukey(p);
+                if(d == 0)
+                    for(std::size_t i = 1; i < digits; ++i) hist[i][(u >> (i * 8)) & 0xff]++;
+                std::size_t b = (u >> (d * 8)) & 0xff;
+                if(heads[b]) tails[b]->next = p;
+                else heads[b] = p;
+                tails[b] = p;
+                p = next;
+            }
+        } catch(...) {
+            //key бросил: корзины и необработанный остаток
+            for(std::size_t b = 0; b < 256; ++b)
+                if(heads[b]) tails[b]->next = nullptr;
+            relink(heads, 256, p);
+            throw;
+        }
+        Node* last = nullptr;
+        for(std::size_t b = 0; b < 256; ++b) {
+            if(!heads[b]) continue;
+            if(last) last->next = heads[b];
+            else front_ = heads[b];
+            last = tails[b];
+        }
+        last->next = nullptr;
+        back_ = last;
+    }
+}
+
+//вся цепочка o пристёгивается к хвосту
+template <typename T, typename Policy>
+void queue<T, Policy>::splice(queue& o) {
+    static_assert(storage::portable_nodes, "splice: узлы этого хранилища нельзя переносить между очередями");
+    if(this == &o || o.is_empty()) return;
+    if(is_empty()) front_ = o.front_;
+    else back_->next = o.front_;
+    back_ = o.back_;
+    sz_ += o.sz_;
+    o.front_ = o.back_ = nullptr;
+    o.sz_ = 0;
+    stats::on_size(sz_);
+}
+
+//первый узел o переезжает в конец
+template <typename T, typename Policy>
+void queue<T, Policy>::splice_one(queue& o) {
+    static_assert(storage::portable_nodes, "splice_one: узлы этого хранилища нельзя переносить между очередями");
+    if(o.is_empty()) throw std::runtime_error("очередь пуста");
+    Node* n = o.front_;
+    prefetch_next(n);                       //раскладка корзин идёт подряд по o
+    o.front_ = n->next;
+    if(o.front_ == nullptr) o.back_ = nullptr;
+    o.sz_--;
+    n->next = nullptr;
+    if(is_empty()) front_ = n;
+    else back_->next = n;
+    back_ = n;
+    sz_++;
+    stats::on_size(sz_);
+}
+
+//доступ к первому элементу
+template <typename T, typename Policy>
+T& queue<T, Policy>::get_front() {
     if(is_empty()) throw std::runtime_error("queue empty");
     return front_->data;
 }
 
-//    
-template <typename T>
-const T& queue<T>::get_front() const {
+//константный доступ к первому элементу
+template <typename T, typename Policy>
+const T& queue<T, Policy>::get_front() const {
     if(is_empty()) throw std::runtime_error("queue empty");
     return front_->data;
 }
 
-//
-template <typename T>
-bool queue<T>::is_empty() const { return front_ == nullptr; }
-
-//
-template <typename T>
-std::size_t queue<T>::size() const { return sz_; }
+//пустой
+template <typename T, typename Policy>
+bool queue<T, Policy>::is_empty() const { return front_ == nullptr; }
+
+//размер
+template <typename T, typename Policy>
+std::size_t queue<T, Policy>::size() const { return sz_; }
+
+//память: узлы считает хранилище - отдельные блоки кучи или блоки арены
+template <typename T, typename Policy>
+std::size_t queue<T, Policy>::memory_usage() const {
+    std::size_t n = sizeof(*this) + this->node_bytes(sz_);
+    if(!heap_usage<T>::none)
+        for(const Node* p = front_; p; p = p->next) n += heap_usage<T>::bytes(p->data);
+    return n;
+}
 
-// 
+//реализация итераторов
 
-//  
-template <typename T>
-typename queue<T>::iterator queue<T>::begin() {
+//итератор на начало
+template <typename T, typename Policy>
+typename queue<T, Policy>::iterator queue<T, Policy>::begin() {
+    stats::on_iter_alloc();
     return iterator(new queue_iterator(front_));
 }
 
-//  
-template <typename T>
-typename queue<T>::iterator queue<T>::end() {
+//итератор на конец
+template <typename T, typename Policy>
+typename queue<T, Policy>::iterator queue<T, Policy>::end() {
+    stats::on_iter_alloc();
     return iterator(new queue_iterator(nullptr));
 }
 
-//   
-template <typename T>
-typename queue<T>::const_iterator queue<T>::begin() const {
+//константный итератор на начало
+template <typename T, typename Policy>
+typename queue<T, Policy>::const_iterator queue<T, Policy>::begin() const {
+    stats::on_iter_alloc();
     return const_iterator(new queue_const_iterator(front_));
 }
 
-//   
-template <typename T>
-typename queue<T>::const_iterator queue<T>::end() const {
+//константный итератор на конец
+template <typename T, typename Policy>
+typename queue<T, Policy>::const_iterator queue<T, Policy>::end() const {
+    stats::on_iter_alloc();
     return const_iterator(new queue_const_iterator(nullptr));
 }
 
 //cbegin
-template <typename T>
-typename queue<T>::const_iterator queue<T>::cbegin() const {
+template <typename T, typename Policy>
+typename queue<T, Policy>::const_iterator queue<T, Policy>::cbegin() const {
+    stats::on_iter_alloc();
     return const_iterator(new queue_const_iterator(front_));
 }
 
 //cend
-template <typename T>
-typename queue<T>::const_iterator queue<T>::cend() const {
+template <typename T, typename Policy>
+typename queue<T, Policy>::const_iterator queue<T, Policy>::cend() const {
+    stats::on_iter_alloc();
     return const_iterator(new queue_const_iterator(nullptr));
 }
 
-// 
+//вид по узлам от начала
+template <typename T, typename Policy>
+list_view<typename queue<T, Policy>::Node> queue<T, Policy>::view() { return list_view<Node>(front_, sz_); }
+
+template <typename T, typename Policy>
+list_view<const typename queue<T, Policy>::Node> queue<T, Policy>::view() const { return list_view<const Node>(front_, sz_); }
+
+//вспомогательные методы
+
+//предвыборка: стоим на n, процессор уже тянет следующий узел, пока работаем с текущим
+template <typename T, typename Policy>
+void queue<T, Policy>::prefetch_next(const Node* n) {
+    if constexpr(Policy::prefetch) {
+        if(n && n->next) prefetch_read(n->next);
+    }
+}
 
-// 
-template <typename T>
-void queue<T>::clear() {
-    while(front_) {
-        Node* t = front_;
-        front_ = front_->next;
-        delete t;
+//очистка очереди
+template <typename T, typename Policy>
+void queue<T, Policy>::clear() {
+    if constexpr(storage::bulk_release) {
+        stats::on_node_free(sz_);
+        this->release_chain(front_, sz_);   //хранилище освобождает цепочку само, без обхода здесь
+        front_ = nullptr;
+    } else {
+        while(front_) {
+            Node* t = front_;
+            front_ = front_->next;
+            prefetch_next(front_);
+            this->free_node(t);
+            stats::on_node_free();
+        }
     }
     back_ = nullptr;
     sz_ = 0;
 }
 
-//    O(n)
-template <typename T>
-void queue<T>::copy_from(const queue& o) {
-    Node* cur = o.front_;
-    while(cur) {
-        push(cur->data);
-        cur = cur->next;
+//копирование за один проход O(n), узлы пристёгиваются к хвосту без push
+template <typename T, typename Policy>
+void queue<T, Policy>::copy_from(const queue& o) {
+    for(Node* cur = o.front_; cur; cur = cur->next) {
+        prefetch_next(cur);
+        Node* n = this->make_node(cur->data);
+        stats::on_node_alloc();
+        if(back_) back_->next = n;
+        else front_ = n;
+        back_ = n;
+        sz_++;
     }
+    stats::on_size(sz_);
 }
 
 #endif
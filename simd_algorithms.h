@@ -0,0 +1,83 @@
+#ifndef SIMD_ALGORITHMS_H
+#define SIMD_ALGORITHMS_H
+
+#include "fwd_container.h"
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define FWD_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define FWD_SIMD_X86 0
+#endif
+
+//алгоритмы над всем контейнером: обход идёт порциями через for_each_chunk,
+//а каждая порция - непрерывный массив, который обрабатывается векторно
+//вместо виртуального шага итератора и перехода по указателю на каждый элемент
+
+//сумма: целые складываются в long long, дробные - в double
+template <typename T>
+using sum_type_t = std::conditional_t<std::is_floating_point<T>::value, double, long long>;
+
+//ядра над непрерывным отрезком p[0..n), скалярные, для любого арифметического T
+template <typename T>
+struct scalar_kernel {
+    static std::size_t find(const T* p, std::size_t n, T v);      //индекс первого v или n
+    static std::size_t count(const T* p, std::size_t n, T v);
+    static sum_type_t<T> sum(const T* p, std::size_t n);
+    static T min(const T* p, std::size_t n);                        //n > 0
+    static T max(const T* p, std::size_t n);
+};
+
+//векторные ядра: SSE2 и AVX2 (выбор при первом вызове по cpuid) для int и double,
+//для остальных T и не-x86 - скалярные
+//сумма double векторами складывается в другом порядке, младшие разряды могут отличаться от скалярной
+//min/max для double при NaN в данных не определены
+template <typename T>
+struct simd_kernel : scalar_kernel<T> {};
+
+#if FWD_SIMD_X86
+template <>
+struct simd_kernel<int> {
+    static std::size_t find(const int* p, std::size_t n, int v);
+    static std::size_t count(const int* p, std::size_t n, int v);
+    static long long sum(const int* p, std::size_t n);
+    static int min(const int* p, std::size_t n);
+    static int max(const int* p, std::size_t n);
+};
+
+template <>
+struct simd_kernel<double> {
+    static std::size_t find(const double* p, std::size_t n, double v);
+    static std::size_t count(const double* p, std::size_t n, double v);
+    static double sum(const double* p, std::size_t n);
+    static double min(const double* p, std::size_t n);
+    static double max(const double* p, std::size_t n);
+};
+#endif
+
+//алгоритмы над контейнером, только для арифметических T
+template <typename T>
+std::size_t fwd_find(const fwd_container<T>& c, const T& v);      //позиция в порядке обхода или size()
+
+template <typename T>
+std::size_t fwd_count(const fwd_container<T>& c, const T& v);
+
+template <typename T>
+sum_type_t<T> fwd_sum(const fwd_container<T>& c);
+
+template <typename T>
+T fwd_min(const fwd_container<T>& c);                               //std::runtime_error на пустом
+
+template <typename T>
+T fwd_max(const fwd_container<T>& c);
+
+template <typename T, typename Pred>
+bool fwd_any_of(const fwd_container<T>& c, Pred pred);             //обход порциями, остановка на первом
+
+#include "simd_algorithms_impl.h"
+
+#endif
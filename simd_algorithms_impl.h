@@ -0,0 +1,406 @@
+#ifndef SIMD_ALGORITHMS_IMPL_H
+#define SIMD_ALGORITHMS_IMPL_H
+
+//реализация scalar_kernel
+
+template <typename T>
+std::size_t scalar_kernel<T>::find(const T* p, std::size_t n, T v) {
+    for(std::size_t i = 0; i < n; ++i)
+        if(p[i] == v) return i;
+    return n;
+}
+
+template <typename T>
+std::size_t scalar_kernel<T>::count(const T* p, std::size_t n, T v) {
+    std::size_t k = 0;
+    for(std::size_t i = 0; i < n; ++i) k += p[i] == v;
+    return k;
+}
+
+template <typename T>
+sum_type_t<T> scalar_kernel<T>::sum(const T* p, std::size_t n) {
+    sum_type_t<T> s = 0;
+    for(std::size_t i = 0; i < n; ++i) s += p[i];
+    return s;
+}
+
+template <typename T>
+T scalar_kernel<T>::min(const T* p, std::size_t n) {
+    T m = p[0];
+    for(std::size_t i = 1; i < n; ++i)
+        if(p[i] < m) m = p[i];
+    return m;
+}
+
+template <typename T>
+T scalar_kernel<T>::max(const T* p, std::size_t n) {
+    T m = p[0];
+    for(std::size_t i = 1; i < n; ++i)
+        if(m < p[i]) m = p[i];
+    return m;
+}
+
+#if FWD_SIMD_X86
+
+//AVX2 есть в процессоре; при сборке с -mavx2 проверка не нужна
+inline bool simd_has_avx2() {
+#ifdef __AVX2__
+    return true;
+#else
+    static const bool r = __builtin_cpu_supports("avx2");
+    return r;
+#endif
+}
+
+//ядра int на AVX2: 8 элементов за шаг
+
+__attribute__((target("avx2"))) inline std::size_t avx2_find_int(const int* p, std::size_t n, int v) {
+    const __m256i x = _mm256_set1_epi32(v);
+    std::size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        __m256i e = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)), x);
+        int m = _mm256_movemask_ps(_mm256_castsi256_ps(e));
+        if(m) return i + __builtin_ctz(m);
+    }
+    return i + scalar_kernel<int>::find(p + i, n - i, v);
+}
+
+__attribute__((target("avx2"))) inline std::size_t avx2_count_int(const int* p, std::size_t n, int v) {
+    const __m256i x = _mm256_set1_epi32(v);
+    std::size_t k = 0, i = 0;
+    for(; i + 8 <= n; i += 8) {
+        __m256i e = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)), x);
+        k += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(e)));
+    }
+    return k + scalar_kernel<int>::count(p + i, n - i, v);
+}
+
+__attribute__((target("avx2"))) inline long long avx2_sum_int(const int* p, std::size_t n) {
+    __m256i acc = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(e)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(e, 1)));
+    }
+    alignas(32) long long lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalar_kernel<int>::sum(p + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline int avx2_min_int(const int* p, std::size_t n) {
+    if(n < 8) return scalar_kernel<int>::min(p, n);
+    __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    std::size_t i = 8;
+    for(; i + 8 <= n; i += 8) m = _mm256_min_epi32(m, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+    alignas(32) int lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), m);
+    int r = scalar_kernel<int>::min(lanes, 8);
+    return i < n ? std::min(r, scalar_kernel<int>::min(p + i, n - i)) : r;
+}
+
+__attribute__((target("avx2"))) inline int avx2_max_int(const int* p, std::size_t n) {
+    if(n < 8) return scalar_kernel<int>::max(p, n);
+    __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    std::size_t i = 8;
+    for(; i + 8 <= n; i += 8) m = _mm256_max_epi32(m, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+    alignas(32) int lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), m);
+    int r = scalar_kernel<int>::max(lanes, 8);
+    return i < n ? std::max(r, scalar_kernel<int>::max(p + i, n - i)) : r;
+}
+
+//ядра int на SSE2: 4 элемента за шаг, SSE2 есть на любом x86-64
+
+inline std::size_t sse2_find_int(const int* p, std::size_t n, int v) {
+    const __m128i x = _mm_set1_epi32(v);
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        __m128i e = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)), x);
+        int m = _mm_movemask_ps(_mm_castsi128_ps(e));
+        if(m) return i + __builtin_ctz(m);
+    }
+    return i + scalar_kernel<int>::find(p + i, n - i, v);
+}
+
+inline std::size_t sse2_count_int(const int* p, std::size_t n, int v) {
+    const __m128i x = _mm_set1_epi32(v);
+    std::size_t k = 0, i = 0;
+    for(; i + 4 <= n; i += 4) {
+        __m128i e = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)), x);
+        k += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(e)));
+    }
+    return k + scalar_kernel<int>::count(p + i, n - i, v);
+}
+
+//расширение до 64 бит через маску знака: в SSE2 нет cvtepi32_epi64
+inline long long sse2_sum_int(const int* p, std::size_t n) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = zero;
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        __m128i sign = _mm_cmpgt_epi32(zero, e);
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(e, sign));
+        acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(e, sign));
+    }
+    alignas(16) long long lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    return lanes[0] + lanes[1] + scalar_kernel<int>::sum(p + i, n - i);
+}
+
+//в SSE2 нет min_epi32: выбор по маске сравнения
+inline __m128i sse2_select_int(__m128i mask, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+inline int sse2_min_int(const int* p, std::size_t n) {
+    if(n < 4) return scalar_kernel<int>::min(p, n);
+    __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    std::size_t i = 4;
+    for(; i + 4 <= n; i += 4) {
+        __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        m = sse2_select_int(_mm_cmplt_epi32(e, m), e, m);
+    }
+    alignas(16) int lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), m);
+    int r = scalar_kernel<int>::min(lanes, 4);
+    return i < n ? std::min(r, scalar_kernel<int>::min(p + i, n - i)) : r;
+}
+
+inline int sse2_max_int(const int* p, std::size_t n) {
+    if(n < 4) return scalar_kernel<int>::max(p, n);
+    __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    std::size_t i = 4;
+    for(; i + 4 <= n; i += 4) {
+        __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        m = sse2_select_int(_mm_cmpgt_epi32(e, m), e, m);
+    }
+    alignas(16) int lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), m);
+    int r = scalar_kernel<int>::max(lanes, 4);
+    return i < n ? std::max(r, scalar_kernel<int>::max(p + i, n - i)) : r;
+}
+
+inline std::size_t simd_kernel<int>::find(const int* p, std::size_t n, int v) {
+    return simd_has_avx2() ? avx2_find_int(p, n, v) : sse2_find_int(p, n, v);
+}
+
+inline std::size_t simd_kernel<int>::count(const int* p, std::size_t n, int v) {
+    return simd_has_avx2() ? avx2_count_int(p, n, v) : sse2_count_int(p, n, v);
+}
+
+inline long long simd_kernel<int>::sum(const int* p, std::size_t n) {
+    return simd_has_avx2() ? avx2_sum_int(p, n) : sse2_sum_int(p, n);
+}
+
+inline int simd_kernel<int>::min(const int* p, std::size_t n) {
+    return simd_has_avx2() ? avx2_min_int(p, n) : sse2_min_int(p, n);
+}
+
+inline int simd_kernel<int>::max(const int* p, std::size_t n) {
+    return simd_has_avx2() ? avx2_max_int(p, n) : sse2_max_int(p, n);
+}
+
+//ядра double на AVX2: 4 элемента за шаг
+
+__attribute__((target("avx2"))) inline std::size_t avx2_find_double(const double* p, std::size_t n, double v) {
+    const __m256d x = _mm256_set1_pd(v);
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        int m = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(p + i), x, _CMP_EQ_OQ));
+        if(m) return i + __builtin_ctz(m);
+    }
+    return i + scalar_kernel<double>::find(p + i, n - i, v);
+}
+
+__attribute__((target("avx2"))) inline std::size_t avx2_count_double(const double* p, std::size_t n, double v) {
+    const __m256d x = _mm256_set1_pd(v);
+    std::size_t k = 0, i = 0;
+    for(; i + 4 <= n; i += 4)
+        k += __builtin_popcount(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(p + i), x, _CMP_EQ_OQ)));
+    return k + scalar_kernel<double>::count(p + i, n - i, v);
+}
+
+//два аккумулятора, чтобы сложения не ждали друг друга
+__attribute__((target("avx2"))) inline double avx2_sum_double(const double* p, std::size_t n) {
+    __m256d a = _mm256_setzero_pd(), b = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        a = _mm256_add_pd(a, _mm256_loadu_pd(p + i));
+        b = _mm256_add_pd(b, _mm256_loadu_pd(p + i + 4));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, _mm256_add_pd(a, b));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalar_kernel<double>::sum(p + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline double avx2_min_double(const double* p, std::size_t n) {
+    if(n < 4) return scalar_kernel<double>::min(p, n);
+    __m256d m = _mm256_loadu_pd(p);
+    std::size_t i = 4;
+    for(; i + 4 <= n; i += 4) m = _mm256_min_pd(m, _mm256_loadu_pd(p + i));
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, m);
+    double r = scalar_kernel<double>::min(lanes, 4);
+    return i < n ? std::min(r, scalar_kernel<double>::min(p + i, n - i)) : r;
+}
+
+__attribute__((target("avx2"))) inline double avx2_max_double(const double* p, std::size_t n) {
+    if(n < 4) return scalar_kernel<double>::max(p, n);
+    __m256d m = _mm256_loadu_pd(p);
+    std::size_t i = 4;
+    for(; i + 4 <= n; i += 4) m = _mm256_max_pd(m, _mm256_loadu_pd(p + i));
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, m);
+    double r = scalar_kernel<double>::max(lanes, 4);
+    return i < n ? std::max(r, scalar_kernel<double>::max(p + i, n - i)) : r;
+}
+
+//ядра double на SSE2: 2 элемента за шаг
+
+inline std::size_t sse2_find_double(const double* p, std::size_t n, double v) {
+    const __m128d x = _mm_set1_pd(v);
+    std::size_t i = 0;
+    for(; i + 2 <= n; i += 2) {
+        int m = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(p + i), x));
+        if(m) return i + __builtin_ctz(m);
+    }
+    return i + scalar_kernel<double>::find(p + i, n - i, v);
+}
+
+inline std::size_t sse2_count_double(const double* p, std::size_t n, double v) {
+    const __m128d x = _mm_set1_pd(v);
+    std::size_t k = 0, i = 0;
+    for(; i + 2 <= n; i += 2)
+        k += __builtin_popcount(_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(p + i), x)));
+    return k + scalar_kernel<double>::count(p + i, n - i, v);
+}
+
+inline double sse2_sum_double(const double* p, std::size_t n) {
+    __m128d a = _mm_setzero_pd(), b = _mm_setzero_pd();
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        a = _mm_add_pd(a, _mm_loadu_pd(p + i));
+        b = _mm_add_pd(b, _mm_loadu_pd(p + i + 2));
+    }
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, _mm_add_pd(a, b));
+    return lanes[0] + lanes[1] + scalar_kernel<double>::sum(p + i, n - i);
+}
+
+inline double sse2_min_double(const double* p, std::size_t n) {
+    if(n < 2) return scalar_kernel<double>::min(p, n);
+    __m128d m = _mm_loadu_pd(p);
+    std::size_t i = 2;
+    for(; i + 2 <= n; i += 2) m = _mm_min_pd(m, _mm_loadu_pd(p + i));
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, m);
+    double r = std::min(lanes[0], lanes[1]);
+    return i < n ? std::min(r, p[i]) : r;
+}
+
+inline double sse2_max_double(const double* p, std::size_t n) {
+    if(n < 2) return scalar_kernel<double>::max(p, n);
+    __m128d m = _mm_loadu_pd(p);
+    std::size_t i = 2;
+    for(; i + 2 <= n; i += 2) m = _mm_max_pd(m, _mm_loadu_pd(p + i));
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, m);
+    double r = std::max(lanes[0], lanes[1]);
+    return i < n ? std::max(r, p[i]) : r;
+}
+
+inline std::size_t simd_kernel<double>::find(const double* p, std::size_t n, double v) {
+    return simd_has_avx2() ? avx2_find_double(p, n, v) : sse2_find_double(p, n, v);
+}
+
+inline std::size_t simd_kernel<double>::count(const double* p, std::size_t n, double v) {
+    return simd_has_avx2() ? avx2_count_double(p, n, v) : sse2_count_double(p, n, v);
+}
+
+inline double simd_kernel<double>::sum(const double* p, std::size_t n) {
+    return simd_has_avx2() ? avx2_sum_double(p, n) : sse2_sum_double(p, n);
+}
+
+inline double simd_kernel<double>::min(const double* p, std::size_t n) {
+    return simd_has_avx2() ? avx2_min_double(p, n) : sse2_min_double(p, n);
+}
+
+inline double simd_kernel<double>::max(const double* p, std::size_t n) {
+    return simd_has_avx2() ? avx2_max_double(p, n) : sse2_max_double(p, n);
+}
+
+#endif
+
+//алгоритмы над контейнером
+
+//позиция первого v в порядке обхода
+template <typename T>
+std::size_t fwd_find(const fwd_container<T>& c, const T& v) {
+    static_assert(std::is_arithmetic<T>::value, "fwd_find: только для арифметических T");
+    std::size_t pos = 0;
+    c.for_each_chunk([&](const T* p, std::size_t n) {
+        std::size_t i = simd_kernel<T>::find(p, n, v);
+        pos += i;
+        return i == n;
+    });
+    return pos;
+}
+
+template <typename T>
+std::size_t fwd_count(const fwd_container<T>& c, const T& v) {
+    static_assert(std::is_arithmetic<T>::value, "fwd_count: только для арифметических T");
+    std::size_t k = 0;
+    c.for_each_chunk([&](const T* p, std::size_t n) { k += simd_kernel<T>::count(p, n, v); });
+    return k;
+}
+
+template <typename T>
+sum_type_t<T> fwd_sum(const fwd_container<T>& c) {
+    static_assert(std::is_arithmetic<T>::value, "fwd_sum: только для арифметических T");
+    sum_type_t<T> s = 0;
+    c.for_each_chunk([&](const T* p, std::size_t n) { s += simd_kernel<T>::sum(p, n); });
+    return s;
+}
+
+template <typename T>
+T fwd_min(const fwd_container<T>& c) {
+    static_assert(std::is_arithmetic<T>::value, "fwd_min: только для арифметических T");
+    if(c.is_empty()) throw std::runtime_error("fwd_min: empty container");
+    T m = c.get_front();
+    c.for_each_chunk([&](const T* p, std::size_t n) {
+        T x = simd_kernel<T>::min(p, n);
+        if(x < m) m = x;
+    });
+    return m;
+}
+
+template <typename T>
+T fwd_max(const fwd_container<T>& c) {
+    static_assert(std::is_arithmetic<T>::value, "fwd_max: только для арифметических T");
+    if(c.is_empty()) throw std::runtime_error("fwd_max: empty container");
+    T m = c.get_front();
+    c.for_each_chunk([&](const T* p, std::size_t n) {
+        T x = simd_kernel<T>::max(p, n);
+        if(m < x) m = x;
+    });
+    return m;
+}
+
+//предикат произвольный, поэтому без векторов, но и без виртуальных итераторов
+template <typename T, typename Pred>
+bool fwd_any_of(const fwd_container<T>& c, Pred pred) {
+    bool found = false;
+    c.for_each_chunk([&](const T* p, std::size_t n) {
+        for(std::size_t i = 0; i < n; ++i)
+            if(pred(p[i])) {
+                found = true;
+                return false;
+            }
+        return true;
+    });
+    return found;
+}
+
+#endif
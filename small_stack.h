@@ -0,0 +1,113 @@
+#ifndef SMALL_STACK_H
+#define SMALL_STACK_H
+
+#include "fwd_container.h"
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+//стек, который держит первые N элементов прямо в объекте и идёт в кучу только при переполнении
+//элементы лежат подряд: снизу индекс 0, вершина - sz_-1
+template <typename T, std::size_t N = 16>
+class small_stack : public fwd_container<T> {
+    static_assert(N > 0, "small_stack: N должно быть больше нуля");
+
+    alignas(T) unsigned char inline_[N * sizeof(T)];    //встроенный буфер
+    T* data_;               //inline_ или массив в куче
+    std::size_t sz_;        //количество элементов
+    std::size_t cap_;       //вместимость data_
+
+public:
+    using iterator = typename fwd_container<T>::iterator;
+    using const_iterator = typename fwd_container<T>::const_iterator;
+    using iterator_base = typename fwd_container<T>::iterator_base;
+    using const_iterator_base = typename fwd_container<T>::const_iterator_base;
+
+    class small_const_iterator;
+
+    // итератор: идёт от вершины вниз по массиву
+    class small_iterator : public iterator_base {
+        T* base;
+        std::size_t left;           //сколько элементов осталось, текущий - base[left-1]
+        friend class small_const_iterator;
+    public:
+        small_iterator(T* b = nullptr, std::size_t n = 0);
+
+        typename iterator_base::reference operator*() override;
+        typename iterator_base::pointer operator->() override;
+        small_iterator& operator++() override;
+
+        //сравнения
+        bool operator==(const iterator_base& o) const override;
+        bool operator!=(const iterator_base& o) const override;
+        bool operator==(const const_iterator_base& o) const override;
+        bool operator!=(const const_iterator_base& o) const override;
+
+    protected:
+        iterator_base* clone() const override;
+        const_iterator_base* make_const() const override;
+    };
+
+    // константный итератор
+    class small_const_iterator : public const_iterator_base {
+        const T* base;
+        std::size_t left;
+        friend class small_iterator;
+    public:
+        small_const_iterator(const T* b = nullptr, std::size_t n = 0);
+        small_const_iterator(const small_iterator& o);
+
+        typename const_iterator_base::reference operator*() const override;
+        typename const_iterator_base::pointer operator->() const override;
+        small_const_iterator& operator++() override;
+
+        // сравнения
+        bool operator==(const const_iterator_base& o) const override;
+        bool operator!=(const const_iterator_base& o) const override;
+        bool operator==(const iterator_base& o) const override;
+        bool operator!=(const iterator_base& o) const override;
+
+    protected:
+        const_iterator_base* clone() const override;
+    };
+
+    // конструкторы
+    small_stack();                                  //пустой стек во встроенном буфере
+    ~small_stack() override;
+    small_stack(const small_stack& o);
+    small_stack(small_stack&& o);                   //из кучи забираем массив, из буфера - перемещаем элементы
+    small_stack& operator=(const small_stack& o);
+    small_stack& operator=(small_stack&& o);
+    fwd_container<T>& operator=(const fwd_container<T>& o) override;  //присваивание через базу
+
+    void push(const T& v) override;
+    void push(T&& v) override;
+    T pop() override;
+
+    T& get_front() override;
+    const T& get_front() const override;
+
+    bool is_empty() const override;
+    std::size_t size() const override;
+    std::size_t memory_usage() const override;  //объект со встроенным буфером + массив в куче + память элементов
+    std::size_t capacity() const;           //текущая вместимость
+    bool is_inline() const;                 //элементы ещё во встроенном буфере
+
+    iterator begin() override;
+    iterator end() override;
+    const_iterator begin() const override;
+    const_iterator end() const override;
+    const_iterator cbegin() const override;
+    const_iterator cend() const override;
+
+private:
+    T* inline_data();
+    void grow();                            //переезд в кучу с удвоением
+    void clear();                           //удаление элементов и массива в куче
+    void copy_from(const small_stack& o);
+    void move_from(small_stack& o);
+};
+
+#include "small_stack_impl.h"
+
+#endif
@@ -0,0 +1,352 @@
+#ifndef SMALL_STACK_IMPL_H
+#define SMALL_STACK_IMPL_H
+
+//реализация small_iterator
+
+//конструктор: n элементов, начиная с base[n-1]
+template <typename T, std::size_t N>
+small_stack<T, N>::small_iterator::small_iterator(T* b, std::size_t n): base(b), left(n) {}
+
+//разыменование
+template <typename T, std::size_t N>
+typename small_stack<T, N>::iterator_base::reference
+small_stack<T, N>::small_iterator::operator*() { return base[left - 1]; }
+
+//доступ к полю
+template <typename T, std::size_t N>
+typename small_stack<T, N>::iterator_base::pointer
+small_stack<T, N>::small_iterator::operator->() { return &base[left - 1]; }
+
+//шаг к низу стека
+template <typename T, std::size_t N>
+typename small_stack<T, N>::small_iterator&
+small_stack<T, N>::small_iterator::operator++() {
+    if(left) --left;
+    return *this;
+}
+
+//сравнение с итератором
+template <typename T, std::size_t N>
+bool small_stack<T, N>::small_iterator::operator==(const iterator_base& o) const {
+    auto* p = dynamic_cast<const small_iterator*>(&o);
+    return p && left == p->left && (left == 0 || base == p->base);
+}
+
+template <typename T, std::size_t N>
+bool small_stack<T, N>::small_iterator::operator!=(const iterator_base& o) const {
+    return !(*this == o);
+}
+
+//сравнение с константным итератором
+template <typename T, std::size_t N>
+bool small_stack<T, N>::small_iterator::operator==(const const_iterator_base& o) const {
+    auto* p = dynamic_cast<const small_const_iterator*>(&o);
+    return p && left == p->left && (left == 0 || base == p->base);
+}
+
+template <typename T, std::size_t N>
+bool small_stack<T, N>::small_iterator::operator!=(const const_iterator_base& o) const {
+    return !(*this == o);
+}
+
+//копия итератора
+template <typename T, std::size_t N>
+typename small_stack<T, N>::iterator_base*
+small_stack<T, N>::small_iterator::clone() const {
+    return new small_iterator(*this);
+}
+
+//константная версия
+template <typename T, std::size_t N>
+typename small_stack<T, N>::const_iterator_base*
+small_stack<T, N>::small_iterator::make_const() const {
+    return new small_const_iterator(*this);
+}
+
+//реализация small_const_iterator
+
+//конструктор
+template <typename T, std::size_t N>
+small_stack<T, N>::small_const_iterator::small_const_iterator(const T* b, std::size_t n): base(b), left(n) {}
+
+//из обычного итератора
+template <typename T, std::size_t N>
+small_stack<T, N>::small_const_iterator::small_const_iterator(const small_iterator& o): base(o.base), left(o.left) {}
+
+//разыменование
+template <typename T, std::size_t N>
+typename small_stack<T, N>::const_iterator_base::reference
+small_stack<T, N>::small_const_iterator::operator*() const { return base[left - 1]; }
+
+//доступ к полю
+template <typename T, std::size_t N>
+typename small_stack<T, N>::const_iterator_base::pointer
+small_stack<T, N>::small_const_iterator::operator->() const { return &base[left - 1]; }
+
+//шаг к низу стека
+template <typename T, std::size_t N>
+typename small_stack<T, N>::small_const_iterator&
+small_stack<T, N>::small_const_iterator::operator++() {
+    if(left) --left;
+    return *this;
+}
+
+//сравнение с константным итератором
+template <typename T, std::size_t N>
+bool small_stack<T, N>::small_const_iterator::operator==(const const_iterator_base& o) const {
+    auto* p = dynamic_cast<const small_const_iterator*>(&o);
+    return p && left == p->left && (left == 0 || base == p->base);
+}
+
+template <typename T, std::size_t N>
+bool small_stack<T, N>::small_const_iterator::operator!=(const const_iterator_base& o) const {
+    return !(*this == o);
+}
+
+//сравнение с обычным итератором
+template <typename T, std::size_t N>
+bool small_stack<T, N>::small_const_iterator::operator==(const iterator_base& o) const {
+    auto* p = dynamic_cast<const small_iterator*>(&o);
+    return p && left == p->left && (left == 0 || base == p->base);
+}
+
+template <typename T, std::size_t N>
+bool small_stack<T, N>::small_const_iterator::operator!=(const iterator_base& o) const {
+    return !(*this == o);
+}
+
+//копия итератора
+template <typename T, std::size_t N>
+typename small_stack<T, N>::const_iterator_base*
+small_stack<T, N>::small_const_iterator::clone() const {
+    return new small_const_iterator(*this);
+}
+
+//реализация конструкторов и присваиваний
+
+//пустой стек
+template <typename T, std::size_t N>
+small_stack<T, N>::small_stack(): data_(inline_data()), sz_(0), cap_(N) {}
+
+//деструктор
+template <typename T, std::size_t N>
+small_stack<T, N>::~small_stack() { clear(); }
+
+//копирующий конструктор
+template <typename T, std::size_t N>
+small_stack<T, N>::small_stack(const small_stack& o): data_(inline_data()), sz_(0), cap_(N) {
+    copy_from(o);
+}
+
+//перемещающий конструктор
+template <typename T, std::size_t N>
+small_stack<T, N>::small_stack(small_stack&& o): data_(inline_data()), sz_(0), cap_(N) {
+    move_from(o);
+}
+
+//копирующее присваивание
+template <typename T, std::size_t N>
+small_stack<T, N>& small_stack<T, N>::operator=(const small_stack& o) {
+    if(this != &o) {
+        clear();
+        copy_from(o);
+    }
+    return *this;
+}
+
+//перемещающее присваивание
+template <typename T, std::size_t N>
+small_stack<T, N>& small_stack<T, N>::operator=(small_stack&& o) {
+    if(this != &o) {
+        clear();
+        move_from(o);
+    }
+    return *this;
+}
+
+//присваивание через базовый класс
+template <typename T, std::size_t N>
+fwd_container<T>& small_stack<T, N>::operator=(const fwd_container<T>& o) {
+    return fwd_container<T>::operator=(o);
+}
+
+//реализация методов интерфейса
+
+//добавление копированием
+template <typename T, std::size_t N>
+void small_stack<T, N>::push(const T& v) {
+    if(sz_ == cap_) {
+        T tmp(v);               //v может лежать в нашем же массиве
+        grow();
+        ::new (static_cast<void*>(data_ + sz_)) T(std::move(tmp));
+    } else {
+        ::new (static_cast<void*>(data_ + sz_)) T(v);
+    }
+    sz_++;
+}
+
+//добавление перемещением
+template <typename T, std::size_t N>
+void small_stack<T, N>::push(T&& v) {
+    if(sz_ == cap_) {
+        T tmp(std::move(v));
+        grow();
+        ::new (static_cast<void*>(data_ + sz_)) T(std::move(tmp));
+    } else {
+        ::new (static_cast<void*>(data_ + sz_)) T(std::move(v));
+    }
+    sz_++;
+}
+
+//снятие вершины
+template <typename T, std::size_t N>
+T small_stack<T, N>::pop() {
+    if(is_empty()) throw std::runtime_error("small_stack empty");
+    T val = std::move(data_[sz_ - 1]);
+    data_[--sz_].~T();
+    return val;
+}
+
+//вершина
+template <typename T, std::size_t N>
+T& small_stack<T, N>::get_front() {
+    if(is_empty()) throw std::runtime_error("small_stack empty");
+    return data_[sz_ - 1];
+}
+
+//константная вершина
+template <typename T, std::size_t N>
+const T& small_stack<T, N>::get_front() const {
+    if(is_empty()) throw std::runtime_error("small_stack empty");
+    return data_[sz_ - 1];
+}
+
+//пустота
+template <typename T, std::size_t N>
+bool small_stack<T, N>::is_empty() const { return sz_ == 0; }
+
+//размер
+template <typename T, std::size_t N>
+std::size_t small_stack<T, N>::size() const { return sz_; }
+
+//память: встроенный буфер входит в sizeof, массив в куче - один блок
+template <typename T, std::size_t N>
+std::size_t small_stack<T, N>::memory_usage() const {
+    std::size_t n = sizeof(*this);
+    if(!is_inline()) n += heap_block_bytes(cap_ * sizeof(T));
+    if(!heap_usage<T>::none)
+        for(std::size_t i = 0; i < sz_; ++i) n += heap_usage<T>::bytes(data_[i]);
+    return n;
+}
+
+//вместимость
+template <typename T, std::size_t N>
+std::size_t small_stack<T, N>::capacity() const { return cap_; }
+
+//элементы во встроенном буфере
+template <typename T, std::size_t N>
+bool small_stack<T, N>::is_inline() const {
+    return data_ == reinterpret_cast<const T*>(inline_);
+}
+
+//реализация итераторов
+
+template <typename T, std::size_t N>
+typename small_stack<T, N>::iterator small_stack<T, N>::begin() {
+    return iterator(new small_iterator(data_, sz_));
+}
+
+template <typename T, std::size_t N>
+typename small_stack<T, N>::iterator small_stack<T, N>::end() {
+    return iterator(new small_iterator(data_, 0));
+}
+
+template <typename T, std::size_t N>
+typename small_stack<T, N>::const_iterator small_stack<T, N>::begin() const {
+    return const_iterator(new small_const_iterator(data_, sz_));
+}
+
+template <typename T, std::size_t N>
+typename small_stack<T, N>::const_iterator small_stack<T, N>::end() const {
+    return const_iterator(new small_const_iterator(data_, 0));
+}
+
+template <typename T, std::size_t N>
+typename small_stack<T, N>::const_iterator small_stack<T, N>::cbegin() const {
+    return const_iterator(new small_const_iterator(data_, sz_));
+}
+
+template <typename T, std::size_t N>
+typename small_stack<T, N>::const_iterator small_stack<T, N>::cend() const {
+    return const_iterator(new small_const_iterator(data_, 0));
+}
+
+//вспомогательные методы
+
+//встроенный буфер как массив T
+template <typename T, std::size_t N>
+T* small_stack<T, N>::inline_data() {
+    return reinterpret_cast<T*>(inline_);
+}
+
+//удвоение вместимости, элементы переезжают в новый массив
+template <typename T, std::size_t N>
+void small_stack<T, N>::grow() {
+    if(cap_ > std::size_t(-1) / 2 / sizeof(T)) throw std::length_error("small_stack too long");
+    std::size_t cap = cap_ * 2;
+    T* mem = static_cast<T*>(::operator new(cap * sizeof(T)));
+    std::size_t i = 0;
+    try {
+        for(; i < sz_; ++i) ::new (static_cast<void*>(mem + i)) T(std::move_if_noexcept(data_[i]));
+    } catch(...) {
+        while(i > 0) mem[--i].~T();
+        ::operator delete(mem);
+        throw;
+    }
+    for(i = 0; i < sz_; ++i) data_[i].~T();
+    if(!is_inline()) ::operator delete(data_);
+    data_ = mem;
+    cap_ = cap;
+}
+
+//удаление элементов; после clear стек снова во встроенном буфере
+template <typename T, std::size_t N>
+void small_stack<T, N>::clear() {
+    while(sz_ > 0) data_[--sz_].~T();
+    if(!is_inline()) ::operator delete(data_);
+    data_ = inline_data();
+    cap_ = N;
+}
+
+//копирование: сразу нужная вместимость, без промежуточных переездов
+template <typename T, std::size_t N>
+void small_stack<T, N>::copy_from(const small_stack& o) {
+    if(o.sz_ > N) {
+        data_ = static_cast<T*>(::operator new(o.sz_ * sizeof(T)));
+        cap_ = o.sz_;
+    }
+    try {
+        for(; sz_ < o.sz_; ++sz_) ::new (static_cast<void*>(data_ + sz_)) T(o.data_[sz_]);
+    } catch(...) {
+        clear();
+        throw;
+    }
+}
+
+//перемещение: массив из кучи забираем целиком, встроенный буфер - поэлементно
+template <typename T, std::size_t N>
+void small_stack<T, N>::move_from(small_stack& o) {
+    if(!o.is_inline()) {
+        data_ = o.data_;
+        sz_ = o.sz_;
+        cap_ = o.cap_;
+        o.data_ = o.inline_data();
+        o.sz_ = 0;
+        o.cap_ = N;
+        return;
+    }
+    for(; sz_ < o.sz_; ++sz_) ::new (static_cast<void*>(data_ + sz_)) T(std::move(o.data_[sz_]));
+    o.clear();
+}
+
+#endif
@@ -2,21 +2,22 @@
 #define STACK_H
 
 #include "fwd_container.h"
+#include "container_policy.h"
+#include "list_view.h"
 #include <stdexcept>
 #include <utility>
 
-template <typename T>
-class stack : public fwd_container<T> {
-    //  
-    struct Node {
-        T data;
-        Node* next;
-        Node(const T& v, Node* n = nullptr): data(v), next(n) {}
-        Node(T&& v, Node* n = nullptr): data(std::move(v)), next(n) {}
-    };
+template <typename T, typename Policy = default_policy>
+class stack : public fwd_container<T>, private node_storage_t<T, Policy> {
+    using Node = list_node_t<T, Policy>;            // узел списка
+    using storage = node_storage_t<T, Policy>;      // откуда берутся узлы
+
+    Node* top_;         // указатель на верхний элеме
+    std::size_t sz_;    //количество элементов в контейнере
 
-    Node* top_;         //    
-    std::size_t sz_;    //   
+    using stats = typename Policy::stats;   //хуки статистики, у no_stats пустые
+
+    static void prefetch_next(const Node* n);   //подгрузить узел после n, если включено в Policy
 
 public:
     using iterator = typename fwd_container<T>::iterator;
@@ -26,7 +27,7 @@ public:
 
     class stack_const_iterator;
 
-    //  
+    // итератор стека
     class stack_iterator : public iterator_base {
         Node* cur;
         friend class stack_const_iterator;
@@ -37,64 +38,68 @@ public:
         typename iterator_base::pointer operator->() override;
         stack_iterator& operator++() override;
 
-        //
+        //сравнения
         bool operator==(const iterator_base& o) const override;
         bool operator!=(const iterator_base& o) const override;
         bool operator==(const const_iterator_base& o) const override;
         bool operator!=(const const_iterator_base& o) const override;
 
     protected:
-        iterator_base* clone() const override;             // 
-        const_iterator_base* make_const() const override;  //  
+        iterator_base* clone() const override;             //копия итератора
+        const_iterator_base* make_const() const override;  //создание константного итератора
     };
 
-    //   
+    // константный итератор стека
     class stack_const_iterator : public const_iterator_base {
         const Node* cur;
         friend class stack_iterator;
     public:
-        stack_const_iterator(const Node* n = nullptr);        //
-        stack_const_iterator(const stack_iterator& o);        //   
+        stack_const_iterator(const Node* n = nullptr);        //конструктор
+        stack_const_iterator(const stack_iterator& o);        //конструирование из обычного итератора
 
         typename const_iterator_base::reference operator*() const override;
         typename const_iterator_base::pointer operator->() const override;
-        stack_const_iterator& operator++() override;   // 
+        stack_const_iterator& operator++() override;   //шаг итератора
 
-        // 
+        // сравнения
         bool operator==(const const_iterator_base& o) const override;
         bool operator!=(const const_iterator_base& o) const override;
         bool operator==(const iterator_base& o) const override;
         bool operator!=(const iterator_base& o) const override;
 
     protected:
-        const_iterator_base* clone() const override;   // 
+        const_iterator_base* clone() const override;   //копия итератора
     };
 
-    // 
-    stack();                                //  
-    ~stack() override;                      //
-    stack(const stack& o);                  // 
-    stack(stack&& o);                       // 
-    stack& operator=(const stack& o);       //  
-    stack& operator=(stack&& o);            // 
-    fwd_container<T>& operator=(const fwd_container<T>& o) override;  //  
+    // конструкторы
+    stack();                                //создаём пустой стек
+    ~stack() override;                      //деструктор
+    stack(const stack& o);                  //копирующий конструктор
+    stack(stack&& o);                       //перемещающий конструктор
+    stack& operator=(const stack& o);       // копирующее присваивание
+    stack& operator=(stack&& o);            //перемещающее присваивание
+    fwd_container<T>& operator=(const fwd_container<T>& o) override;  //присваивание через баз
 
-    // 
-    void push(const T& v) override;         //    
-    void push(T&& v) override;              //    
+    //добавление элемента
+    void push(const T& v) override;         //вставка копированием в вершину стека
+    void push(T&& v) override;              //вставка перемещением в вершину стека
 
-    //  
+    // удаление элемента
     T pop() override;
+    void push_many(const T* p, std::size_t n) override;     //p[n-1] оказывается на вершине
+    std::size_t pop_many(T* out, std::size_t n) override;   //out[0] - бывшая вершина
+    void visit_chunks(typename fwd_container<T>::chunk_fn f, void* ctx) const override;
 
-    //    
+    // доступ к верхнему элементу
     T& get_front() override;
     const T& get_front() const override;
 
-    //
+    //пустой
     bool is_empty() const override;
     std::size_t size() const override;
+    std::size_t memory_usage() const override;     //объект + узлы с заголовками malloc + память элементов
 
-    //
+    //итераторы
     iterator begin() override;
     iterator end() override;
     const_iterator begin() const override;
@@ -102,9 +107,13 @@ public:
     const_iterator cbegin() const override;
     const_iterator cend() const override;
 
+    //вид для std::ranges и std::views: итераторы - указатель на узел, без new и виртуальных вызовов
+    list_view<Node> view();
+    list_view<const Node> view() const;
+
 private:
-    void clear();                           // 
-    void copy_from(const stack& o);         //      
+    void clear();                           //очистка стека
+    void copy_from(const stack& o);         //копирование элементов другого стека за один проход
 };
 
 #include "stack_impl.h"
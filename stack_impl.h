@@ -1,153 +1,164 @@
 #ifndef STACK_IMPL_H
 #define STACK_IMPL_H
 
-// stack_iterator
-
-//
-template <typename T>
-stack<T>::stack_iterator::stack_iterator(Node* n): cur(n) {}
-
-//  
-template <typename T>
-typename stack<T>::iterator_base::reference
-stack<T>::stack_iterator::operator*() { return cur->data; }
-
-//  
-template <typename T>
-typename stack<T>::iterator_base::pointer
-stack<T>::stack_iterator::operator->() { return &cur->data; }
-
-// 
-template <typename T>
-typename stack<T>::stack_iterator&
-stack<T>::stack_iterator::operator++() {
-    if(cur) cur = cur->next;
+//реализация stack_iterator
+
+//конструктор
+template <typename T, typename Policy>
+stack<T, Policy>::stack_iterator::stack_iterator(Node* n): cur(n) {}
+
+//возвращает данные узла
+template <typename T, typename Policy>
+typename stack<T, Policy>::iterator_base::reference
+stack<T, Policy>::stack_iterator::operator*() { return cur->data; }
+
+//доступ к полю
+template <typename T, typename Policy>
+typename stack<T, Policy>::iterator_base::pointer
+stack<T, Policy>::stack_iterator::operator->() { return &cur->data; }
+
+//шаг вперед
+template <typename T, typename Policy>
+typename stack<T, Policy>::stack_iterator&
+stack<T, Policy>::stack_iterator::operator++() {
+    if(cur) {
+        cur = cur->next;
+        prefetch_next(cur);
+    }
     return *this;
 }
 
-//  
-template <typename T>
-bool stack<T>::stack_iterator::operator==(const iterator_base& o) const {
+//сравнение с итератором
+template <typename T, typename Policy>
+bool stack<T, Policy>::stack_iterator::operator==(const iterator_base& o) const {
     auto* p = dynamic_cast<const stack_iterator*>(&o);
     return p && cur == p->cur;
 }
 
-template <typename T>
-bool stack<T>::stack_iterator::operator!=(const iterator_base& o) const {
+template <typename T, typename Policy>
+bool stack<T, Policy>::stack_iterator::operator!=(const iterator_base& o) const {
     return !(*this == o);
 }
 
-//   
-template <typename T>
-bool stack<T>::stack_iterator::operator==(const const_iterator_base& o) const {
+//сравнение с константным итератором
+template <typename T, typename Policy>
+bool stack<T, Policy>::stack_iterator::operator==(const const_iterator_base& o) const {
     auto* p = dynamic_cast<const stack_const_iterator*>(&o);
     return p && cur == p->cur;
 }
 
-template <typename T>
-bool stack<T>::stack_iterator::operator!=(const const_iterator_base& o) const {
+template <typename T, typename Policy>
+bool stack<T, Policy>::stack_iterator::operator!=(const const_iterator_base& o) const {
     return !(*this == o);
 }
 
-// 
-template <typename T>
-typename stack<T>::iterator_base*
-stack<T>::stack_iterator::clone() const {
+//копия итератора
+template <typename T, typename Policy>
+typename stack<T, Policy>::iterator_base*
+stack<T, Policy>::stack_iterator::clone() const {
+    stats::on_iter_alloc();
     return new stack_iterator(*this);
 }
 
-//  
-template <typename T>
-typename stack<T>::const_iterator_base*
-stack<T>::stack_iterator::make_const() const {
+//создает константную версию
+template <typename T, typename Policy>
+typename stack<T, Policy>::const_iterator_base*
+stack<T, Policy>::stack_iterator::make_const() const {
+    stats::on_iter_alloc();
     return new stack_const_iterator(cur);
 }
 
-// stack_const_iterator
-
-//
-template <typename T>
-stack<T>::stack_const_iterator::stack_const_iterator(const Node* n): cur(n) {}
-
-//   
-template <typename T>
-stack<T>::stack_const_iterator::stack_const_iterator(const stack_iterator& o): cur(o.cur) {}
-
-//  
-template <typename T>
-typename stack<T>::const_iterator_base::reference
-stack<T>::stack_const_iterator::operator*() const { return cur->data; }
-
-//  
-template <typename T>
-typename stack<T>::const_iterator_base::pointer
-stack<T>::stack_const_iterator::operator->() const { return &cur->data; }
-
-// 
-template <typename T>
-typename stack<T>::stack_const_iterator&
-stack<T>::stack_const_iterator::operator++() {
-    if(cur) cur = cur->next;
+//реализация stack_const_iterator
+
+//конструктор
+template <typename T, typename Policy>
+stack<T, Policy>::stack_const_iterator::stack_const_iterator(const Node* n): cur(n) {}
+
+//конструктор из обычного итератора
+template <typename T, typename Policy>
+stack<T, Policy>::stack_const_iterator::stack_const_iterator(const stack_iterator& o): cur(o.cur) {}
+
+//возвращает константную ссылку
+template <typename T, typename Policy>
+typename stack<T, Policy>::const_iterator_base::reference
+stack<T, Policy>::stack_const_iterator::operator*() const { return cur->data; }
+
+//доступ к полю
+template <typename T, typename Policy>
+typename stack<T, Policy>::const_iterator_base::pointer
+stack<T, Policy>::stack_const_iterator::operator->() const { return &cur->data; }
+
+//шаг вперед
+template <typename T, typename Policy>
+typename stack<T, Policy>::stack_const_iterator&
+stack<T, Policy>::stack_const_iterator::operator++() {
+    if(cur) {
+        cur = cur->next;
+        prefetch_next(cur);
+    }
     return *this;
 }
 
-//   
-template <typename T>
-bool stack<T>::stack_const_iterator::operator==(const const_iterator_base& o) const {
+//сравнение с константным итератором
+template <typename T, typename Policy>
+bool stack<T, Policy>::stack_const_iterator::operator==(const const_iterator_base& o) const {
     auto* p = dynamic_cast<const stack_const_iterator*>(&o);
     return p && cur == p->cur;
 }
 
-template <typename T>
-bool stack<T>::stack_const_iterator::operator!=(const const_iterator_base& o) const {
+template <typename T, typename Policy>
+bool stack<T, Policy>::stack_const_iterator::operator!=(const const_iterator_base& o) const {
     return !(*this == o);
 }
 
-//   
-template <typename T>
-bool stack<T>::stack_const_iterator::operator==(const iterator_base& o) const {
+//сравнение с обычным итератором
+template <typename T, typename Policy>
+bool stack<T, Policy>::stack_const_iterator::operator==(const iterator_base& o) const {
     auto* p = dynamic_cast<const stack_iterator*>(&o);
     return p && cur == p->cur;
 }
 
-template <typename T>
-bool stack<T>::stack_const_iterator::operator!=(const iterator_base& o) const {
+template <typename T, typename Policy>
+bool stack<T, Policy>::stack_const_iterator::operator!=(const iterator_base& o) const {
     return !(*this == o);
 }
 
-// 
-template <typename T>
-typename stack<T>::const_iterator_base*
-stack<T>::stack_const_iterator::clone() const {
+//копия итератора
+template <typename T, typename Policy>
+typename stack<T, Policy>::const_iterator_base*
+stack<T, Policy>::stack_const_iterator::clone() const {
+    stats::on_iter_alloc();
     return new stack_const_iterator(*this);
 }
 
-//    
+//реализация конструкторов и деструктора стека
 
-//  
-template <typename T>
-stack<T>::stack(): top_(nullptr), sz_(0) {}
+//создает пустой стек
+template <typename T, typename Policy>
+stack<T, Policy>::stack(): top_(nullptr), sz_(0) {}
 
-//
-template <typename T>
-stack<T>::~stack() { clear(); }
+//деструктор
+template <typename T, typename Policy>
+stack<T, Policy>::~stack() { clear(); }
 
-// 
-template <typename T>
-stack<T>::stack(const stack& o): top_(nullptr), sz_(0) {
+//копирующий конструктор
+template <typename T, typename Policy>
+stack<T, Policy>::stack(const stack& o): fwd_container<T>(), storage(), top_(nullptr), sz_(0) {
+    stats::on_copy();
     copy_from(o);
 }
 
-// 
-template <typename T>
-stack<T>::stack(stack&& o): top_(o.top_), sz_(o.sz_) {
+//перемещающий конструктор
+template <typename T, typename Policy>
+stack<T, Policy>::stack(stack&& o): storage(std::move(o)), top_(o.top_), sz_(o.sz_) {
     o.top_ = nullptr;
     o.sz_ = 0;
 }
 
-// 
-template <typename T>
-stack<T>& stack<T>::operator=(const stack& o) {
+//копирующее присваивание
+template <typename T, typename Policy>
+stack<T, Policy>& stack<T, Policy>::operator=(const stack& o) {
+    stats::on_assign();
     if(this != &o) {
         clear();
         copy_from(o);
@@ -155,11 +166,12 @@ stack<T>& stack<T>::operator=(const stack& o) {
     return *this;
 }
 
-// 
-template <typename T>
-stack<T>& stack<T>::operator=(stack&& o) {
+//перемещающее присваивание
+template <typename T, typename Policy>
+stack<T, Policy>& stack<T, Policy>::operator=(stack&& o) {
     if(this != &o) {
         clear();
+        storage::operator=(std::move(o));   //узлы o переезжают вместе с его хранилищем
         top_ = o.top_;
         sz_ = o.sz_;
         o.top_ = nullptr;
@@ -168,131 +180,236 @@ stack<T>& stack<T>::operator=(stack&& o) {
     return *this;
 }
 
-//   
-template <typename T>
-fwd_container<T>& stack<T>::operator=(const fwd_container<T>& o) {
+//присваивание через базовый класс
+template <typename T, typename Policy>
+fwd_container<T>& stack<T, Policy>::operator=(const fwd_container<T>& o) {
+    stats::on_assign();
     return fwd_container<T>::operator=(o);
 }
 
-//  
+//реализация методов контейнера
 
-//   
-template <typename T>
-void stack<T>::push(const T& v) {
-    top_ = new Node(v, top_);
+//вставка копированием в вершину
+template <typename T, typename Policy>
+void stack<T, Policy>::push(const T& v) {
+    top_ = this->make_node(v, top_);
     sz_++;
+    stats::on_node_alloc();
+    stats::on_push();
+    stats::on_size(sz_);
 }
 
-//   
-template <typename T>
-void stack<T>::push(T&& v) {
-    top_ = new Node(std::move(v), top_);
+//вставка перемещением в вершину
+template <typename T, typename Policy>
+void stack<T, Policy>::push(T&& v) {
+    top_ = this->make_node(std::move(v), top_);
     sz_++;
+    stats::on_node_alloc();
+    stats::on_push();
+    stats::on_size(sz_);
 }
 
-//  
-template <typename T>
-T stack<T>::pop() {
+//удаление с вершины
+template <typename T, typename Policy>
+T stack<T, Policy>::pop() {
     if(is_empty()) throw std::runtime_error("stack empty");
     Node* tmp = top_;
     T val = std::move(top_->data);
     top_ = top_->next;
-    delete tmp;
+    this->free_node(tmp);
     sz_--;
+    stats::on_node_free();
+    stats::on_pop();
     return val;
 }
 
-//  
-template <typename T>
-T& stack<T>::get_front() {
+//пакетная вставка: цепочка собирается поверх вершины и подключается целиком,
+//при исключении стек не меняется
+template <typename T, typename Policy>
+void stack<T, Policy>::push_many(const T* p, std::size_t n) {
+    Node* h = top_;
+    try {
+        for(std::size_t i = 0; i < n; ++i) h = this->make_node(p[i], h);
+    } catch(...) {
+        while(h != top_) {
+            Node* t = h;
+            h = h->next;
+            this->free_node(t);
+        }
+        throw;
+    }
+    top_ = h;
+    sz_ += n;
+    stats::on_node_alloc(n);
+    stats::on_push(n);
+    stats::on_size(sz_);
+}
+
+//пакетное снятие с вершины
+template <typename T, typename Policy>
+std::size_t stack<T, Policy>::pop_many(T* out, std::size_t n) {
+    std::size_t k = 0;
+    //счётчики - одним вызовом после цикла; если присваивание бросило, элемент остался на месте
+    auto settle = [&] {
+        sz_ -= k;
+        stats::on_node_free(k);
+        stats::on_pop(k);
+    };
+    try {
+        for(; k < n && top_; ++k) {
+            Node* t = top_;
+            out[k] = std::move(t->data);
+            top_ = t->next;
+            prefetch_next(top_);
+            this->free_node(t);
+        }
+    } catch(...) {
+        settle();
+        throw;
+    }
+    settle();
+    return k;
+}
+
+//обход порциями от вершины
+template <typename T, typename Policy>
+void stack<T, Policy>::visit_chunks(typename fwd_container<T>::chunk_fn f, void* ctx) const {
+    visit_list_chunks(top_, f, ctx);
+}
+
+//доступ к вершине
+template <typename T, typename Policy>
+T& stack<T, Policy>::get_front() {
     if(is_empty()) throw std::runtime_error("stack empty");
     return top_->data;
 }
 
-//   
-template <typename T>
-const T& stack<T>::get_front() const {
+//константный доступ к вершине
+template <typename T, typename Policy>
+const T& stack<T, Policy>::get_front() const {
     if(is_empty()) throw std::runtime_error("stack empty");
     return top_->data;
 }
 
-//
-template <typename T>
-bool stack<T>::is_empty() const { return top_ == nullptr; }
-
-//
-template <typename T>
-std::size_t stack<T>::size() const { return sz_; }
+//пустой
+template <typename T, typename Policy>
+bool stack<T, Policy>::is_empty() const { return top_ == nullptr; }
+
+//размер
+template <typename T, typename Policy>
+std::size_t stack<T, Policy>::size() const { return sz_; }
+
+//память: узлы считает хранилище - отдельные блоки кучи или блоки арены
+template <typename T, typename Policy>
+std::size_t stack<T, Policy>::memory_usage() const {
+    std::size_t n = sizeof(*this) + this->node_bytes(sz_);
+    if(!heap_usage<T>::none)
+        for(const Node* p = top_; p; p = p->next) n += heap_usage<T>::bytes(p->data);
+    return n;
+}
 
-// 
+//реализация итераторов
 
-//  
-template <typename T>
-typename stack<T>::iterator stack<T>::begin() {
+//итератор на вершину
+template <typename T, typename Policy>
+typename stack<T, Policy>::iterator stack<T, Policy>::begin() {
+    stats::on_iter_alloc();
     return iterator(new stack_iterator(top_));
 }
 
-//  
-template <typename T>
-typename stack<T>::iterator stack<T>::end() {
+//итератор на конец
+template <typename T, typename Policy>
+typename stack<T, Policy>::iterator stack<T, Policy>::end() {
+    stats::on_iter_alloc();
     return iterator(new stack_iterator(nullptr));
 }
 
-//   
-template <typename T>
-typename stack<T>::const_iterator stack<T>::begin() const {
+//константный итератор на вершину
+template <typename T, typename Policy>
+typename stack<T, Policy>::const_iterator stack<T, Policy>::begin() const {
+    stats::on_iter_alloc();
     return const_iterator(new stack_const_iterator(top_));
 }
 
-//   
-template <typename T>
-typename stack<T>::const_iterator stack<T>::end() const {
+//константный итератор на конец
+template <typename T, typename Policy>
+typename stack<T, Policy>::const_iterator stack<T, Policy>::end() const {
+    stats::on_iter_alloc();
     return const_iterator(new stack_const_iterator(nullptr));
 }
 
 //cbegin
-template <typename T>
-typename stack<T>::const_iterator stack<T>::cbegin() const {
+template <typename T, typename Policy>
+typename stack<T, Policy>::const_iterator stack<T, Policy>::cbegin() const {
+    stats::on_iter_alloc();
     return const_iterator(new stack_const_iterator(top_));
 }
 
 //cend
-template <typename T>
-typename stack<T>::const_iterator stack<T>::cend() const {
+template <typename T, typename Policy>
+typename stack<T, Policy>::const_iterator stack<T, Policy>::cend() const {
+    stats::on_iter_alloc();
     return const_iterator(new stack_const_iterator(nullptr));
 }
 
-// 
+//вид по узлам от вершины
+template <typename T, typename Policy>
+list_view<typename stack<T, Policy>::Node> stack<T, Policy>::view() { return list_view<Node>(top_, sz_); }
+
+template <typename T, typename Policy>
+list_view<const typename stack<T, Policy>::Node> stack<T, Policy>::view() const { return list_view<const Node>(top_, sz_); }
+
+//вспомогательные методы
+
+//предвыборка: стоим на n, процессор уже тянет следующий узел, пока работаем с текущим
+template <typename T, typename Policy>
+void stack<T, Policy>::prefetch_next(const Node* n) {
+    if constexpr(Policy::prefetch) {
+        if(n && n->next) prefetch_read(n->next);
+    }
+}
 
-// 
-template <typename T>
-void stack<T>::clear() {
-    while(top_) {
-        Node* t = top_;
-        top_ = top_->next;
-        delete t;
+//очистка стека
+template <typename T, typename Policy>
+void stack<T, Policy>::clear() {
+    if constexpr(storage::bulk_release) {
+        stats::on_node_free(sz_);
+        this->release_chain(top_, sz_); //хранилище освобождает цепочку само, без обхода здесь
+        top_ = nullptr;
+    } else {
+        while(top_) {
+            Node* t = top_;
+            top_ = top_->next;
+            prefetch_next(top_);
+            this->free_node(t);
+            stats::on_node_free();
+        }
     }
     sz_ = 0;
 }
 
-//    O(n)
-template <typename T>
-void stack<T>::copy_from(const stack& o) {
+//копирование за один проход O(n)
+template <typename T, typename Policy>
+void stack<T, Policy>::copy_from(const stack& o) {
     if(o.top_ == nullptr) return;
 
-    //  
-    top_ = new Node(o.top_->data);
+    //создаем первый узел
+    top_ = this->make_node(o.top_->data);
+    stats::on_node_alloc();
     Node* new_cur = top_;
     Node* old_cur = o.top_->next;
 
-    //  
+    //копируем остальные узлы
     while(old_cur != nullptr) {
-        new_cur->next = new Node(old_cur->data);
+        new_cur->next = this->make_node(old_cur->data);
+        stats::on_node_alloc();
         new_cur = new_cur->next;
         old_cur = old_cur->next;
+        prefetch_next(old_cur);
     }
 
     sz_ = o.sz_;
+    stats::on_size(sz_);
 }
 
 #endif
@@ -0,0 +1,129 @@
+#ifndef STATIC_STACK_H
+#define STATIC_STACK_H
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+//стек фиксированной вместимости N на std::array: без кучи и виртуальных вызовов,
+//все операции constexpr, поэтому годится для вычислений во время компиляции
+//не наследует fwd_container: виртуальные функции и new в constexpr недоступны
+//T должен иметь конструктор по умолчанию; снизу индекс 0, вершина - sz_-1
+template <typename T, std::size_t N>
+class static_stack {
+    static_assert(N > 0, "static_stack: N должно быть больше нуля");
+
+    std::array<T, N> data_;     //элементы, свободные ячейки - T()
+    std::size_t sz_;            //количество элементов
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+    class static_const_iterator;
+
+    // итератор: от вершины вниз, как у stack
+    class static_iterator {
+        T* base;
+        std::size_t left;           //сколько элементов осталось, текущий - base[left-1]
+        friend class static_const_iterator;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        constexpr static_iterator(T* b = nullptr, std::size_t n = 0);
+
+        constexpr T& operator*() const;
+        constexpr T* operator->() const;
+        constexpr static_iterator& operator++();
+        constexpr static_iterator operator++(int);
+
+        //сравнения
+        constexpr bool operator==(const static_iterator& o) const;
+        constexpr bool operator!=(const static_iterator& o) const;
+    };
+
+    // константный итератор
+    class static_const_iterator {
+        const T* base;
+        std::size_t left;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        constexpr static_const_iterator(const T* b = nullptr, std::size_t n = 0);
+        constexpr static_const_iterator(const static_iterator& o);
+
+        constexpr const T& operator*() const;
+        constexpr const T* operator->() const;
+        constexpr static_const_iterator& operator++();
+        constexpr static_const_iterator operator++(int);
+
+        //сравнения
+        constexpr bool operator==(const static_const_iterator& o) const;
+        constexpr bool operator!=(const static_const_iterator& o) const;
+    };
+
+    using iterator = static_iterator;
+    using const_iterator = static_const_iterator;
+
+    // конструкторы: копирование и перемещение поэлементные, по умолчанию
+    constexpr static_stack();
+    constexpr static_stack(std::initializer_list<T> il);   //элементы кладутся по порядку, последний - вершина
+
+    constexpr void push(const T& v);            //std::length_error при переполнении
+    constexpr void push(T&& v);
+    constexpr T pop();                          //std::runtime_error на пустом стеке
+
+    constexpr T& get_front();                   //вершина
+    constexpr const T& get_front() const;
+
+    constexpr bool is_empty() const;
+    constexpr bool empty() const;
+    constexpr bool full() const;
+    constexpr std::size_t size() const;
+    static constexpr std::size_t capacity();
+    constexpr void clear();
+
+    constexpr iterator begin();
+    constexpr iterator end();
+    constexpr const_iterator begin() const;
+    constexpr const_iterator end() const;
+    constexpr const_iterator cbegin() const;
+    constexpr const_iterator cend() const;
+};
+
+//сравнения по порядку обхода (от вершины), размеры могут отличаться
+template <typename T, std::size_t N, std::size_t M>
+constexpr bool operator==(const static_stack<T, N>& a, const static_stack<T, M>& b);
+
+template <typename T, std::size_t N, std::size_t M>
+constexpr bool operator!=(const static_stack<T, N>& a, const static_stack<T, M>& b);
+
+template <typename T, std::size_t N, std::size_t M>
+constexpr bool operator<(const static_stack<T, N>& a, const static_stack<T, M>& b);
+
+template <typename T, std::size_t N, std::size_t M>
+constexpr bool operator>(const static_stack<T, N>& a, const static_stack<T, M>& b);
+
+template <typename T, std::size_t N, std::size_t M>
+constexpr bool operator<=(const static_stack<T, N>& a, const static_stack<T, M>& b);
+
+template <typename T, std::size_t N, std::size_t M>
+constexpr bool operator>=(const static_stack<T, N>& a, const static_stack<T, M>& b);
+
+#include "static_stack_impl.h"
+
+#endif
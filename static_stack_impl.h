@@ -0,0 +1,218 @@
+#ifndef STATIC_STACK_IMPL_H
+#define STATIC_STACK_IMPL_H
+
+//реализация static_iterator
+
+//конструктор: n элементов, начиная с base[n-1]
+template <typename T, std::size_t N>
+constexpr static_stack<T, N>::static_iterator::static_iterator(T* b, std::size_t n): base(b), left(n) {}
+
+//разыменование
+template <typename T, std::size_t N>
+constexpr T& static_stack<T, N>::static_iterator::operator*() const { return base[left - 1]; }
+
+//доступ к полю
+template <typename T, std::size_t N>
+constexpr T* static_stack<T, N>::static_iterator::operator->() const { return &base[left - 1]; }
+
+//шаг к низу стека
+template <typename T, std::size_t N>
+constexpr typename static_stack<T, N>::static_iterator&
+static_stack<T, N>::static_iterator::operator++() {
+    if(left) --left;
+    return *this;
+}
+
+template <typename T, std::size_t N>
+constexpr typename static_stack<T, N>::static_iterator
+static_stack<T, N>::static_iterator::operator++(int) {
+    static_iterator t = *this;
+    ++*this;
+    return t;
+}
+
+//сравнение: все пройденные до конца итераторы равны
+template <typename T, std::size_t N>
+constexpr bool static_stack<T, N>::static_iterator::operator==(const static_iterator& o) const {
+    return left == o.left && (left == 0 || base == o.base);
+}
+
+template <typename T, std::size_t N>
+constexpr bool static_stack<T, N>::static_iterator::operator!=(const static_iterator& o) const {
+    return !(*this == o);
+}
+
+//реализация static_const_iterator
+
+template <typename T, std::size_t N>
+constexpr static_stack<T, N>::static_const_iterator::static_const_iterator(const T* b, std::size_t n)
+    : base(b), left(n) {}
+
+//из обычного итератора
+template <typename T, std::size_t N>
+constexpr static_stack<T, N>::static_const_iterator::static_const_iterator(const static_iterator& o)
+    : base(o.base), left(o.left) {}
+
+template <typename T, std::size_t N>
+constexpr const T& static_stack<T, N>::static_const_iterator::operator*() const { return base[left - 1]; }
+
+template <typename T, std::size_t N>
+constexpr const T* static_stack<T, N>::static_const_iterator::operator->() const { return &base[left - 1]; }
+
+template <typename T, std::size_t N>
+constexpr typename static_stack<T, N>::static_const_iterator&
+static_stack<T, N>::static_const_iterator::operator++() {
+    if(left) --left;
+    return *this;
+}
+
+template <typename T, std::size_t N>
+constexpr typename static_stack<T, N>::static_const_iterator
+static_stack<T, N>::static_const_iterator::operator++(int) {
+    static_const_iterator t = *this;
+    ++*this;
+    return t;
+}
+
+template <typename T, std::size_t N>
+constexpr bool static_stack<T, N>::static_const_iterator::operator==(const static_const_iterator& o) const {
+    return left == o.left && (left == 0 || base == o.base);
+}
+
+template <typename T, std::size_t N>
+constexpr bool static_stack<T, N>::static_const_iterator::operator!=(const static_const_iterator& o) const {
+    return !(*this == o);
+}
+
+//реализация static_stack
+
+//пустой стек, ячейки инициализированы T()
+template <typename T, std::size_t N>
+constexpr static_stack<T, N>::static_stack(): data_{}, sz_(0) {}
+
+//из списка: первый элемент ложится на дно
+template <typename T, std::size_t N>
+constexpr static_stack<T, N>::static_stack(std::initializer_list<T> il): data_{}, sz_(0) {
+    for(const T& v : il) push(v);
+}
+
+//добавление на вершину
+template <typename T, std::size_t N>
+constexpr void static_stack<T, N>::push(const T& v) {
+    if(sz_ == N) throw std::length_error("static_stack full");
+    data_[sz_] = v;
+    ++sz_;
+}
+
+template <typename T, std::size_t N>
+constexpr void static_stack<T, N>::push(T&& v) {
+    if(sz_ == N) throw std::length_error("static_stack full");
+    data_[sz_] = std::move(v);
+    ++sz_;
+}
+
+//снятие вершины; ячейка сбрасывается в T(), чтобы не держать ресурсы снятого элемента
+template <typename T, std::size_t N>
+constexpr T static_stack<T, N>::pop() {
+    if(is_empty()) throw std::runtime_error("static_stack empty");
+    --sz_;
+    T v = std::move(data_[sz_]);
+    if constexpr(!std::is_trivially_destructible<T>::value) data_[sz_] = T();
+    return v;
+}
+
+//вершина
+template <typename T, std::size_t N>
+constexpr T& static_stack<T, N>::get_front() {
+    if(is_empty()) throw std::runtime_error("static_stack empty");
+    return data_[sz_ - 1];
+}
+
+template <typename T, std::size_t N>
+constexpr const T& static_stack<T, N>::get_front() const {
+    if(is_empty()) throw std::runtime_error("static_stack empty");
+    return data_[sz_ - 1];
+}
+
+template <typename T, std::size_t N>
+constexpr bool static_stack<T, N>::is_empty() const { return sz_ == 0; }
+
+template <typename T, std::size_t N>
+constexpr bool static_stack<T, N>::empty() const { return sz_ == 0; }
+
+template <typename T, std::size_t N>
+constexpr bool static_stack<T, N>::full() const { return sz_ == N; }
+
+template <typename T, std::size_t N>
+constexpr std::size_t static_stack<T, N>::size() const { return sz_; }
+
+template <typename T, std::size_t N>
+constexpr std::size_t static_stack<T, N>::capacity() { return N; }
+
+//очистка: ячейки снова T()
+template <typename T, std::size_t N>
+constexpr void static_stack<T, N>::clear() {
+    if constexpr(!std::is_trivially_destructible<T>::value)
+        for(std::size_t i = 0; i < sz_; ++i) data_[i] = T();
+    sz_ = 0;
+}
+
+//итераторы
+template <typename T, std::size_t N>
+constexpr typename static_stack<T, N>::iterator static_stack<T, N>::begin() { return iterator(data_.data(), sz_); }
+
+template <typename T, std::size_t N>
+constexpr typename static_stack<T, N>::iterator static_stack<T, N>::end() { return iterator(data_.data(), 0); }
+
+template <typename T, std::size_t N>
+constexpr typename static_stack<T, N>::const_iterator static_stack<T, N>::begin() const {
+    return const_iterator(data_.data(), sz_);
+}
+
+template <typename T, std::size_t N>
+constexpr typename static_stack<T, N>::const_iterator static_stack<T, N>::end() const {
+    return const_iterator(data_.data(), 0);
+}
+
+template <typename T, std::size_t N>
+constexpr typename static_stack<T, N>::const_iterator static_stack<T, N>::cbegin() const { return begin(); }
+
+template <typename T, std::size_t N>
+constexpr typename static_stack<T, N>::const_iterator static_stack<T, N>::cend() const { return end(); }
+
+//сравнения: std::equal и std::lexicographical_compare в C++17 ещё не constexpr
+
+template <typename T, std::size_t N, std::size_t M>
+constexpr bool operator==(const static_stack<T, N>& a, const static_stack<T, M>& b) {
+    if(a.size() != b.size()) return false;
+    auto i = a.begin();
+    for(auto j = b.begin(); j != b.end(); ++i, ++j)
+        if(!(*i == *j)) return false;
+    return true;
+}
+
+template <typename T, std::size_t N, std::size_t M>
+constexpr bool operator!=(const static_stack<T, N>& a, const static_stack<T, M>& b) { return !(a == b); }
+
+//лексикографически от вершины
+template <typename T, std::size_t N, std::size_t M>
+constexpr bool operator<(const static_stack<T, N>& a, const static_stack<T, M>& b) {
+    auto i = a.begin();
+    auto j = b.begin();
+    for(; i != a.end() && j != b.end(); ++i, ++j) {
+        if(*i < *j) return true;
+        if(*j < *i) return false;
+    }
+    return i == a.end() && j != b.end();
+}
+
+template <typename T, std::size_t N, std::size_t M>
+constexpr bool operator>(const static_stack<T, N>& a, const static_stack<T, M>& b) { return b < a; }
+
+template <typename T, std::size_t N, std::size_t M>
+constexpr bool operator<=(const static_stack<T, N>& a, const static_stack<T, M>& b) { return !(b < a); }
+
+template <typename T, std::size_t N, std::size_t M>
+constexpr bool operator>=(const static_stack<T, N>& a, const static_stack<T, M>& b) { return !(a < b); }
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef HDR_HISTOGRAM_H
+#define HDR_HISTOGRAM_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+//гистограмма в духе HdrHistogram: логарифмические диапазоны, каждый делится на 128 линейных корзин
+//значения до 256 хранятся точно, дальше относительная ошибка меньше 1%
+//не потокобезопасна: у каждого потока своя, в конце они сливаются через merge
+class hdr_histogram {
+    static constexpr int sub_bits = 7;
+    static constexpr std::uint64_t sub_count = std::uint64_t(1) << sub_bits;
+
+    std::vector<std::uint64_t> counts_;
+    std::uint64_t total_;
+    std::uint64_t min_;
+    std::uint64_t max_;
+    long double sum_;
+
+public:
+    hdr_histogram();
+
+    void record(std::uint64_t v);
+    void merge(const hdr_histogram& o);
+    void reset();
+
+    std::uint64_t count() const { return total_; }
+    std::uint64_t min() const { return total_ ? min_ : 0; }
+    std::uint64_t max() const { return max_; }
+    double mean() const;
+    std::uint64_t percentile(double p) const;      //верхняя граница корзины, в которую попал p-й процентиль
+
+private:
+    static std::size_t index_of(std::uint64_t v);
+    static std::uint64_t highest_of(std::size_t idx);
+};
+
+//реализация
+
+inline hdr_histogram::hdr_histogram()
+    : counts_((64 - sub_bits + 1) * sub_count, 0), total_(0), min_(UINT64_MAX), max_(0), sum_(0) {}
+
+//номер корзины: сдвиг отбрасывает младшие биты так, чтобы осталось 8 значащих
+inline std::size_t hdr_histogram::index_of(std::uint64_t v) {
+    int msb = 63;
+    while(msb > 0 && !(v >> msb)) --msb;
+    int shift = msb > sub_bits ? msb - sub_bits : 0;
+    return static_cast<std::size_t>(shift) * sub_count + static_cast<std::size_t>(v >> shift);
+}
+
+//наибольшее значение, попадающее в корзину
+inline std::uint64_t hdr_histogram::highest_of(std::size_t idx) {
+    if(idx < 2 * sub_count) return idx;
+    std::size_t shift = idx / sub_count - 1;
+    std::uint64_t m = idx - shift * sub_count;
+    return ((m + 1) << shift) - 1;
+}
+
+//одно значение
+inline void hdr_histogram::record(std::uint64_t v) {
+    counts_[index_of(v)]++;
+    total_++;
+    if(v < min_) min_ = v;
+    if(v > max_) max_ = v;
+    sum_ += v;
+}
+
+//сложение с другой гистограммой
+inline void hdr_histogram::merge(const hdr_histogram& o) {
+    for(std::size_t i = 0; i < counts_.size(); ++i) counts_[i] += o.counts_[i];
+    total_ += o.total_;
+    if(o.total_ && o.min_ < min_) min_ = o.min_;
+    if(o.max_ > max_) max_ = o.max_;
+    sum_ += o.sum_;
+}
+
+//очистка
+inline void hdr_histogram::reset() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    total_ = 0;
+    min_ = UINT64_MAX;
+    max_ = 0;
+    sum_ = 0;
+}
+
+//среднее
+inline double hdr_histogram::mean() const {
+    return total_ ? static_cast<double>(sum_ / total_) : 0.0;
+}
+
+//процентиль p из [0, 100]
+inline std::uint64_t hdr_histogram::percentile(double p) const {
+    if(total_ == 0) return 0;
+    std::uint64_t need = static_cast<std::uint64_t>(p / 100.0 * static_cast<double>(total_) + 0.5);
+    if(need == 0) need = 1;
+    if(need > total_) need = total_;
+    std::uint64_t seen = 0;
+    for(std::size_t i = 0; i < counts_.size(); ++i) {
+        seen += counts_[i];
+        if(seen >= need) {
+            std::uint64_t h = highest_of(i);
+            return h < max_ ? h : max_;
+        }
+    }
+    return max_;
+}
+
+#endif
@@ -0,0 +1,258 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "hdr_histogram.h"
+#include "../queue.h"
+#include "../persistent_queue.h"
+#include "../wal_queue.h"
+#include "../multi_queue.h"
+
+//нагрузочный прогон очередей: P производителей и C потребителей на одной очереди
+//элемент - строка размером --payload, в первых 8 байтах момент push по steady_clock
+//потребитель пишет задержку push -> pop в свою гистограмму, в конце они сливаются
+//
+//  stress --queue=queue,deque --producers=4 --consumers=4 --items=200000 --payload=64
+//  stress --burst=1000 --pause-us=500       //пачки по 1000 элементов с паузой 500 мкс
+
+using clock_type = std::chrono::steady_clock;
+
+//параметры прогона
+struct stress_options {
+    std::string queues = "all";     //имена через запятую или all
+    int producers = 1;
+    int consumers = 1;
+    std::size_t items = 100000;     //на одного производителя
+    std::size_t payload = 16;       //байт в элементе, не меньше 8
+    std::size_t burst = 0;          //0 - равномерно, иначе элементов в пачке
+    long pause_us = 100;            //пауза между пачками
+    std::string wal_dir;            //каталог журнала для wal, по умолчанию во временном
+};
+
+//очередь под нагрузкой: push всегда успешен, try_pop не ждёт
+class stress_queue {
+public:
+    virtual ~stress_queue() = default;
+    virtual void push(std::string&& v) = 0;
+    virtual bool try_pop(std::string& out) = 0;
+};
+
+//однопоточная очередь за мьютексом: queue<T>, persistent_queue<T>
+template <typename Q>
+class locked_queue : public stress_queue {
+    std::mutex m_;
+    Q q_;
+public:
+    void push(std::string&& v) override {
+        std::lock_guard<std::mutex> lk(m_);
+        q_.push(std::move(v));
+    }
+    bool try_pop(std::string& out) override {
+        std::lock_guard<std::mutex> lk(m_);
+        if(q_.is_empty()) return false;
+        out = q_.pop();
+        return true;
+    }
+};
+
+//базовая линия: std::deque за мьютексом
+class locked_deque : public stress_queue {
+    std::mutex m_;
+    std::deque<std::string> q_;
+public:
+    void push(std::string&& v) override {
+        std::lock_guard<std::mutex> lk(m_);
+        q_.push_back(std::move(v));
+    }
+    bool try_pop(std::string& out) override {
+        std::lock_guard<std::mutex> lk(m_);
+        if(q_.empty()) return false;
+        out = std::move(q_.front());
+        q_.pop_front();
+        return true;
+    }
+};
+
+//очередь с журналом потокобезопасна сама; каталог удаляется после прогона
+class wal_target : public stress_queue {
+    std::filesystem::path dir_;
+    std::unique_ptr<wal_queue<std::string>> q_;
+public:
+    explicit wal_target(const std::filesystem::path& dir): dir_(dir) {
+        std::filesystem::remove_all(dir_);
+        q_.reset(new wal_queue<std::string>(dir_.string()));
+    }
+    ~wal_target() override {
+        q_.reset();
+        std::filesystem::remove_all(dir_);
+    }
+    void push(std::string&& v) override { q_->push(std::move(v)); }
+    bool try_pop(std::string& out) override { return q_->try_pop(out); }
+};
+
+//шардированная очередь потокобезопасна сама, порядок FIFO ослаблен
+class multi_target : public stress_queue {
+    multi_queue<std::string> q_;
+public:
+    explicit multi_target(std::size_t shards): q_(shards) {}
+    void push(std::string&& v) override { q_.push(std::move(v)); }
+    bool try_pop(std::string& out) override { return q_.try_pop(out); }
+};
+
+//все очереди прогона: имя и фабрика
+struct stress_target {
+    const char* name;
+    std::function<std::unique_ptr<stress_queue>(const stress_options&)> make;
+};
+
+static std::vector<stress_target> targets() {
+    return {
+        {"queue", [](const stress_options&) { return std::unique_ptr<stress_queue>(new locked_queue<queue<std::string>>); }},
+        {"pqueue", [](const stress_options&) { return std::unique_ptr<stress_queue>(new locked_queue<persistent_queue<std::string>>); }},
+        {"deque", [](const stress_options&) { return std::unique_ptr<stress_queue>(new locked_deque); }},
+        {"multi", [](const stress_options& o) {
+            return std::unique_ptr<stress_queue>(new multi_target(2 * static_cast<std::size_t>(std::max(o.producers, o.consumers))));
+        }},
+        {"wal", [](const stress_options& o) {
+            std::filesystem::path dir = o.wal_dir.empty()
+                ? std::filesystem::temp_directory_path() / "fwd_stress_wal" : std::filesystem::path(o.wal_dir);
+            return std::unique_ptr<stress_queue>(new wal_target(dir));
+        }},
+    };
+}
+
+//время в наносекундах от начала эпохи steady_clock
+static std::uint64_t now_ns() {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now().time_since_epoch()).count());
+}
+
+//результат одного прогона
+struct stress_result {
+    hdr_histogram latency;
+    double seconds = 0;
+};
+
+//один прогон: производители и потребители стартуют вместе
+static stress_result run(stress_queue& q, const stress_options& o) {
+    const std::uint64_t total = o.items * static_cast<std::uint64_t>(o.producers);
+    std::atomic<std::uint64_t> popped{0};
+    std::atomic<bool> go{false};
+    std::vector<hdr_histogram> hist(static_cast<std::size_t>(o.consumers));
+    std::vector<std::thread> threads;
+
+    for(int p = 0; p < o.producers; ++p) {
+        threads.emplace_back([&] {
+            while(!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            std::string item(o.payload, 'x');
+            for(std::size_t i = 0; i < o.items; ++i) {
+                std::uint64_t t = now_ns();
+                std::memcpy(&item[0], &t, sizeof(t));
+                q.push(std::string(item));
+                if(o.burst && (i + 1) % o.burst == 0)
+                    std::this_thread::sleep_for(std::chrono::microseconds(o.pause_us));
+            }
+        });
+    }
+    for(int c = 0; c < o.consumers; ++c) {
+        threads.emplace_back([&, c] {
+            hdr_histogram& h = hist[static_cast<std::size_t>(c)];
+            std::string item;
+            while(!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            while(popped.load(std::memory_order_relaxed) < total) {
+                if(!q.try_pop(item)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                std::uint64_t t;
+                std::memcpy(&t, item.data(), sizeof(t));
+                h.record(now_ns() - t);
+                popped.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    auto start = clock_type::now();
+    go.store(true, std::memory_order_release);
+    for(auto& t : threads) t.join();
+    stress_result r;
+    r.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+    for(auto& h : hist) r.latency.merge(h);
+    return r;
+}
+
+//--name=value
+static bool parse_arg(const char* arg, const char* name, std::string& value) {
+    std::size_t n = std::strlen(name);
+    if(std::strncmp(arg, name, n) != 0 || arg[n] != '=') return false;
+    value = arg + n + 1;
+    return true;
+}
+
+static void usage() {
+    std::printf("usage: stress [--queue=all|queue,pqueue,deque,multi,wal] [--producers=N] [--consumers=N]\n"
+                "              [--items=N] [--payload=BYTES] [--burst=N] [--pause-us=US] [--wal-dir=PATH]\n");
+}
+
+int main(int argc, char** argv)
+{
+    stress_options o;
+    for(int i = 1; i < argc; ++i) {
+        std::string v;
+        if(parse_arg(argv[i], "--queue", v)) o.queues = v;
+        else if(parse_arg(argv[i], "--producers", v)) o.producers = std::atoi(v.c_str());
+        else if(parse_arg(argv[i], "--consumers", v)) o.consumers = std::atoi(v.c_str());
+        else if(parse_arg(argv[i], "--items", v)) o.items = std::strtoull(v.c_str(), nullptr, 10);
+        else if(parse_arg(argv[i], "--payload", v)) o.payload = std::strtoull(v.c_str(), nullptr, 10);
+        else if(parse_arg(argv[i], "--burst", v)) o.burst = std::strtoull(v.c_str(), nullptr, 10);
+        else if(parse_arg(argv[i], "--pause-us", v)) o.pause_us = std::atol(v.c_str());
+        else if(parse_arg(argv[i], "--wal-dir", v)) o.wal_dir = v;
+        else {
+            usage();
+            return std::strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+    if(o.producers < 1 || o.consumers < 1) {
+        usage();
+        return 1;
+    }
+    if(o.payload < sizeof(std::uint64_t)) o.payload = sizeof(std::uint64_t);
+
+    std::printf("producers=%d consumers=%d items=%zu payload=%zu burst=%zu pause_us=%ld\n",
+                o.producers, o.consumers, o.items, o.payload, o.burst, o.pause_us);
+    std::printf("%-10s %14s %10s %10s %10s %10s %10s\n",
+                "queue", "items/s", "p50 us", "p99 us", "p999 us", "max us", "mean us");
+
+    bool any = false;
+    for(const auto& t : targets()) {
+        std::string list = "," + o.queues + ",";
+        std::string key = ",";
+        key += t.name;
+        key += ',';
+        if(o.queues != "all" && list.find(key) == std::string::npos) continue;
+        any = true;
+        auto q = t.make(o);
+        stress_result r = run(*q, o);
+        const double us = 1000.0;
+        std::printf("%-10s %14.0f %10.2f %10.2f %10.2f %10.2f %10.2f\n", t.name,
+                    static_cast<double>(r.latency.count()) / r.seconds,
+                    r.latency.percentile(50) / us, r.latency.percentile(99) / us,
+                    r.latency.percentile(99.9) / us, r.latency.max() / us, r.latency.mean() / us);
+        std::fflush(stdout);
+    }
+    if(!any) {
+        std::fprintf(stderr, "no queue matches --queue=%s\n", o.queues.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include "queue.h"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+//ручка таймера: номер ячейки и её поколение; после срабатывания или отмены ручка протухает
+struct timer_handle {
+    std::uint32_t id = 0;
+    std::uint32_t gen = 0;     //0 - пустая ручка
+};
+
+//иерархическое колесо таймеров: Levels уровней по 2^Bits корзин, корзина - queue
+//schedule и cancel за O(1), advance на такт - O(1) плюс сработавшие таймеры
+//корзина старшего уровня при наступлении её времени раскладывается по младшим перецеплением
+//узлов (splice_one), без копий; отменённый таймер помечается в таблице поколений и
+//выбрасывается, когда до него дойдёт очередь
+//задержки дальше 2^(Bits*Levels) тактов ждут в последней корзине верхнего уровня и раскладываются заново
+template <typename T, typename Policy = default_policy, unsigned Bits = 8, unsigned Levels = 4>
+class timing_wheel {
+    //на одном уровне далёкий таймер попал бы в корзину нулевого уровня и сработал раньше срока
+    static_assert(Bits >= 1 && Levels >= 2 && Bits * Levels < 64, "timing_wheel: неверные Bits или Levels");
+
+    static constexpr std::size_t slots = std::size_t(1) << Bits;
+    static constexpr std::uint64_t mask = slots - 1;
+
+    struct entry {
+        std::uint64_t deadline;
+        std::uint32_t id;
+        std::uint32_t gen;
+        T value;
+    };
+    using bucket = queue<entry, Policy>;
+
+    std::vector<bucket> wheel_;             //уровень l, корзина s - wheel_[l * slots + s]
+    std::vector<std::uint32_t> gen_;        //текущее поколение каждой ячейки
+    std::vector<std::uint32_t> free_;       //свободные ячейки
+    std::uint64_t now_;                     //текущий такт
+    std::size_t live_;                      //не сработавшие и не отменённые
+
+public:
+    timing_wheel();
+    timing_wheel(const timing_wheel&) = default;
+    timing_wheel& operator=(const timing_wheel&) = default;
+    timing_wheel(timing_wheel&& o);                 //o остаётся пустым колесом со временем 0
+    timing_wheel& operator=(timing_wheel&& o);
+
+    //таймер на now() + delay; delay = 0 срабатывает на следующем такте
+    timer_handle schedule(std::uint64_t delay, const T& v);
+    timer_handle schedule(std::uint64_t delay, T&& v);
+
+    bool cancel(timer_handle h);            //false, если таймер уже сработал или отменён
+    bool active(timer_handle h) const;
+
+    //ticks тактов вперёд, f(T&&) на каждый сработавший в порядке тактов; возвращает число сработавших
+    //из f можно ставить и отменять таймеры
+    template <typename F>
+    std::size_t advance(std::uint64_t ticks, F&& f);
+
+    std::uint64_t now() const;
+    std::size_t size() const;               //активные таймеры
+    bool is_empty() const;
+    bool empty() const;
+    std::size_t pending() const;            //записи в корзинах, включая отменённые и ещё не выброшенные
+
+private:
+    void reset();                           //пустое колесо, время 0
+    std::uint32_t acquire();                //свободная ячейка
+    void release(std::uint32_t id);         //ручки на ячейку протухают
+    void insert(std::uint64_t deadline, std::uint32_t id, std::uint32_t gen, T&& v);
+    bucket& slot_for(std::uint64_t deadline);
+    void cascade(unsigned level);           //корзина уровня level для текущего такта - вниз
+};
+
+#include "timing_wheel_impl.h"
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef TIMING_WHEEL_IMPL_H
+#define TIMING_WHEEL_IMPL_H
+
+//реализация timing_wheel
+
+//пустое колесо, время 0
+template <typename T, typename Policy, unsigned Bits, unsigned Levels>
+timing_wheel<T, Policy, Bits, Levels>::timing_wheel(): wheel_(slots * Levels), now_(0), live_(0) {}
+
+//перемещение: корзины и таблица поколений забираются, у o строится новое пустое колесо
+template <typename T, typename Policy, unsigned Bits, unsigned Levels>
+timing_wheel<T, Policy, Bits, Levels>::timing_wheel(timing_wheel&& o)
+    : wheel_(std::move(o.wheel_)), gen_(std::move(o.gen_)), free_(std::move(o.free_)), now_(o.now_), live_(o.live_) {
+    o.reset();
+}
+
+template <typename T, typename Policy, unsigned Bits, unsigned Levels>
+timing_wheel<T, Policy, Bits, Levels>& timing_wheel<T, Policy, Bits, Levels>::operator=(timing_wheel&& o) {
+    if(this != &o) {
+        wheel_ = std::move(o.wheel_);
+        gen_ = std::move(o.gen_);
+        free_ = std::move(o.free_);
+        now_ = o.now_;
+        live_ = o.live_;
+        o.reset();
+    }
+    return *this;
+}
+
+//постановка копированием
+template <typename T, typename Policy, unsigned Bits, unsigned Levels>
+timer_handle timing_wheel<T, Policy, Bits, Levels>::schedule(std::uint64_t delay, const T& v) {
+    return schedule(delay, T(v));
+}
+
+//постановка перемещением; срок считается от текущего такта, ранее следующего не бывает
+template <typename T, typename Policy, unsigned Bits, unsigned Levels>
+timer_handle timing_wheel<T, Policy, Bits, Levels>::schedule(std::uint64_t delay, T&& v) {
+    std::uint64_t deadline = now_ + (delay ? delay : 1);
+    if(deadline < now_) throw std::length_error("timing_wheel: слишком большая задержка");
+    std::uint32_t id = acquire();
+    try {
+        insert(deadline, id, gen_[id], std::move(v));
+    } catch(...) {
+        release(id);
+        throw;
+    }
+    live_++;
+    return timer_handle{id, gen_[id]};
+}
+
+//отмена - только смена поколения, запись в корзине остаётся до своего такта
+template <typename T, typename Policy, unsigned Bits, unsigned Levels>
+bool timing_wheel<T, Policy, Bits, Levels>::cancel(timer_handle h) {
+    if(!active(h)) return false;
+    release(h.id);
+    live_--;
+    return true;
+}
+
+//ручка жива, пока поколение ячейки не сменилось
+template <typename T, typename Policy, unsigned Bits, unsigned Levels>
+bool timing_wheel<T, Policy, Bits, Levels>::active(timer_handle h) const {
+    return h.gen != 0 && h.id < gen_.size() && gen_[h.id] == h.gen;
+}
+
+//такт: сначала сверху вниз раскладываются корзины уровней, у которых начался новый круг,
+//потом срабатывает корзина нижнего уровня
+template <typename T, typename Policy, unsigned Bits, unsigned Levels>
+template <typename F>
+std::size_t timing_wheel<T, Policy, Bits, Levels>::advance(std::uint64_t ticks, F&& f) {
+    std::size_t fired = 0;
+    for(; ticks > 0; --ticks) {
+        ++now_;
+        unsigned top = 0;
+        while(top + 1 < Levels && (now_ & ((std::uint64_t(1) << (Bits * (top + 1))) - 1)) == 0) ++top;
+        for(unsigned l = top; l > 0; --l) cascade(l);
+
+        bucket& b = wheel_[now_ & mask];
+        while(!b.is_empty()) {
+            entry e = b.pop();
+            if(gen_[e.id] != e.gen) continue;   //отменён
+            release(e.id);
+            live_--;
+            fired++;
+            f(std::move(e.value));
+        }
+    }
+    return fired;
+}
+
+template <typename T, typename Policy, unsigned Bits, unsigned Levels>
+std::uint64_t timing_wheel<T, Policy, Bits, Levels>::now() const { return now_; }
+
+template <typename T, typename Policy, unsigned Bits, unsigned Levels>
+std::size_t timing_wheel<T, Policy, Bits, Levels>::size() const { return live_; }
+
+template <typename T, typename Policy, unsigned Bits, unsigned Levels>
+bool timing_wheel<T, Policy, Bits, Levels>::is_empty() const { return live_ == 0; }
+
+template <typename T, typename Policy, unsigned Bits, unsigned Levels>
+bool timing_wheel<T, Policy, Bits, Levels>::empty() const { return live_ == 0; }
+
+//обход корзин: O(slots * Levels)
+template <typename T, typename Policy, unsigned Bits, unsigned Levels>
+std::size_t timing_wheel<T, Policy, Bits, Levels>::pending() const {
+    std::size_t n = 0;
+    for(const bucket& b : wheel_) n += b.size();
+    return n;
+}
+
+//вспомогательные методы
+
+template <typename T, typename Policy, unsigned Bits, unsigned Levels>
+void timing_wheel<T, Policy, Bits, Levels>::reset() {
+    wheel_ = std::vector<bucket>(slots * Levels);
+    gen_.clear();
+    free_.clear();
+    now_ = 0;
+    live_ = 0;
+}
+
+//ячейка из свободных или новая
+template <typename T, typename Policy, unsigned Bits, unsigned Levels>
+std::uint32_t timing_wheel<T, Policy, Bits, Levels>::acquire() {
+    if(!free_.empty()) {
+        std::uint32_t id = free_.back();
+        free_.pop_back();
+        return id;
+    }
+    if(gen_.size() == UINT32_MAX) throw std::length_error("timing_wheel: слишком много таймеров");
+    gen_.push_back(1);
+    return static_cast<std::uint32_t>(gen_.size() - 1);
+}
+
+//новое поколение ячейки, 0 пропускается
+template <typename T, typename Policy, unsigned Bits, unsigned Levels>
+void timing_wheel<T, Policy, Bits, Levels>::release(std::uint32_t id) {
+    if(++gen_[id] == 0) gen_[id] = 1;
+    free_.push_back(id);
+}
+
+//новая запись в свою корзину
+template <typename T, typename Policy, unsigned Bits, unsigned Levels>
+void timing_wheel<T, Policy, Bits, Levels>::insert(std::uint64_t deadline, std::uint32_t id, std::uint32_t gen, T&& v) {
+    slot_for(deadline).push(entry{deadline, id, gen, std::move(v)});
+}
+
+//уровень - по расстоянию до срока, корзина - по разрядам самого срока
+//на уровне l корзина с индексом срока разбирается не раньше начала его круга и не позже срока
+template <typename T, typename Policy, unsigned Bits, unsigned Levels>
+typename timing_wheel<T, Policy, Bits, Levels>::bucket&
+timing_wheel<T, Policy, Bits, Levels>::slot_for(std::uint64_t deadline) {
+    std::uint64_t delta = deadline - now_;
+    for(unsigned l = 0; l < Levels; ++l)
+        if(delta < (std::uint64_t(1) << (Bits * (l + 1))))
+            return wheel_[l * slots + ((deadline >> (Bits * l)) & mask)];
+    //дальше всех уровней: последняя корзина верхнего уровня, разберётся через полный круг
+    const unsigned l = Levels - 1;
+    return wheel_[l * slots + (((now_ >> (Bits * l)) - 1) & mask)];
+}
+
+//записи корзины перецепляются в корзины ниже, отменённые освобождаются
+template <typename T, typename Policy, unsigned Bits, unsigned Levels>
+void timing_wheel<T, Policy, Bits, Levels>::cascade(unsigned level) {
+    bucket& b = wheel_[level * slots + ((now_ >> (Bits * level)) & mask)];
+    while(!b.is_empty()) {
+        const entry& e = b.get_front();
+        if(gen_[e.id] != e.gen) b.pop();
+        else slot_for(e.deadline).splice_one(b);
+    }
+}
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef WAL_QUEUE_H
+#define WAL_QUEUE_H
+
+#include "queue.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+//настройки журнала
+struct wal_options {
+    std::chrono::microseconds group_commit_window{0};   //сколько лидер ждёт попутчиков перед fsync
+    std::size_t segment_bytes = 64u << 20;              //размер сегмента, после которого начинаем новый
+    std::size_t checkpoint_segments = 8;                //после стольких сегментов делаем чекпоинт
+};
+
+//сериализация элемента в журнал (по умолчанию - побайтовая копия)
+template <typename T>
+struct wal_codec {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "wal_codec<T> нужно специализировать для нетривиальных типов");
+
+    static void encode(const T& v, std::string& out) {
+        out.append(reinterpret_cast<const char*>(&v), sizeof(T));
+    }
+    static bool decode(const char* p, std::size_t n, T& v) {
+        if (n != sizeof(T)) return false;
+        std::memcpy(&v, p, sizeof(T));
+        return true;
+    }
+};
+
+//строки пишем как есть, длину хранит сама запись
+template <>
+struct wal_codec<std::string> {
+    static void encode(const std::string& v, std::string& out) { out.append(v); }
+    static bool decode(const char* p, std::size_t n, std::string& v) {
+        v.assign(p, n);
+        return true;
+    }
+};
+
+//очередь с журналом упреждающей записи: переживает падение процесса
+//push и pop пишутся в сегментированный лог, fsync одного лидера покрывает всех ждущих
+template <typename T>
+class wal_queue {
+public:
+    explicit wal_queue(const std::string& dir, const wal_options& opt = wal_options());   //открыть и проиграть журнал
+    ~wal_queue();                                   //закрыть текущий сегмент
+    wal_queue(const wal_queue&) = delete;
+    wal_queue& operator=(const wal_queue&) = delete;
+
+    //после ошибки записи на диск все операции бросают std::runtime_error: содержимое в памяти
+    //могло разойтись с журналом, верным остаётся то, что восстановится при открытии
+    void push(const T& v);                          //вернётся, когда запись на диске
+    void push(T&& v);
+    T pop();                                        //извлечь из начала, тоже durable
+    bool try_pop(T& out);                           //false если пусто
+    T front() const;                                //копия первого элемента
+
+    bool is_empty() const;
+    std::size_t size() const;
+
+    void checkpoint();                              //снимок содержимого + удаление старых сегментов
+    std::size_t segment_count() const;              //сколько сегментов лежит на диске
+
+private:
+    //типы записей журнала
+    enum record_type : unsigned char { rec_push = 1, rec_pop = 2, rec_ckpt_begin = 3, rec_ckpt_end = 4 };
+
+    queue<T> q_;                    //содержимое в памяти
+    std::string dir_;               //каталог журнала
+    wal_options opt_;
+    int fd_;                        //текущий сегмент
+    std::uint64_t seg_no_;          //номер текущего сегмента
+    std::uint64_t first_seg_;       //номер самого старого живого сегмента
+    std::size_t seg_bytes_;         //сколько уже записано в текущий сегмент
+    std::string buf_;               //записи, ещё не ушедшие на диск
+    std::uint64_t next_lsn_;        //номер последней добавленной записи
+    std::uint64_t durable_lsn_;     //номер последней записи, прошедшей fsync
+    bool flushing_;                 //есть лидер, который пишет на диск
+    bool failed_;                   //запись на диск упала, журнал больше не пишется
+    mutable std::mutex m_;
+    std::condition_variable cv_;
+
+    static void append_record(std::string& out, record_type t, const std::string& payload);
+    std::string segment_path(std::uint64_t n) const;
+    void open_segment(std::uint64_t n);
+    void replay();
+    void replay_segment(std::uint64_t n, bool from_checkpoint, bool last);
+    void check_alive() const;               //std::runtime_error после ошибки записи
+    void log(record_type t, const std::string& payload);
+    void commit(std::unique_lock<std::mutex>& lk, std::uint64_t lsn);
+    void flush_locked(std::unique_lock<std::mutex>& lk);
+    void checkpoint_locked();
+    void sync_dir() const;
+};
+
+#include "wal_queue_impl.h"
+
+#endif
@@ -0,0 +1,432 @@
+#ifndef WAL_QUEUE_IMPL_H
+#define WAL_QUEUE_IMPL_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+//низкоуровневые вызовы, которые отличаются между платформами
+namespace wal_detail {
+
+#ifdef _WIN32
+inline int open_append(const char* path) { return ::_open(path, _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE); }
+inline int sync_fd(int fd) { return ::_commit(fd); }
+inline int close_fd(int fd) { return ::_close(fd); }
+inline long write_fd(int fd, const char* p, std::size_t n) { return ::_write(fd, p, static_cast<unsigned>(n)); }
+inline void sync_path(const std::string&) {}    //каталоги на Windows не синхронизируются
+#else
+inline int open_append(const char* path) { return ::open(path, O_WRONLY | O_CREAT | O_APPEND, 0644); }
+inline int sync_fd(int fd) { return ::fsync(fd); }
+inline int close_fd(int fd) { return ::close(fd); }
+inline long write_fd(int fd, const char* p, std::size_t n) { return static_cast<long>(::write(fd, p, n)); }
+
+//fsync каталога, чтобы создание и удаление сегментов тоже пережило падение
+inline void sync_path(const std::string& dir) {
+    int fd = ::open(dir.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    ::fsync(fd);
+    ::close(fd);
+}
+#endif
+
+//ошибка ввода-вывода с текстом errno
+inline std::runtime_error io_error(const std::string& what) {
+    return std::runtime_error("wal_queue: " + what + ": " + std::strerror(errno));
+}
+
+//запись всего буфера с повтором после частичной записи
+inline void write_all(int fd, const std::string& data) {
+    const char* p = data.data();
+    std::size_t left = data.size();
+    while (left > 0) {
+        long n = write_fd(fd, p, left);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw io_error("write");
+        }
+        p += n;
+        left -= static_cast<std::size_t>(n);
+    }
+}
+
+//FNV-1a, ловит оборванные и мусорные записи в хвосте
+inline std::uint32_t checksum(const char* p, std::size_t n) {
+    std::uint32_t h = 2166136261u;
+    for (std::size_t i = 0; i < n; ++i) {
+        h ^= static_cast<unsigned char>(p[i]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+inline void put_u32(std::string& out, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+inline std::uint32_t get_u32(const char* p) {
+    std::uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= static_cast<std::uint32_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+    return v;
+}
+
+//одна разобранная запись
+struct record {
+    unsigned char type;
+    const char* payload;
+    std::size_t size;
+};
+
+//разбор сегмента: [u32 длина][u8 тип][данные][u32 контрольная сумма]
+//возвращает длину корректного префикса, всё после него - оборванный хвост
+inline std::size_t parse(const std::string& data, std::vector<record>& out) {
+    std::size_t pos = 0;
+    while (data.size() - pos >= 9) {
+        std::uint32_t len = get_u32(data.data() + pos);
+        if (data.size() - pos - 9 < len) break;
+        const char* body = data.data() + pos + 4;
+        if (get_u32(body + 1 + len) != checksum(body, len + 1)) break;
+        out.push_back(record{static_cast<unsigned char>(body[0]), body + 1, len});
+        pos += 9 + len;
+    }
+    return pos;
+}
+
+//чтение файла целиком
+inline std::string read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("wal_queue: не открыть " + path);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+}
+
+//реализация открытия и восстановления
+
+//открываем каталог, проигрываем журнал и начинаем новый сегмент
+template <typename T>
+wal_queue<T>::wal_queue(const std::string& dir, const wal_options& opt)
+    : dir_(dir), opt_(opt), fd_(-1), seg_no_(0), first_seg_(0), seg_bytes_(0),
+      next_lsn_(0), durable_lsn_(0), flushing_(false), failed_(false) {
+    std::filesystem::create_directories(dir_);
+    replay();
+    open_segment(seg_no_);
+    if (seg_no_ - first_seg_ + 1 > opt_.checkpoint_segments) checkpoint();   //частые переоткрытия тоже копят сегменты
+}
+
+//все push/pop уже дождались fsync, осталось закрыть файл
+template <typename T>
+wal_queue<T>::~wal_queue() {
+    if (fd_ >= 0) wal_detail::close_fd(fd_);
+}
+
+//имя сегмента: номер с ведущими нулями, чтобы сортировка по имени совпадала с порядком
+template <typename T>
+std::string wal_queue<T>::segment_path(std::uint64_t n) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "wal-%016llu.log", static_cast<unsigned long long>(n));
+    return (std::filesystem::path(dir_) / name).string();
+}
+
+//закрыть текущий сегмент и открыть сегмент n
+template <typename T>
+void wal_queue<T>::open_segment(std::uint64_t n) {
+    if (fd_ >= 0) wal_detail::close_fd(fd_);
+    fd_ = wal_detail::open_append(segment_path(n).c_str());
+    if (fd_ < 0) throw wal_detail::io_error("open " + segment_path(n));
+    seg_no_ = n;
+    seg_bytes_ = 0;
+    sync_dir();
+}
+
+//поиск последнего завершённого чекпоинта и проигрывание журнала с него
+template <typename T>
+void wal_queue<T>::replay() {
+    std::vector<std::uint64_t> segs;
+    for (const auto& e : std::filesystem::directory_iterator(dir_)) {
+        unsigned long long n;
+        char tail;
+        if (std::sscanf(e.path().filename().string().c_str(), "wal-%llu.lo%c", &n, &tail) == 2 && tail == 'g')
+            segs.push_back(n);
+    }
+    std::sort(segs.begin(), segs.end());
+
+    //чекпоинт без конца может быть только последним сегментом - его просто выбрасываем
+    std::size_t start = 0;
+    for (std::size_t i = segs.size(); i-- > 0;) {
+        std::vector<wal_detail::record> recs;
+        wal_detail::parse(wal_detail::read_file(segment_path(segs[i])), recs);
+        if (recs.empty() || recs.front().type != rec_ckpt_begin) continue;
+        bool done = std::any_of(recs.begin(), recs.end(),
+                                [](const wal_detail::record& r){ return r.type == rec_ckpt_end; });
+        if (done) { start = i; break; }
+        if (i + 1 != segs.size()) throw std::runtime_error("wal_queue: незавершённый чекпоинт в середине журнала");
+        std::filesystem::remove(segment_path(segs[i]));
+        segs.pop_back();
+    }
+
+    //всё, что старше чекпоинта, больше не нужно
+    for (std::size_t i = 0; i < start; ++i) std::filesystem::remove(segment_path(segs[i]));
+
+    for (std::size_t i = start; i < segs.size(); ++i)
+        replay_segment(segs[i], i == start, i + 1 == segs.size());
+
+    first_seg_ = segs.empty() ? 1 : segs[start];
+    seg_no_ = segs.empty() ? 1 : segs.back() + 1;
+}
+
+//проигрывание одного сегмента; оборванный хвост последнего сегмента обрезаем
+template <typename T>
+void wal_queue<T>::replay_segment(std::uint64_t n, bool from_checkpoint, bool last) {
+    std::string path = segment_path(n);
+    std::string data = wal_detail::read_file(path);
+    std::vector<wal_detail::record> recs;
+    std::size_t good = wal_detail::parse(data, recs);
+
+    if (good != data.size()) {
+        if (!last) throw std::runtime_error("wal_queue: повреждён сегмент " + path);
+        std::filesystem::resize_file(path, good);
+    }
+
+    for (const auto& r : recs) {
+        switch (r.type) {
+        case rec_push: {
+            T v;
+            if (!wal_codec<T>::decode(r.payload, r.size, v))
+                throw std::runtime_error("wal_queue: не разобрать запись в " + path);
+            q_.push(std::move(v));
+            break;
+        }
+        case rec_pop:
+            if (q_.is_empty()) throw std::runtime_error("wal_queue: pop из пустой очереди в " + path);
+            q_.pop();
+            break;
+        case rec_ckpt_begin:
+            if (!from_checkpoint) throw std::runtime_error("wal_queue: лишний чекпоинт в " + path);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+//реализация записи
+
+//запись в формате [u32 длина][u8 тип][данные][u32 сумма]
+template <typename T>
+void wal_queue<T>::append_record(std::string& out, record_type t, const std::string& payload) {
+    wal_detail::put_u32(out, static_cast<std::uint32_t>(payload.size()));
+    std::size_t body = out.size();
+    out.push_back(static_cast<char>(t));
+    out.append(payload);
+    wal_detail::put_u32(out, wal_detail::checksum(out.data() + body, payload.size() + 1));
+}
+
+//журнал ещё пишется, вызывается под m_
+template <typename T>
+void wal_queue<T>::check_alive() const {
+    if (failed_) throw std::runtime_error("wal_queue: журнал недоступен после ошибки записи");
+}
+
+//добавить запись в буфер, вызывается под m_
+template <typename T>
+void wal_queue<T>::log(record_type t, const std::string& payload) {
+    check_alive();
+    append_record(buf_, t, payload);
+    ++next_lsn_;
+}
+
+//ждём, пока запись lsn окажется на диске; кто первый пришёл - тот и пишет за всех
+template <typename T>
+void wal_queue<T>::commit(std::unique_lock<std::mutex>& lk, std::uint64_t lsn) {
+    while (durable_lsn_ < lsn) {
+        check_alive();
+        if (!flushing_) flush_locked(lk);
+        else cv_.wait(lk);
+    }
+}
+
+//работа лидера группы: подождать попутчиков, записать пачку, один fsync
+template <typename T>
+void wal_queue<T>::flush_locked(std::unique_lock<std::mutex>& lk) {
+    flushing_ = true;
+    try {
+        if (opt_.group_commit_window.count() > 0) {
+            lk.unlock();
+            std::this_thread::sleep_for(opt_.group_commit_window);
+            lk.lock();
+        }
+        std::string batch;
+        batch.swap(buf_);
+        std::uint64_t upto = next_lsn_;
+
+        //пишем без блокировки - остальные потоки тем временем копят следующую пачку
+        lk.unlock();
+        try {
+            wal_detail::write_all(fd_, batch);
+            if (wal_detail::sync_fd(fd_) != 0) throw wal_detail::io_error("fsync");
+        } catch (...) {
+            lk.lock();
+            throw;
+        }
+        lk.lock();
+
+        seg_bytes_ += batch.size();
+        durable_lsn_ = upto;
+        if (seg_bytes_ >= opt_.segment_bytes) {
+            open_segment(seg_no_ + 1);
+            if (seg_no_ - first_seg_ + 1 > opt_.checkpoint_segments) checkpoint_locked();
+        }
+    } catch (...) {
+        failed_ = true;
+        flushing_ = false;
+        cv_.notify_all();
+        throw;
+    }
+    flushing_ = false;
+    cv_.notify_all();
+}
+
+//снимок очереди в новый сегмент и удаление всех предыдущих
+//вызывается под m_ при flushing_ == true, поэтому на диск никто больше не пишет
+template <typename T>
+void wal_queue<T>::checkpoint_locked() {
+    std::string snap;
+    std::string payload;
+    append_record(snap, rec_ckpt_begin, payload);
+    for (auto it = q_.cbegin(); it != q_.cend(); ++it) {
+        payload.clear();
+        wal_codec<T>::encode(*it, payload);
+        append_record(snap, rec_push, payload);
+    }
+    append_record(snap, rec_ckpt_end, std::string());
+
+    //снимок уже учитывает всё, что лежит в buf_
+    open_segment(seg_no_ + 1);
+    wal_detail::write_all(fd_, snap);
+    if (wal_detail::sync_fd(fd_) != 0) throw wal_detail::io_error("fsync");
+    seg_bytes_ = snap.size();
+    buf_.clear();
+    durable_lsn_ = next_lsn_;
+
+    for (std::uint64_t n = first_seg_; n < seg_no_; ++n) std::filesystem::remove(segment_path(n));
+    first_seg_ = seg_no_;
+    sync_dir();
+}
+
+//fsync каталога журнала
+template <typename T>
+void wal_queue<T>::sync_dir() const {
+    wal_detail::sync_path(dir_);
+}
+
+//реализация операций очереди
+
+//добавление копированием
+template <typename T>
+void wal_queue<T>::push(const T& v) {
+    std::string payload;
+    wal_codec<T>::encode(v, payload);
+    std::unique_lock<std::mutex> lk(m_);
+    log(rec_push, payload);
+    q_.push(v);
+    commit(lk, next_lsn_);
+}
+
+//добавление перемещением
+template <typename T>
+void wal_queue<T>::push(T&& v) {
+    std::string payload;
+    wal_codec<T>::encode(v, payload);
+    std::unique_lock<std::mutex> lk(m_);
+    log(rec_push, payload);
+    q_.push(std::move(v));
+    commit(lk, next_lsn_);
+}
+
+//извлечение из начала
+template <typename T>
+T wal_queue<T>::pop() {
+    std::unique_lock<std::mutex> lk(m_);
+    check_alive();
+    if (q_.is_empty()) throw std::runtime_error("wal_queue empty");
+    log(rec_pop, std::string());
+    T v = q_.pop();
+    commit(lk, next_lsn_);
+    return v;
+}
+
+//извлечение без исключения на пустой очереди
+template <typename T>
+bool wal_queue<T>::try_pop(T& out) {
+    std::unique_lock<std::mutex> lk(m_);
+    check_alive();
+    if (q_.is_empty()) return false;
+    log(rec_pop, std::string());
+    out = q_.pop();
+    commit(lk, next_lsn_);
+    return true;
+}
+
+//копия первого элемента
+template <typename T>
+T wal_queue<T>::front() const {
+    std::lock_guard<std::mutex> lk(m_);
+    check_alive();
+    return q_.get_front();
+}
+
+//пустота
+template <typename T>
+bool wal_queue<T>::is_empty() const {
+    std::lock_guard<std::mutex> lk(m_);
+    check_alive();
+    return q_.is_empty();
+}
+
+//размер
+template <typename T>
+std::size_t wal_queue<T>::size() const {
+    std::lock_guard<std::mutex> lk(m_);
+    check_alive();
+    return q_.size();
+}
+
+//ручной чекпоинт: дожидаемся текущего лидера и занимаем его место
+template <typename T>
+void wal_queue<T>::checkpoint() {
+    std::unique_lock<std::mutex> lk(m_);
+    while (flushing_) cv_.wait(lk);
+    check_alive();
+    flushing_ = true;
+    try {
+        checkpoint_locked();
+    } catch (...) {
+        failed_ = true;
+        flushing_ = false;
+        cv_.notify_all();
+        throw;
+    }
+    flushing_ = false;
+    cv_.notify_all();
+}
+
+//количество сегментов на диске
+template <typename T>
+std::size_t wal_queue<T>::segment_count() const {
+    std::lock_guard<std::mutex> lk(m_);
+    return static_cast<std::size_t>(seg_no_ - first_seg_ + 1);
+}
+
+#endif